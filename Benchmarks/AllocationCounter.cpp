@@ -0,0 +1,46 @@
+//
+//  AllocationCounter.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+namespace {
+    
+    
+std::atomic<std::size_t> allocationCount(0);
+    
+    
+}
+
+
+// The array and nothrow forms call this one
+void * operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size > 0 ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+
+std::size_t getAllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,22 @@
+//
+//  AllocationCounter.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef AllocationCounter_hpp
+#define AllocationCounter_hpp
+
+#include <cstddef>
+
+
+//
+// AllocationCounter.cpp replaces the global operator new with one that counts its calls.  Since the
+// replacement applies to the whole executable, it's linked only into the benchmarks that report
+// allocations.
+//
+std::size_t getAllocationCount();
+
+
+#endif /* AllocationCounter_hpp */
@@ -0,0 +1,74 @@
+//
+//  BenchmarkUtilities.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef BenchmarkUtilities_hpp
+#define BenchmarkUtilities_hpp
+
+#include <random>
+
+#include "OpenEphysClockModel.hpp"
+#include "OpenEphysEventPipeline.hpp"
+#include "OpenEphysSpikeRecord.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+// Open Ephys clock 2.5 s ahead of the MWorks clock and 20 ppm fast, fitted from one sync per 100 ms
+inline OpenEphysClockModel makeFittedClockModel(std::size_t numMatches = 64) {
+    OpenEphysClockModel model;
+    for (std::size_t i = 0; i < numMatches; i++) {
+        const MWTime mwTime = 1000000 + MWTime(i) * 100000;
+        model.addSyncMatch(MWTime(double(mwTime) * (1.0 + 20e-6)) + 2500000, mwTime);
+    }
+    return model;
+}
+
+
+// Spikes from 32 electrodes x 4 units at a combined rate of about 10 kHz
+inline std::vector<OpenEphysSpikeRecord> makeSpikes(std::size_t count, std::uint64_t seed = 1) {
+    std::mt19937_64 engine(seed);
+    std::exponential_distribution<double> interval(1.0 / 100.0);
+    std::uniform_int_distribution<int> electrode(0, 31), unit(1, 4);
+    
+    std::vector<OpenEphysSpikeRecord> spikes;
+    double time = 1e6;
+    for (std::size_t i = 0; i < count; i++) {
+        time += interval(engine);
+        const auto electrodeID = std::uint16_t(electrode(engine));
+        spikes.push_back({ MWTime(time), std::int64_t(time * 0.03), electrodeID, std::uint16_t(unit(engine)), electrodeID, 0 });
+    }
+    return spikes;
+}
+
+
+// Event pipeline delegate that publishes nothing, so that only the pipeline's own work is measured
+class NullDelegate : public OpenEphysEventPipeline::Delegate {
+public:
+    MWTime getCurrentTime() override { return currentTime; }
+    void publishClockOffset(MWTime, MWTime) override { }
+    void publishClockQuality(const OpenEphysClockModel &, MWTime) override { }
+    void publishSpike(const OpenEphysSpikeRecord &) override { numSpikes++; }
+    void publishSpikeBatch(const std::string &, MWTime) override { numBatches++; }
+    void publishOverloadMode(OpenEphysOverloadController::Mode, MWTime) override { }
+    void publishSpikeSummary(MWTime, MWTime, const std::vector<OpenEphysOverloadController::UnitCount> &) override { }
+    void publishUnitQuality(MWTime,
+                            MWTime,
+                            const std::vector<OpenEphysUnitQuality::UnitStats> &,
+                            const std::vector<MWTime> &) override
+    { }
+    
+    MWTime currentTime = 1000000;
+    std::size_t numSpikes = 0;
+    std::size_t numBatches = 0;
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* BenchmarkUtilities_hpp */
@@ -0,0 +1,407 @@
+//
+//  ClockAccuracySimulation.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+//
+// Measures how accurately spike times are converted to the MWorks clock.  The simulation runs two
+// clocks with a known offset and drift, sends sync words on a schedule, delivers them to Open Ephys
+// after a random latency (occasionally dropping or repeating an edge, or reporting the channels of a
+// multi-bit change one at a time), and feeds the resulting TTL events, the sync loopback, and spikes
+// at known MWorks times to an OpenEphysEventPipeline, just as OpenEphysInterface does.  The errors of
+// the spike times that the pipeline publishes are reported.
+//
+// Estimators:
+//   single_sample  Offset from the most recent sync match alone (the plugin's original method), fed
+//                  by the matches the pipeline accepts, with the configured latency
+//   regression     The pipeline's own conversion (OpenEphysClockModel, a least-squares fit of offset
+//                  and drift over recent matches, with the latency estimated from the loopback)
+//
+// Usage: openephys_clock_accuracy [--duration S] [--drift PPM] [--latency US] [--jitter US]
+//                                 [--drop P] [--repeat P] [--split P] [--loopback 0|1] [--seed N]
+//                                 [--json PATH]
+//
+
+#include <cstdio>
+#include <random>
+
+#include "OpenEphysEventPipeline.hpp"
+
+
+using namespace mw;
+
+
+namespace {
+
+
+struct Options {
+    double duration = 600.0;  // Seconds of simulated time per sync rate
+    double drift = 20.0;      // ppm
+    double latency = 1000.0;  // Mean sync latency (us)
+    double jitter = 200.0;    // Standard deviation of sync latency (us)
+    double drop = 0.01;       // Probability that a sync edge is missed
+    double repeat = 0.01;     // Probability that a sync edge is reported twice
+    double split = 0.5;       // Probability that a sync word's channel edges are reported separately
+    bool loopback = true;     // Whether sync words are looped back, to estimate their latency
+    std::uint64_t seed = 1;
+    std::string jsonPath;
+};
+
+
+constexpr double oeClockOffset = 12.5e6;  // us
+constexpr double sampleRate = 30000.0;
+constexpr double spikeRate = 200.0;  // Hz
+const std::vector<std::uint8_t> syncChannels = { 0, 1, 2, 3 };
+constexpr MWTime channelSkew = 20;  // us between the separately reported edges of a split word
+constexpr MWTime spikeDelay = 1000;  // us from a spike to its receipt
+constexpr MWTime updateInterval = 10000;  // us between pipeline updates
+const std::vector<double> syncRates = { 0.1, 1.0, 10.0, 100.0 };  // Hz
+
+
+class Simulation : private OpenEphysEventPipeline::Delegate {
+    
+public:
+    Simulation(const Options &options, double syncRate) :
+        options(options),
+        syncInterval(MWTime(1e6 / syncRate)),
+        engine(options.seed),
+        syncWordDecoder(syncChannels),
+        pipeline(*this, syncChannels, boost::make_shared<OpenEphysClockService>(sampleRate)),
+        currentTime(0),
+        currentEvent(nullptr),
+        singleSampleValid(false),
+        singleSampleOffset(0.0),
+        singleSampleErrors(nullptr),
+        regressionErrors(nullptr)
+    {
+        pipeline.setSyncInterval(syncInterval);
+        pipeline.setSyncLatency(MWTime(options.latency));
+        pipeline.enableSpikes(0);
+    }
+    
+    void run(std::vector<double> &singleSampleErrors, std::vector<double> &regressionErrors);
+    
+private:
+    enum class EventType { Sync, Loopback, Spike };
+    
+    struct Event {
+        MWTime time;      // MWorks time at which the event reaches the interface
+        EventType type;
+        int syncWord;     // Word sent (or, for a sync event, the word being changed to)
+        MWTime sendTime;  // MWorks time at which the word was sent
+        std::uint64_t ttlWord;
+        MWTime trueTime;  // True MWorks time of the TTL edge or spike
+        bool operator<(const Event &other) const { return time < other.time; }
+    };
+    
+    // True Open Ephys time (in seconds, quantized to samples) of an MWorks time
+    double getOpenEphysTimestamp(MWTime mwTime) const {
+        const double oeTime = oeClockOffset + double(mwTime) * (1.0 + options.drift / 1e6);
+        return std::floor(oeTime / 1e6 * sampleRate) / sampleRate;
+    }
+    
+    // OpenEphysEventPipeline::Delegate
+    MWTime getCurrentTime() override { return currentTime; }
+    void publishClockOffset(MWTime offset, MWTime time) override;
+    void publishClockQuality(const OpenEphysClockModel &, MWTime) override { }
+    void publishSpike(const OpenEphysSpikeRecord &spike) override;
+    void publishSpikeBatch(const std::string &, MWTime) override { }
+    void publishOverloadMode(OpenEphysOverloadController::Mode, MWTime) override { }
+    void publishSpikeSummary(MWTime, MWTime, const std::vector<OpenEphysOverloadController::UnitCount> &) override { }
+    void publishUnitQuality(MWTime,
+                            MWTime,
+                            const std::vector<OpenEphysUnitQuality::UnitStats> &,
+                            const std::vector<MWTime> &) override
+    { }
+    
+    const Options &options;
+    const MWTime syncInterval;
+    std::mt19937_64 engine;
+    
+    const OpenEphysSyncWordDecoder syncWordDecoder;
+    OpenEphysEventPipeline pipeline;
+    MWTime currentTime;
+    const Event *currentEvent;
+    
+    bool singleSampleValid;
+    double singleSampleOffset;
+    std::vector<double> *singleSampleErrors;
+    std::vector<double> *regressionErrors;
+    
+};
+
+
+void Simulation::run(std::vector<double> &singleSampleErrors, std::vector<double> &regressionErrors) {
+    this->singleSampleErrors = &singleSampleErrors;
+    this->regressionErrors = &regressionErrors;
+    
+    const MWTime endTime = MWTime(options.duration * 1e6);
+    
+    // Latency is normally distributed around the mean, but never negative
+    std::normal_distribution<double> latency(options.latency, options.jitter);
+    std::bernoulli_distribution drop(options.drop), repeat(options.repeat), split(options.split);
+    std::uniform_int_distribution<MWTime> bounceDelay(100, 2000);
+    std::exponential_distribution<double> spikeInterval(spikeRate / 1e6);
+    
+    // Sync words are sent on schedule and recorded with their send times, just as the interface's
+    // sync notification records them
+    std::vector<Event> events;
+    std::vector<std::pair<MWTime, int>> sentWords;
+    int lineState = 0;
+    for (MWTime sendTime = syncInterval; sendTime < endTime; sendTime += syncInterval) {
+        const int word = pipeline.nextSyncWord();
+        sentWords.emplace_back(sendTime, word);
+        const MWTime edgeTime = sendTime + MWTime(std::max(0.0, latency(engine)));
+        if (options.loopback) {
+            // The loopback input sees the edge even when Open Ephys misses it
+            events.push_back({ edgeTime, EventType::Loopback, word, sendTime, 0, edgeTime });
+        }
+        if (drop(engine)) {
+            continue;
+        }
+        if (split(engine)) {
+            // Report the changed channels one at a time (in random order), with the last edge
+            // completing the word at edgeTime
+            std::vector<int> changedBits;
+            for (std::size_t bit = 0; bit < syncChannels.size(); bit++) {
+                if ((word ^ lineState) & (1 << bit)) {
+                    changedBits.push_back(1 << bit);
+                }
+            }
+            std::shuffle(changedBits.begin(), changedBits.end(), engine);
+            for (std::size_t i = 0; i + 1 < changedBits.size(); i++) {
+                lineState ^= changedBits[i];
+                const MWTime partialTime = edgeTime - MWTime(changedBits.size() - 1 - i) * channelSkew;
+                events.push_back({ partialTime,
+                                   EventType::Sync,
+                                   word,
+                                   sendTime,
+                                   syncWordDecoder.encode(lineState),
+                                   partialTime });
+            }
+        }
+        lineState = word;
+        events.push_back({ edgeTime, EventType::Sync, word, sendTime, syncWordDecoder.encode(word), edgeTime });
+        if (repeat(engine)) {
+            // A bounce reports the same word again, at the same Open Ephys time
+            events.push_back({ edgeTime + bounceDelay(engine),
+                               EventType::Sync,
+                               word,
+                               sendTime,
+                               syncWordDecoder.encode(word),
+                               edgeTime });
+        }
+    }
+    
+    // Spikes reach the interface shortly after they occur
+    for (double time = spikeInterval(engine); time < double(endTime); time += spikeInterval(engine)) {
+        events.push_back({ MWTime(time) + spikeDelay, EventType::Spike, 0, 0, 0, MWTime(time) });
+    }
+    
+    std::stable_sort(events.begin(), events.end());
+    
+    if (!pipeline.reset()) {
+        return;
+    }
+    pipeline.begin();
+    
+    OpenEphysEvent body;
+    std::memset(&body, 0, sizeof(body));
+    body.spike.electrodeID = 1;
+    body.spike.sortedID = 1;
+    
+    // Replay sends and receipts in time order
+    auto nextSent = sentWords.begin();
+    MWTime nextUpdateTime = updateInterval;
+    for (auto &event : events) {
+        currentTime = event.time;
+        currentEvent = &event;
+        
+        while (nextSent != sentWords.end() && nextSent->first <= event.time) {
+            pipeline.addSentSyncWord(nextSent->second, nextSent->first);
+            ++nextSent;
+        }
+        
+        const double timestamp = getOpenEphysTimestamp(event.trueTime);
+        switch (event.type) {
+            case EventType::Sync:
+                body.ttl.word = event.ttlWord;
+                pipeline.handleEvent(OpenEphysEvent::ttlType,
+                                     timestamp,
+                                     reinterpret_cast<const std::uint8_t *>(&body),
+                                     sizeof(body.ttl));
+                break;
+                
+            case EventType::Loopback:
+                pipeline.handleSyncLoopback(event.syncWord, event.time);
+                break;
+                
+            case EventType::Spike:
+                body.spike.timestamp = std::int64_t(std::llround(timestamp * sampleRate));
+                pipeline.handleEvent(OpenEphysEvent::spikeType,
+                                     timestamp,
+                                     reinterpret_cast<const std::uint8_t *>(&body),
+                                     sizeof(body.spike));
+                break;
+        }
+        
+        if (event.time >= nextUpdateTime) {
+            pipeline.update();
+            nextUpdateTime = event.time + updateInterval;
+        }
+    }
+    
+    currentEvent = nullptr;
+    pipeline.end();
+    pipeline.stop();
+}
+
+
+void Simulation::publishClockOffset(MWTime, MWTime) {
+    // The pipeline accepted a match for the sync event being handled
+    const MWTime oeTime = MWTime(getOpenEphysTimestamp(currentEvent->trueTime) * 1e6);
+    const MWTime mwTime = currentEvent->sendTime + MWTime(options.latency);
+    singleSampleOffset = double(mwTime - oeTime);
+    singleSampleValid = true;
+}
+
+
+void Simulation::publishSpike(const OpenEphysSpikeRecord &spike) {
+    const MWTime oeTime = MWTime(getOpenEphysTimestamp(currentEvent->trueTime) * 1e6);
+    if (singleSampleValid) {
+        singleSampleErrors->push_back(double(oeTime) + singleSampleOffset - double(currentEvent->trueTime));
+    }
+    if (pipeline.getClockModel().isValid()) {
+        regressionErrors->push_back(double(spike.time - currentEvent->trueTime));
+    }
+}
+
+
+struct Summary {
+    std::size_t count = 0;
+    double bias = 0.0;
+    double median = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+
+Summary summarize(std::vector<double> errors) {
+    Summary summary;
+    summary.count = errors.size();
+    if (errors.empty()) {
+        return summary;
+    }
+    
+    double total = 0.0;
+    for (auto &error : errors) {
+        total += error;
+        error = std::abs(error);
+    }
+    summary.bias = total / double(errors.size());
+    
+    std::sort(errors.begin(), errors.end());
+    auto percentile = [&errors](double p) {
+        return errors[std::min(errors.size() - 1, std::size_t(p * double(errors.size())))];
+    };
+    summary.median = percentile(0.5);
+    summary.p95 = percentile(0.95);
+    summary.p99 = percentile(0.99);
+    summary.max = errors.back();
+    return summary;
+}
+
+
+bool parseOptions(int argc, char *argv[], Options &options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string name(argv[i]);
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", name.c_str());
+            return false;
+        }
+        const char *value = argv[++i];
+        if (name == "--duration") {
+            options.duration = std::atof(value);
+        } else if (name == "--drift") {
+            options.drift = std::atof(value);
+        } else if (name == "--latency") {
+            options.latency = std::atof(value);
+        } else if (name == "--jitter") {
+            options.jitter = std::atof(value);
+        } else if (name == "--drop") {
+            options.drop = std::atof(value);
+        } else if (name == "--repeat") {
+            options.repeat = std::atof(value);
+        } else if (name == "--split") {
+            options.split = std::atof(value);
+        } else if (name == "--loopback") {
+            options.loopback = (std::atoi(value) != 0);
+        } else if (name == "--seed") {
+            options.seed = std::strtoull(value, nullptr, 10);
+        } else if (name == "--json") {
+            options.jsonPath = value;
+        } else {
+            std::fprintf(stderr, "Unknown option: %s\n", name.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+
+}  // namespace
+
+
+int main(int argc, char *argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+    
+    std::printf("drift %g ppm, latency %g us (sd %g us), drop %g, repeat %g, split %g, loopback %d, %g s per rate\n\n",
+                options.drift, options.latency, options.jitter, options.drop, options.repeat, options.split,
+                int(options.loopback), options.duration);
+    std::printf("%9s  %-13s %8s %10s %10s %10s %10s %10s\n",
+                "sync (Hz)", "estimator", "spikes", "bias (us)", "p50 (us)", "p95 (us)", "p99 (us)", "max (us)");
+    
+    std::ostringstream json;
+    json << "{\n  \"options\": {\"duration\": " << options.duration << ", \"drift\": " << options.drift
+         << ", \"latency\": " << options.latency << ", \"jitter\": " << options.jitter
+         << ", \"drop\": " << options.drop << ", \"repeat\": " << options.repeat << ", \"split\": " << options.split
+         << ", \"loopback\": " << (options.loopback ? "true" : "false")
+         << ", \"seed\": " << options.seed << "},\n  \"results\": [";
+    
+    bool first = true;
+    for (auto syncRate : syncRates) {
+        std::vector<double> singleSampleErrors, regressionErrors;
+        Simulation(options, syncRate).run(singleSampleErrors, regressionErrors);
+        
+        for (auto &result : { std::make_pair("single_sample", summarize(std::move(singleSampleErrors))),
+                              std::make_pair("regression", summarize(std::move(regressionErrors))) })
+        {
+            const auto &s = result.second;
+            std::printf("%9g  %-13s %8lu %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                        syncRate, result.first, (unsigned long)s.count, s.bias, s.median, s.p95, s.p99, s.max);
+            json << (first ? "\n" : ",\n") << "    {\"sync_rate\": " << syncRate
+                 << ", \"estimator\": \"" << result.first << "\", \"count\": " << s.count
+                 << ", \"bias\": " << s.bias << ", \"p50\": " << s.median << ", \"p95\": " << s.p95
+                 << ", \"p99\": " << s.p99 << ", \"max\": " << s.max << "}";
+            first = false;
+        }
+    }
+    json << "\n  ]\n}\n";
+    
+    if (!options.jsonPath.empty()) {
+        std::ofstream file(options.jsonPath);
+        file << json.str();
+        if (!file) {
+            std::fprintf(stderr, "Unable to write %s\n", options.jsonPath.c_str());
+            return 1;
+        }
+    }
+    
+    return 0;
+}
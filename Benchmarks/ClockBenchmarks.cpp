@@ -0,0 +1,89 @@
+//
+//  ClockBenchmarks.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkUtilities.hpp"
+#include "OpenEphysClockService.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+constexpr std::size_t numTimestamps = 4096;
+
+
+std::vector<double> makeTimestamps() {
+    std::vector<double> timestamps;
+    for (auto &spike : makeSpikes(numTimestamps)) {
+        timestamps.push_back(double(spike.sampleNumber) / 30000.0);
+    }
+    return timestamps;
+}
+
+
+END_NAMESPACE()
+
+
+// Same conversion as secsToUS in OpenEphysInterface.cpp
+static void BM_SecsToUS(benchmark::State &state) {
+    const auto timestamps = makeTimestamps();
+    for (auto _ : state) {
+        for (auto timestamp : timestamps) {
+            benchmark::DoNotOptimize(MWTime(timestamp * 1e6));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * timestamps.size());
+}
+BENCHMARK(BM_SecsToUS);
+
+
+static void BM_ClockModelConvert(benchmark::State &state) {
+    const auto timestamps = makeTimestamps();
+    const auto clockModel = makeFittedClockModel();
+    for (auto _ : state) {
+        for (auto timestamp : timestamps) {
+            benchmark::DoNotOptimize(clockModel.convert(MWTime(timestamp * 1e6)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * timestamps.size());
+}
+BENCHMARK(BM_ClockModelConvert);
+
+
+static void BM_ClockServiceConvertSeconds(benchmark::State &state) {
+    const auto timestamps = makeTimestamps();
+    OpenEphysClockService clockService(30000.0);
+    clockService.update(makeFittedClockModel());
+    for (auto _ : state) {
+        for (auto timestamp : timestamps) {
+            MWTime mwTime;
+            benchmark::DoNotOptimize(clockService.convertSeconds(timestamp, mwTime));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * timestamps.size());
+}
+BENCHMARK(BM_ClockServiceConvertSeconds);
+
+
+// Cost of refitting the model when a sync word arrives
+static void BM_ClockModelAddSyncMatch(benchmark::State &state) {
+    auto clockModel = makeFittedClockModel();
+    MWTime mwTime = 100000000;
+    for (auto _ : state) {
+        clockModel.addSyncMatch(MWTime(double(mwTime) * (1.0 + 20e-6)) + 2500000, mwTime);
+        mwTime += 100000;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ClockModelAddSyncMatch);
+
+
+END_NAMESPACE_MW
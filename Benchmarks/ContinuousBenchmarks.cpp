@@ -0,0 +1,214 @@
+//
+//  ContinuousBenchmarks.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "OpenEphysBandEstimator.hpp"
+#include "OpenEphysChannelReducer.hpp"
+#include "OpenEphysContinuousData.hpp"
+#include "OpenEphysContinuousRing.hpp"
+#include "OpenEphysDecimator.hpp"
+#include "OpenEphysEnvelopeDetector.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+constexpr double sampleRate = 30000.0;
+constexpr std::size_t samplesPerMessage = 1024;
+
+
+// One ZMQ Interface message worth of channel-major noise
+std::vector<float> makeMessageData(std::size_t numChannels) {
+    std::mt19937 engine(1);
+    std::normal_distribution<float> noise(0.0f, 50.0f);
+    std::vector<float> data(numChannels * samplesPerMessage);
+    for (auto &sample : data) {
+        sample = noise(engine);
+    }
+    return data;
+}
+
+
+// Reports how many times faster than real time the benchmark processes data
+void setRealTimeFactor(benchmark::State &state, std::size_t samplesPerIteration, double rate = sampleRate) {
+    state.counters["realtime_factor"] = benchmark::Counter(double(samplesPerIteration) / rate,
+                                                           benchmark::Counter::kIsIterationInvariantRate);
+}
+
+
+END_NAMESPACE()
+
+
+static void BM_GatherContinuousChannels(benchmark::State &state) {
+    const std::size_t numChannels = state.range(0);
+    const auto data = makeMessageData(numChannels);
+    std::vector<std::size_t> channels(numChannels);
+    for (std::size_t i = 0; i < numChannels; i++) {
+        channels[i] = i;
+    }
+    std::vector<float> frames;
+    
+    for (auto _ : state) {
+        gatherContinuousChannels(data.data(), samplesPerMessage, channels, frames);
+        benchmark::DoNotOptimize(frames.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * numChannels * samplesPerMessage);
+    setRealTimeFactor(state, samplesPerMessage);
+}
+BENCHMARK(BM_GatherContinuousChannels)->Arg(32)->Arg(384);
+
+
+// Arguments: channels, reference (0 = none, 1 = average, 2 = median), reference group size, channel
+// group size
+static void BM_ReduceChannels(benchmark::State &state) {
+    const std::size_t numChannels = state.range(0);
+    const auto reference = OpenEphysChannelReducer::Reference(state.range(1));
+    OpenEphysChannelReducer reducer(numChannels, reference, state.range(2), state.range(3));
+    const auto data = makeMessageData(numChannels);
+    std::vector<float> output;
+    
+    for (auto _ : state) {
+        reducer.process(data.data(), samplesPerMessage, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * numChannels * samplesPerMessage);
+    setRealTimeFactor(state, samplesPerMessage);
+}
+BENCHMARK(BM_ReduceChannels)
+    ->Args({ 384, 1, 0, 1 })
+    ->Args({ 384, 1, 0, 4 })
+    ->Args({ 384, 2, 32, 1 })
+    ->Args({ 384, 2, 32, 4 });
+
+
+// Arguments are the number of channels and the decimation factor
+static void BM_Decimate(benchmark::State &state) {
+    const std::size_t numChannels = state.range(0);
+    const std::size_t factor = state.range(1);
+    const auto data = makeMessageData(numChannels);
+    OpenEphysDecimator decimator(numChannels, factor);
+    std::vector<float> output;
+    std::vector<std::int64_t> outputSampleNumbers;
+    std::int64_t sampleNumber = 0;
+    
+    for (auto _ : state) {
+        output.clear();
+        outputSampleNumbers.clear();
+        decimator.process(data.data(), samplesPerMessage, sampleNumber, output, outputSampleNumbers);
+        sampleNumber += samplesPerMessage;
+    }
+    
+    state.SetItemsProcessed(state.iterations() * numChannels * samplesPerMessage);
+    setRealTimeFactor(state, samplesPerMessage);
+}
+BENCHMARK(BM_Decimate)->Args({ 32, 30 })->Args({ 384, 30 })->Args({ 384, 15 });
+
+
+static void BM_ContinuousRingWrite(benchmark::State &state) {
+    const std::size_t numChannels = state.range(0);
+    constexpr std::size_t framesPerWrite = 34;  // About one message, decimated by 30
+    OpenEphysContinuousRing ring(numChannels, 10000);
+    const std::vector<float> frames(numChannels * framesPerWrite, 1.0f);
+    std::vector<MWTime> times(framesPerWrite);
+    MWTime time = 0;
+    
+    for (auto _ : state) {
+        for (auto &t : times) {
+            t = (time += 1000);
+        }
+        ring.write(frames.data(), times.data(), framesPerWrite);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * framesPerWrite);
+}
+BENCHMARK(BM_ContinuousRingWrite)->Arg(384);
+
+
+// Reading the most recent 500 ms at 1 kHz, as an experiment's data query would
+static void BM_ContinuousRingRead(benchmark::State &state) {
+    const std::size_t numChannels = state.range(0);
+    OpenEphysContinuousRing ring(numChannels, 10000);
+    const std::vector<float> frame(numChannels, 1.0f);
+    for (MWTime time = 0; time < 10000000; time += 1000) {
+        ring.write(frame.data(), &time, 1);
+    }
+    std::vector<MWTime> times;
+    std::vector<float> frames;
+    
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ring.read(9500000, 10000000, times, frames));
+    }
+    
+    state.SetItemsProcessed(state.iterations() * 500);
+}
+BENCHMARK(BM_ContinuousRingRead)->Arg(4)->Arg(384);
+
+
+// Theta phase and power on one message's worth of data, decimated to 1 kHz
+static void BM_BandEstimate(benchmark::State &state) {
+    const std::size_t numChannels = state.range(0);
+    constexpr double decimatedRate = 1000.0;
+    constexpr std::size_t framesPerMessage = 34;
+    OpenEphysBandEstimator estimator(numChannels, decimatedRate, 6.0, 10.0);
+    const auto data = makeMessageData(numChannels);
+    
+    for (auto _ : state) {
+        estimator.process(data.data(), framesPerMessage);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * numChannels * framesPerMessage);
+    setRealTimeFactor(state, framesPerMessage, decimatedRate);
+}
+BENCHMARK(BM_BandEstimate)->Arg(1)->Arg(32)->Arg(384);
+
+
+// Computing every channel's phase and power, as each publication does
+static void BM_BandEstimatePublish(benchmark::State &state) {
+    const std::size_t numChannels = state.range(0);
+    OpenEphysBandEstimator estimator(numChannels, 1000.0, 6.0, 10.0);
+    const auto data = makeMessageData(numChannels);
+    estimator.process(data.data(), samplesPerMessage);
+    
+    for (auto _ : state) {
+        for (std::size_t channel = 0; channel < numChannels; channel++) {
+            benchmark::DoNotOptimize(estimator.getPhase(channel));
+            benchmark::DoNotOptimize(estimator.getPower(channel));
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations() * numChannels);
+}
+BENCHMARK(BM_BandEstimatePublish)->Arg(32)->Arg(384);
+
+
+// Ripple detection on one message's worth of data, decimated to 1 kHz
+static void BM_EnvelopeDetect(benchmark::State &state) {
+    const std::size_t numChannels = state.range(0);
+    constexpr double decimatedRate = 1000.0;
+    constexpr std::size_t framesPerMessage = 34;
+    OpenEphysEnvelopeDetector detector(numChannels, decimatedRate, 150.0, 250.0, 0.008, 10.0, 5.0, 0.01);
+    const auto data = makeMessageData(numChannels);
+    
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(detector.process(data.data(), framesPerMessage).size());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * numChannels * framesPerMessage);
+    setRealTimeFactor(state, framesPerMessage, decimatedRate);
+}
+BENCHMARK(BM_EnvelopeDetect)->Arg(1)->Arg(32)->Arg(384);
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,139 @@
+//
+//  DatumBenchmarks.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "AllocationCounter.hpp"
+#include "OpenEphysSpikeCodec.hpp"
+#include "OpenEphysSpikeDatumBuilder.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+constexpr std::size_t numSpikes = 4096;
+constexpr std::size_t queueCapacity = 65536;  // Same as notificationQueueCapacity in OpenEphysInterface.cpp
+constexpr std::size_t spikesPerBatch = 64;
+
+
+const char * const spikeFieldNames[] = { "oe_timestamp", "sorted_id", "electrode_id", "channel" };
+
+
+long long getFieldValue(std::size_t spike, std::size_t field) {
+    return (long long)(spike * 4 + field);
+}
+
+
+OpenEphysSpikeRecord makeSpike(std::size_t i) {
+    OpenEphysSpikeRecord spike;
+    spike.time = MWTime(i * 1000);
+    spike.sampleNumber = std::int64_t(i * 30);
+    spike.electrodeID = std::uint16_t(i % 32);
+    spike.sortedID = std::uint16_t(i % 4);
+    spike.channel = std::uint16_t(i % 4);
+    spike.classifiedID = 0;
+    return spike;
+}
+
+
+END_NAMESPACE()
+
+
+//
+// Building a new dictionary for every spike, with keys made from string literals
+//
+static void BM_SpikeDictionaryBuild(benchmark::State &state) {
+    std::vector<Datum> queue(queueCapacity);
+    
+    const std::size_t allocationCount = getAllocationCount();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < numSpikes; i++) {
+            Datum spikeInfo(M_DICTIONARY, 4);
+            for (std::size_t field = 0; field < 4; field++) {
+                spikeInfo.addElement(spikeFieldNames[field], Datum(getFieldValue(i, field)));
+            }
+            queue[i % queueCapacity] = spikeInfo;
+        }
+    }
+    const std::size_t numAllocations = getAllocationCount() - allocationCount;
+    
+    state.SetItemsProcessed(state.iterations() * numSpikes);
+    state.counters["allocs_per_spike"] = double(numAllocations) / double(state.iterations() * numSpikes);
+}
+BENCHMARK(BM_SpikeDictionaryBuild);
+
+
+//
+// What OpenEphysInterface::publishSpike does: building the spike's value with an
+// OpenEphysSpikeDatumBuilder, and copying it into a recycled notification queue slot, as
+// OpenEphysNotificationDispatcher::setValue does.  Argument is 0 for the dictionary encoding (with four
+// fields) or 1 for the scalar encoding.
+//
+static void BM_SpikeDatumBuild(benchmark::State &state) {
+    const bool scalar = (state.range(0) != 0);
+    std::vector<OpenEphysSpikeDatumBuilder::Field> fields;
+    for (auto name : spikeFieldNames) {
+        fields.push_back(OpenEphysSpikeDatumBuilder::parseField(name));
+        if (scalar) {
+            break;
+        }
+    }
+    OpenEphysSpikeDatumBuilder builder(fields, scalar);
+    
+    std::vector<OpenEphysSpikeRecord> spikes;
+    for (std::size_t i = 0; i < numSpikes; i++) {
+        spikes.push_back(makeSpike(i));
+    }
+    std::vector<Datum> queue(queueCapacity, builder.build(spikes.front()));
+    
+    const std::size_t allocationCount = getAllocationCount();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < numSpikes; i++) {
+            queue[i % queueCapacity] = builder.build(spikes[i]);
+        }
+    }
+    const std::size_t numAllocations = getAllocationCount() - allocationCount;
+    
+    state.SetItemsProcessed(state.iterations() * numSpikes);
+    state.counters["allocs_per_spike"] = double(numAllocations) / double(state.iterations() * numSpikes);
+}
+BENCHMARK(BM_SpikeDatumBuild)->Arg(0)->Arg(1);
+
+
+//
+// What OpenEphysInterface::publishSpikeBatch does with the compact encoding: wrapping each batch
+// produced by OpenEphysSpikeBatchEncoder in a string Datum, and queuing it
+//
+static void BM_SpikeBatchDatum(benchmark::State &state) {
+    std::vector<OpenEphysSpikeRecord> spikes;
+    for (std::size_t i = 0; i < numSpikes; i++) {
+        spikes.push_back(makeSpike(i));
+    }
+    OpenEphysSpikeBatchEncoder encoder;
+    std::vector<Datum> queue(queueCapacity);
+    
+    const std::size_t allocationCount = getAllocationCount();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < numSpikes; i++) {
+            encoder.add(spikes[i]);
+            if (encoder.size() == spikesPerBatch) {
+                queue[(i / spikesPerBatch) % queueCapacity] = Datum(encoder.finish());
+            }
+        }
+    }
+    const std::size_t numAllocations = getAllocationCount() - allocationCount;
+    
+    state.SetItemsProcessed(state.iterations() * numSpikes);
+    state.counters["allocs_per_spike"] = double(numAllocations) / double(state.iterations() * numSpikes);
+}
+BENCHMARK(BM_SpikeBatchDatum);
+
+
+END_NAMESPACE_MW
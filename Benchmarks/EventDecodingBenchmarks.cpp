@@ -0,0 +1,179 @@
+//
+//  EventDecodingBenchmarks.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkUtilities.hpp"
+#include "OpenEphysEvent.hpp"
+#include "OpenEphysSyncMatcher.hpp"
+#include "OpenEphysSyncSequence.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+constexpr std::size_t numFrames = 4096;
+
+
+// The three message parts sent by the Event Broadcaster, stored back to back.  A TTL event carries a
+// sync word, which was sent at the time its Open Ephys timestamp indicates.
+struct RawFrame {
+    std::uint8_t type;
+    double timestamp;
+    std::uint8_t body[sizeof(OpenEphysEvent)];
+    std::size_t bodySize;
+    int syncWord;
+};
+
+
+RawFrame makeSyncFrame(double timestamp, int syncWord, const OpenEphysSyncWordDecoder &syncWordDecoder) {
+    RawFrame frame;
+    std::memset(&frame, 0, sizeof(frame));
+    frame.type = OpenEphysEvent::ttlType;
+    frame.timestamp = timestamp;
+    frame.syncWord = syncWord;
+    
+    OpenEphysEvent event;
+    std::memset(&event, 0, sizeof(event));
+    event.ttl.word = syncWordDecoder.encode(syncWord);
+    frame.bodySize = sizeof(event.ttl);
+    std::memcpy(frame.body, &event, frame.bodySize);
+    return frame;
+}
+
+
+std::vector<RawFrame> makeFrames(double ttlFraction, const OpenEphysSyncWordDecoder &syncWordDecoder) {
+    std::mt19937_64 engine(1);
+    std::bernoulli_distribution isTTL(ttlFraction);
+    OpenEphysSyncSequence syncSequence(syncWordDecoder.getNumChannels());
+    
+    std::vector<RawFrame> frames;
+    for (auto &spike : makeSpikes(numFrames)) {
+        const double timestamp = double(spike.sampleNumber) / 30000.0;
+        if (isTTL(engine)) {
+            frames.push_back(makeSyncFrame(timestamp, syncSequence.next(), syncWordDecoder));
+            continue;
+        }
+        
+        RawFrame frame;
+        std::memset(&frame, 0, sizeof(frame));
+        frame.type = OpenEphysEvent::spikeType;
+        frame.timestamp = timestamp;
+        
+        OpenEphysEvent event;
+        std::memset(&event, 0, sizeof(event));
+        event.spike.electrodeID = spike.electrodeID;
+        event.spike.sortedID = spike.sortedID;
+        event.spike.channel = spike.channel;
+        event.spike.timestamp = spike.sampleNumber;
+        frame.bodySize = sizeof(event.spike);
+        std::memcpy(frame.body, &event, frame.bodySize);
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+
+END_NAMESPACE()
+
+
+//
+// The per-event work of the event receiver thread, minus the socket: each frame is passed to
+// OpenEphysEventPipeline::handleEvent, which matches sync words and refits the clock model, or
+// converts and publishes spikes (to a delegate that discards them).  Each sync word is recorded as
+// sent just before its echo arrives, as the interface's sync notification would record it.  The
+// argument is the percentage of TTL events.
+//
+static void BM_DecodeEventFrames(benchmark::State &state) {
+    const std::vector<std::uint8_t> syncChannels { 0, 1, 2, 3 };
+    const OpenEphysSyncWordDecoder syncWordDecoder(syncChannels);
+    const auto frames = makeFrames(double(state.range(0)) / 100.0, syncWordDecoder);
+    
+    NullDelegate delegate;
+    OpenEphysEventPipeline pipeline(delegate, syncChannels, boost::make_shared<OpenEphysClockService>(30000.0));
+    pipeline.enableSpikes(0);
+    pipeline.reset();
+    pipeline.begin();
+    
+    const auto handleFrame = [&pipeline](const RawFrame &frame) {
+        if (frame.type == OpenEphysEvent::ttlType) {
+            pipeline.addSentSyncWord(frame.syncWord, MWTime(frame.timestamp * 1e6));
+        }
+        pipeline.handleEvent(frame.type, frame.timestamp, frame.body, frame.bodySize);
+    };
+    
+    // Lock the clock model before measuring, so that spike times are converted
+    OpenEphysSyncSequence syncSequence(syncChannels.size());
+    for (std::size_t i = 0; i < 16; i++) {
+        handleFrame(makeSyncFrame(0.1 * double(i), syncSequence.next(), syncWordDecoder));
+    }
+    
+    for (auto _ : state) {
+        for (auto &frame : frames) {
+            handleFrame(frame);
+        }
+    }
+    
+    benchmark::DoNotOptimize(delegate.numSpikes);
+    state.SetItemsProcessed(state.iterations() * frames.size());
+}
+BENCHMARK(BM_DecodeEventFrames)->Arg(0)->Arg(10)->Arg(100);
+
+
+static void BM_SyncWordDecode(benchmark::State &state) {
+    std::vector<std::uint8_t> channels;
+    for (int i = 0; i < state.range(0); i++) {
+        channels.push_back(std::uint8_t(i));
+    }
+    const OpenEphysSyncWordDecoder syncWordDecoder(channels);
+    
+    std::mt19937_64 engine(1);
+    std::vector<std::uint64_t> words(numFrames);
+    for (auto &word : words) {
+        word = engine();
+    }
+    
+    for (auto _ : state) {
+        for (auto word : words) {
+            benchmark::DoNotOptimize(syncWordDecoder.decode(word));
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations() * words.size());
+}
+// Argument is the number of sync channels, up to OpenEphysSyncWordDecoder::maxChannels
+BENCHMARK(BM_SyncWordDecode)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->Arg(31);
+
+
+// Matching each received word of an 8-bit sync sequence, as it arrives, against the window of
+// recent transmissions
+static void BM_SyncMatch(benchmark::State &state) {
+    const std::size_t windowSize = state.range(0);
+    OpenEphysSyncSequence syncSequence(8);
+    std::vector<int> words(numFrames);
+    for (auto &word : words) {
+        word = syncSequence.next();
+    }
+    OpenEphysSyncMatcher syncMatcher(windowSize);
+    
+    for (auto _ : state) {
+        MWTime time = 0, sendTime = 0;
+        for (auto word : words) {
+            syncMatcher.addSentValue(word, time += 100000);
+            benchmark::DoNotOptimize(syncMatcher.matchReceivedValue(word, sendTime));
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations() * words.size());
+}
+BENCHMARK(BM_SyncMatch)->Arg(1)->Arg(8);
+
+
+END_NAMESPACE_MW
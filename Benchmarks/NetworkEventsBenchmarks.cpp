@@ -0,0 +1,74 @@
+//
+//  NetworkEventsBenchmarks.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "OpenEphysNetworkEventsRequester.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Round trip of a Network Events request over an inproc transport, through the
+// OpenEphysNetworkEventsRequester that OpenEphysNetworkEventsClient sends its requests with.  A thread
+// stands in for the Network Events module, replying to each request with a short acknowledgment, as
+// Open Ephys does.
+//
+static void BM_NetworkEventsRequestResponse(benchmark::State &state) {
+    std::unique_ptr<void, decltype(&zmq_ctx_term)> context(zmq_ctx_new(), zmq_ctx_term);
+    std::unique_ptr<void, decltype(&zmq_close)> server(zmq_socket(context.get(), ZMQ_REP), zmq_close);
+    std::unique_ptr<void, decltype(&zmq_close)> client(zmq_socket(context.get(), ZMQ_REQ), zmq_close);
+    
+    const int linger = 0;
+    const int timeout = 1000;  // ms
+    zmq_setsockopt(server.get(), ZMQ_LINGER, &linger, sizeof(linger));
+    zmq_setsockopt(server.get(), ZMQ_RCVTIMEO, &timeout, sizeof(timeout));
+    
+    OpenEphysNetworkEventsRequester requester;
+    if (!requester.configure(client.get())) {
+        state.SkipWithError("Unable to configure requester");
+        return;
+    }
+    
+    if (0 != zmq_bind(server.get(), "inproc://network_events") ||
+        0 != zmq_connect(client.get(), "inproc://network_events"))
+    {
+        state.SkipWithError(zmq_strerror(zmq_errno()));
+        return;
+    }
+    
+    std::atomic_bool serving(true);
+    std::thread serverThread([&]() {
+        std::vector<char> req(1024);
+        const std::string rep("StartRecord received");
+        while (serving) {
+            if (-1 != zmq_recv(server.get(), req.data(), req.size(), 0)) {
+                zmq_send(server.get(), rep.data(), rep.size(), 0);
+            }
+        }
+    });
+    
+    const std::string req(state.range(0), 'x');
+    std::string rep;
+    for (auto _ : state) {
+        if (!requester.sendRequest(req, rep)) {
+            state.SkipWithError("Request failed");
+            break;
+        }
+    }
+    
+    serving = false;
+    serverThread.join();
+    
+    state.SetItemsProcessed(state.iterations());
+}
+// Argument is the request size in bytes
+BENCHMARK(BM_NetworkEventsRequestResponse)->Arg(16)->Arg(256)->UseRealTime();
+
+
+END_NAMESPACE_MW
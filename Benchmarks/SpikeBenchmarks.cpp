@@ -0,0 +1,303 @@
+//
+//  SpikeBenchmarks.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkUtilities.hpp"
+#include "OpenEphysCrossCorrelogram.hpp"
+#include "OpenEphysEvent.hpp"
+#include "OpenEphysPopulationDecoder.hpp"
+#include "OpenEphysSpikeClassifier.hpp"
+#include "OpenEphysSpikeCodec.hpp"
+#include "OpenEphysSpikeStore.hpp"
+#include "OpenEphysSpikeTriggeredAverage.hpp"
+#include "OpenEphysUnitQuality.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+constexpr std::size_t numSpikes = 4096;
+constexpr std::size_t spikesPerBatch = 1024;  // Same as maxSpikesPerBatch in OpenEphysInterface.cpp
+
+// Aggregate spike rate of a Neuropixels probe (384 channels) during peak activity
+constexpr double peakSpikeRate = 50000.0;
+
+
+END_NAMESPACE()
+
+
+//
+// Building spike Datum values requires MWorksCore (see DatumBenchmarks.cpp), so this suite measures the
+// standalone equivalent: encoding spikes into the compact batches published by spike_encoding = "compact"
+//
+static void BM_SpikeBatchEncode(benchmark::State &state) {
+    const auto spikes = makeSpikes(numSpikes);
+    OpenEphysSpikeBatchEncoder encoder;
+    std::size_t numBytes = 0;
+    
+    for (auto _ : state) {
+        for (auto &spike : spikes) {
+            encoder.add(spike);
+            if (encoder.size() >= spikesPerBatch) {
+                numBytes += encoder.finish().size();
+            }
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations() * spikes.size());
+    state.counters["bytes_per_spike"] = double(numBytes) / double(state.iterations() * spikes.size());
+}
+BENCHMARK(BM_SpikeBatchEncode);
+
+
+static void BM_SpikeBatchDecode(benchmark::State &state) {
+    const auto spikes = makeSpikes(spikesPerBatch);
+    OpenEphysSpikeBatchEncoder encoder;
+    for (auto &spike : spikes) {
+        encoder.add(spike);
+    }
+    const auto batch = encoder.finish();
+    std::vector<OpenEphysSpikeRecord> decoded;
+    
+    for (auto _ : state) {
+        decoded.clear();
+        benchmark::DoNotOptimize(decodeSpikeBatch(batch, decoded));
+    }
+    
+    state.SetItemsProcessed(state.iterations() * spikes.size());
+}
+BENCHMARK(BM_SpikeBatchDecode);
+
+
+static void BM_SpikeStoreAdd(benchmark::State &state) {
+    const auto spikes = makeSpikes(numSpikes);
+    OpenEphysSpikeStore store(1000);
+    const MWTime duration = spikes.back().time - spikes.front().time + 1;
+    MWTime offset = 0;
+    
+    for (auto _ : state) {
+        // Shift each pass later in time, so that spikes keep arriving in order, as they do from Open Ephys
+        for (auto &spike : spikes) {
+            store.addSpike(spike.electrodeID, spike.sortedID, spike.time + offset);
+        }
+        offset += duration;
+    }
+    
+    state.SetItemsProcessed(state.iterations() * spikes.size());
+}
+BENCHMARK(BM_SpikeStoreAdd);
+
+
+static void BM_SpikeStoreCount(benchmark::State &state) {
+    const auto spikes = makeSpikes(numSpikes);
+    OpenEphysSpikeStore store(state.range(0));
+    for (auto &spike : spikes) {
+        store.addSpike(spike.electrodeID, spike.sortedID, spike.time);
+    }
+    const MWTime start = spikes.front().time, end = spikes.back().time;
+    
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(store.count(7, 2, start + (end - start) / 4, end - (end - start) / 4));
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpikeStoreCount)->Arg(100)->Arg(1000)->Arg(10000);
+
+
+// Two variables (e.g. eye position) updated at 1 kHz, with a 200 ms window in 10 ms bins.  Argument:
+// history size.
+static void BM_SpikeTriggeredAverageAddSpike(benchmark::State &state) {
+    const std::size_t historySize = state.range(0);
+    const auto spikes = makeSpikes(numSpikes);
+    OpenEphysSpikeTriggeredAverage sta(2, 1, 200000, 10000, historySize);
+    const MWTime end = spikes.back().time;
+    for (MWTime time = end - MWTime(historySize) * 1000; time <= end; time += 1000) {
+        sta.addValue(0, time, double(time % 7));
+        sta.addValue(1, time, double(time % 11));
+    }
+    
+    for (auto _ : state) {
+        for (auto &spike : spikes) {
+            benchmark::DoNotOptimize(sta.addSpike(0, spike.time));
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations() * spikes.size());
+}
+BENCHMARK(BM_SpikeTriggeredAverageAddSpike)->Arg(1000)->Arg(10000)->Arg(100000);
+
+
+// Correlograms of N selected units with a 50 ms window in 1 ms bins, where the selected units are the
+// first N of the 128 in the spike stream (about 80 Hz each).  Argument: number of units.
+static void BM_CrossCorrelogramAddSpike(benchmark::State &state) {
+    const std::size_t numUnits = state.range(0);
+    const auto allSpikes = makeSpikes(numSpikes);
+    std::vector<std::pair<std::size_t, MWTime>> spikes;
+    for (auto &spike : allSpikes) {
+        const std::size_t unit = std::size_t(spike.electrodeID) * 4 + spike.sortedID - 1;
+        if (unit < numUnits) {
+            spikes.emplace_back(unit, spike.time);
+        }
+    }
+    OpenEphysCrossCorrelogram ccg(numUnits, 50000, 1000);
+    const MWTime duration = allSpikes.back().time - allSpikes.front().time + 1;
+    MWTime offset = 0;
+    
+    for (auto _ : state) {
+        for (auto &spike : spikes) {
+            ccg.addSpike(spike.first, spike.second + offset);
+        }
+        offset += duration;
+    }
+    
+    state.SetItemsProcessed(state.iterations() * spikes.size());
+}
+BENCHMARK(BM_CrossCorrelogramAddSpike)->Arg(8)->Arg(32)->Arg(128);
+
+// Decoding one bin of counts into a 2D velocity.  Argument: number of units.
+static void BM_LinearDecode(benchmark::State &state) {
+    const std::size_t numUnits = state.range(0);
+    constexpr std::size_t numOutputs = 2;
+    std::mt19937 engine(1);
+    std::normal_distribution<double> weight(0.0, 0.1);
+    std::poisson_distribution<int> count(2.0);
+    std::vector<double> weights(numOutputs * numUnits), counts(numUnits), output(numOutputs);
+    for (auto &w : weights) {
+        w = weight(engine);
+    }
+    for (auto &c : counts) {
+        c = count(engine);
+    }
+    OpenEphysLinearDecoder decoder(numUnits, numOutputs, std::move(weights), std::vector<double>(numOutputs, 0.0));
+    
+    for (auto _ : state) {
+        decoder.decode(counts.data(), output.data());
+        benchmark::DoNotOptimize(output.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LinearDecode)->Arg(128)->Arg(384);
+
+
+// Kalman decoding of one bin into a 4D state (e.g. position and velocity).  Argument: number of units.
+static void BM_KalmanDecode(benchmark::State &state) {
+    const std::size_t numUnits = state.range(0);
+    constexpr std::size_t numStates = 4;
+    std::mt19937 engine(1);
+    std::normal_distribution<double> weight(0.0, 1.0);
+    std::poisson_distribution<int> count(2.0);
+    std::vector<double> transition(numStates * numStates, 0.0), processNoise(numStates * numStates, 0.0);
+    for (std::size_t i = 0; i < numStates; i++) {
+        transition[i * numStates + i] = 0.95;
+        processNoise[i * numStates + i] = 0.01;
+    }
+    std::vector<double> observation(numUnits * numStates), observationNoise(numUnits * numUnits, 0.0);
+    for (auto &w : observation) {
+        w = weight(engine);
+    }
+    for (std::size_t i = 0; i < numUnits; i++) {
+        observationNoise[i * numUnits + i] = 2.0;
+    }
+    std::vector<double> counts(numUnits), output(numStates);
+    for (auto &c : counts) {
+        c = count(engine);
+    }
+    OpenEphysKalmanDecoder decoder(numUnits,
+                                   numStates,
+                                   std::move(transition),
+                                   std::move(processNoise),
+                                   std::move(observation),
+                                   std::vector<double>(numUnits, 2.0),
+                                   observationNoise);
+    
+    for (auto _ : state) {
+        decoder.decode(counts.data(), output.data());
+        benchmark::DoNotOptimize(output.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_KalmanDecode)->Arg(128)->Arg(384);
+
+// Template matching of waveforms from 384 electrodes.  Arguments: templates per electrode and samples
+// per waveform (40 is 1.33 ms of one channel at 30 kHz; 160 is the same on a tetrode).
+static void BM_SpikeClassify(benchmark::State &state) {
+    constexpr std::size_t numElectrodes = 384;
+    const std::size_t numTemplates = state.range(0);
+    const std::size_t numSamples = state.range(1);
+    std::mt19937 engine(1);
+    std::normal_distribution<float> sample(0.0f, 50.0f);
+    
+    OpenEphysSpikeClassifier classifier(0.0);
+    std::vector<float> templateSamples(numSamples);
+    for (std::size_t electrode = 0; electrode < numElectrodes; electrode++) {
+        for (std::size_t unit = 1; unit <= numTemplates; unit++) {
+            for (auto &s : templateSamples) {
+                s = sample(engine);
+            }
+            classifier.addTemplate(std::uint16_t(electrode), std::uint16_t(unit), templateSamples);
+        }
+    }
+    
+    // Payloads as received, i.e. a float threshold for the single channel, followed by float samples
+    constexpr std::size_t numWaveforms = 1024;
+    const std::size_t payloadBytes = (1 + numSamples) * sizeof(float);
+    std::uniform_int_distribution<int> electrode(0, numElectrodes - 1);
+    std::vector<std::uint16_t> electrodeIDs(numWaveforms);
+    std::vector<std::uint8_t> messages(numWaveforms * (sizeof(OpenEphysEvent::Spike) + payloadBytes));
+    for (std::size_t i = 0; i < numWaveforms; i++) {
+        electrodeIDs[i] = std::uint16_t(electrode(engine));
+        auto payload = messages.data() + i * (sizeof(OpenEphysEvent::Spike) + payloadBytes) + sizeof(OpenEphysEvent::Spike);
+        for (std::size_t j = 0; j <= numSamples; j++) {
+            const float value = sample(engine);
+            std::memcpy(payload + j * sizeof(value), &value, sizeof(value));
+        }
+    }
+    
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < numWaveforms; i++) {
+            auto payload = messages.data() + i * (sizeof(OpenEphysEvent::Spike) + payloadBytes) + sizeof(OpenEphysEvent::Spike);
+            benchmark::DoNotOptimize(classifier.classify(electrodeIDs[i], 1, payload, payloadBytes));
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations() * numWaveforms);
+    state.counters["realtime_factor"] = benchmark::Counter(double(numWaveforms) / peakSpikeRate,
+                                                           benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_SpikeClassify)->Args({ 4, 40 })->Args({ 16, 40 })->Args({ 4, 160 });
+
+// ISI tracking in the spike decode path, with statistics taken at 1 s intervals (about 10,000 spikes)
+static void BM_UnitQualityAddSpike(benchmark::State &state) {
+    const auto spikes = makeSpikes(numSpikes);
+    OpenEphysUnitQuality quality(1500, 10000, 3);
+    const MWTime duration = spikes.back().time - spikes.front().time + 1;
+    MWTime offset = 0;
+    std::size_t numAdded = 0;
+    
+    for (auto _ : state) {
+        for (auto &spike : spikes) {
+            quality.addSpike(spike.electrodeID, spike.sortedID, spike.time + offset);
+        }
+        offset += duration;
+        if ((numAdded += spikes.size()) >= 10000) {
+            benchmark::DoNotOptimize(quality.takeStats());
+            numAdded = 0;
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations() * spikes.size());
+}
+BENCHMARK(BM_UnitQualityAddSpike);
+
+END_NAMESPACE_MW
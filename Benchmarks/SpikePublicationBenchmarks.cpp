@@ -0,0 +1,74 @@
+//
+//  SpikePublicationBenchmarks.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "AllocationCounter.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "OpenEphysEventPipeline.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+constexpr std::size_t numSpikes = 4096;
+
+
+END_NAMESPACE()
+
+
+//
+// Allocations per spike on the path from a received spike event to its publication, through the
+// event pipeline with a spike store.  The argument is the spike batch interval (zero publishes each
+// spike individually).  Datum construction requires MWorksCore, and is measured by DatumBenchmarks.cpp.
+//
+static void BM_PipelineSpikeAllocations(benchmark::State &state) {
+    NullDelegate delegate;
+    OpenEphysEventPipeline pipeline(delegate, { 0, 1, 2, 3 }, boost::make_shared<OpenEphysClockService>(30000.0));
+    pipeline.enableSpikes(state.range(0));
+    pipeline.setSpikeStore(std::unique_ptr<OpenEphysSpikeStore>(new OpenEphysSpikeStore(1024)));
+    pipeline.reset();
+    
+    const auto spikes = makeSpikes(numSpikes);
+    std::vector<OpenEphysEvent::Spike> events(spikes.size());
+    for (std::size_t i = 0; i < spikes.size(); i++) {
+        std::memset(&events[i], 0, sizeof(events[i]));
+        events[i].timestamp = spikes[i].sampleNumber;
+        events[i].electrodeID = spikes[i].electrodeID;
+        events[i].sortedID = spikes[i].sortedID;
+        events[i].channel = spikes[i].channel;
+    }
+    
+    const auto handleEvents = [&]() {
+        for (std::size_t i = 0; i < events.size(); i++) {
+            pipeline.handleEvent(OpenEphysEvent::spikeType,
+                                 double(spikes[i].time) / 1e6,
+                                 reinterpret_cast<const std::uint8_t *>(&events[i]),
+                                 sizeof(events[i]));
+        }
+    };
+    
+    // The first spike of each unit allocates its history in the store
+    handleEvents();
+    
+    const std::size_t allocationCount = getAllocationCount();
+    for (auto _ : state) {
+        handleEvents();
+    }
+    const std::size_t numAllocations = getAllocationCount() - allocationCount;
+    
+    benchmark::DoNotOptimize(delegate.numSpikes);
+    state.SetItemsProcessed(state.iterations() * events.size());
+    state.counters["allocs_per_spike"] = double(numAllocations) / double(state.iterations() * events.size());
+}
+BENCHMARK(BM_PipelineSpikeAllocations)->Arg(0)->Arg(100000);
+
+
+END_NAMESPACE_MW
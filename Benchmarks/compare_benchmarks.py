@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""
+Compare two Google Benchmark JSON result files (e.g. from before and after a
+change), as written by "cmake --build <dir> --target benchmark":
+
+    compare_benchmarks.py before.json after.json [--threshold PERCENT]
+
+For each benchmark present in both files, prints the time per iteration in
+each run and the relative change.  Changes larger than the threshold (default
+5%) are flagged.  Exits with status 1 if any benchmark got slower by more than
+the threshold, so the script can gate automated runs.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    with open(path) as f:
+        data = json.load(f)
+    results = {}
+    for bench in data.get('benchmarks', []):
+        # With repetitions, compare the medians only
+        if bench.get('run_type') == 'aggregate' and bench.get('aggregate_name') != 'median':
+            continue
+        name = bench.get('run_name', bench['name'])
+        results[name] = (bench['real_time'], bench['cpu_time'], bench['time_unit'])
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument('before')
+    parser.add_argument('after')
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help='percent change to flag (default: %(default)s)')
+    parser.add_argument('--real-time', action='store_true',
+                        help='compare wall-clock instead of CPU time')
+    args = parser.parse_args()
+
+    before = load_results(args.before)
+    after = load_results(args.after)
+    index = 0 if args.real_time else 1
+
+    names = [name for name in before if name in after]
+    if not names:
+        print('No benchmarks in common', file=sys.stderr)
+        return 1
+
+    width = max(len(name) for name in set(before) | set(after))
+    print('%-*s %14s %14s %9s' % (width, 'Benchmark', 'Before', 'After', 'Change'))
+
+    regressed = False
+    for name in names:
+        old, new = before[name][index], after[name][index]
+        unit = after[name][2]
+        change = (new - old) / old * 100.0 if old else 0.0
+        flag = ''
+        if change > args.threshold:
+            flag = '  slower'
+            regressed = True
+        elif change < -args.threshold:
+            flag = '  faster'
+        print('%-*s %11.1f %-2s %11.1f %-2s %+8.1f%%%s' %
+              (width, name, old, unit, new, unit, change, flag))
+
+    for name in sorted(set(before) ^ set(after)):
+        print('%-*s (only in %s)' % (width, name, 'before' if name in before else 'after'))
+
+    return 1 if regressed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,228 @@
+//
+//  OpenEphysBandEstimator.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysBandEstimator.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+// Cascading two identical band-pass sections narrows the -3 dB bandwidth by this factor, so each
+// section is made wider to compensate
+constexpr double cascadeBandwidthFactor = 0.6436;
+
+
+END_NAMESPACE()
+
+
+OpenEphysBiquad OpenEphysBiquad::lowPass(double sampleRate, double cutoff, double q) {
+    const double w0 = 2.0 * M_PI * cutoff / sampleRate;
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double cosW0 = std::cos(w0);
+    return OpenEphysBiquad((1.0 - cosW0) / 2.0, 1.0 - cosW0, (1.0 - cosW0) / 2.0, 1.0 + alpha, -2.0 * cosW0, 1.0 - alpha);
+}
+
+
+OpenEphysBiquad OpenEphysBiquad::bandPass(double sampleRate, double center, double q) {
+    // Unity gain (and zero phase shift) at the center frequency
+    const double w0 = 2.0 * M_PI * center / sampleRate;
+    const double alpha = std::sin(w0) / (2.0 * q);
+    return OpenEphysBiquad(alpha, 0.0, -alpha, 1.0 + alpha, -2.0 * std::cos(w0), 1.0 - alpha);
+}
+
+
+std::complex<double> OpenEphysBiquad::getResponse(double frequency) const {
+    const auto z1 = std::polar(1.0, -frequency);
+    const auto z2 = z1 * z1;
+    return ((double(b0) + double(b1) * z1 + double(b2) * z2) / (1.0 + double(a1) * z1 + double(a2) * z2));
+}
+
+
+OpenEphysBiquad OpenEphysBiquad::cascadedBandPass(double sampleRate, double lowFrequency, double highFrequency) {
+    const double center = std::sqrt(lowFrequency * highFrequency);
+    return bandPass(sampleRate, center, center / (highFrequency - lowFrequency) * cascadeBandwidthFactor);
+}
+
+
+OpenEphysBiquad::OpenEphysBiquad(double b0, double b1, double b2, double a0, double a1, double a2) :
+    b0(b0 / a0),
+    b1(b1 / a0),
+    b2(b2 / a0),
+    a1(a1 / a0),
+    a2(a2 / a0),
+    numChannels(0)
+{ }
+
+
+void OpenEphysBiquad::setNumChannels(std::size_t numChannels) {
+    this->numChannels = numChannels;
+    reset();
+}
+
+
+void OpenEphysBiquad::reset() {
+    state1.assign(numChannels, 0.0f);
+    state2.assign(numChannels, 0.0f);
+}
+
+
+void OpenEphysBiquad::process(float *frames, std::size_t numFrames) {
+    float * const s1 = state1.data();
+    float * const s2 = state2.data();
+    for (std::size_t frame = 0; frame < numFrames; frame++) {
+        float * const x = frames + frame * numChannels;
+        for (std::size_t channel = 0; channel < numChannels; channel++) {
+            const float in = x[channel];
+            const float out = b0 * in + s1[channel];
+            s1[channel] = b1 * in - a1 * out + s2[channel];
+            s2[channel] = b2 * in - a2 * out;
+            x[channel] = out;
+        }
+    }
+}
+
+
+OpenEphysBandEstimator::OpenEphysBandEstimator(std::size_t numChannels,
+                                               double sampleRate,
+                                               double lowFrequency,
+                                               double highFrequency) :
+    numChannels(numChannels),
+    sampleRate(sampleRate),
+    lowFrequency(lowFrequency),
+    highFrequency(highFrequency),
+    oscillatorIncrement(2.0 * M_PI * std::sqrt(lowFrequency * highFrequency) / sampleRate),
+    // Average the envelope rotation over roughly one cycle of its fastest variation
+    rotationSmoothing(float(std::min(1.0, M_PI * (highFrequency - lowFrequency) / sampleRate))),
+    bandPass1(OpenEphysBiquad::cascadedBandPass(sampleRate, lowFrequency, highFrequency)),
+    bandPass2(bandPass1),
+    // The envelope varies at most at half the bandwidth
+    inPhaseLowPass(OpenEphysBiquad::lowPass(sampleRate, (highFrequency - lowFrequency) / 2.0, M_SQRT1_2)),
+    quadratureLowPass(inPhaseLowPass),
+    oscillatorPhase(0.0)
+{
+    if (numChannels < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Band estimator requires at least one channel");
+    }
+    if (lowFrequency <= 0.0 || highFrequency <= lowFrequency || highFrequency >= sampleRate / 2.0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                              "Frequency band must be positive, increasing, and below the Nyquist frequency");
+    }
+    
+    for (auto filter : { &bandPass1, &bandPass2, &inPhaseLowPass, &quadratureLowPass }) {
+        filter->setNumChannels(numChannels);
+    }
+    
+    reset();
+}
+
+
+void OpenEphysBandEstimator::reset() {
+    for (auto filter : { &bandPass1, &bandPass2, &inPhaseLowPass, &quadratureLowPass }) {
+        filter->reset();
+    }
+    oscillatorPhase = 0.0;
+    inPhase.assign(numChannels, 0.0f);
+    quadrature.assign(numChannels, 0.0f);
+    rotationReal.assign(numChannels, 0.0f);
+    rotationImag.assign(numChannels, 0.0f);
+}
+
+
+void OpenEphysBandEstimator::process(const float *frames, std::size_t numFrames) {
+    bandSignal.assign(frames, frames + numFrames * numChannels);
+    bandPass1.process(bandSignal.data(), numFrames);
+    bandPass2.process(bandSignal.data(), numFrames);
+    
+    // The envelope arrays start with the most recent envelope from the previous call
+    inPhase.resize((numFrames + 1) * numChannels);
+    quadrature.resize((numFrames + 1) * numChannels);
+    float * const envelopeI = inPhase.data() + numChannels;
+    float * const envelopeQ = quadrature.data() + numChannels;
+    
+    for (std::size_t frame = 0; frame < numFrames; frame++) {
+        oscillatorPhase = std::remainder(oscillatorPhase + oscillatorIncrement, 2.0 * M_PI);
+        const float cosine = float(std::cos(oscillatorPhase));
+        const float sine = float(std::sin(oscillatorPhase));
+        
+        const float *x = bandSignal.data() + frame * numChannels;
+        float *i = envelopeI + frame * numChannels;
+        float *q = envelopeQ + frame * numChannels;
+        for (std::size_t channel = 0; channel < numChannels; channel++) {
+            i[channel] = x[channel] * cosine;
+            q[channel] = -x[channel] * sine;
+        }
+    }
+    
+    inPhaseLowPass.process(envelopeI, numFrames);
+    quadratureLowPass.process(envelopeQ, numFrames);
+    
+    // Track the rotation of the envelope between successive frames
+    float * const rotRe = rotationReal.data();
+    float * const rotIm = rotationImag.data();
+    for (std::size_t frame = 0; frame < numFrames; frame++) {
+        const float *previousI = inPhase.data() + frame * numChannels;
+        const float *previousQ = quadrature.data() + frame * numChannels;
+        const float *i = previousI + numChannels;
+        const float *q = previousQ + numChannels;
+        for (std::size_t channel = 0; channel < numChannels; channel++) {
+            const float re = i[channel] * previousI[channel] + q[channel] * previousQ[channel];
+            const float im = q[channel] * previousI[channel] - i[channel] * previousQ[channel];
+            rotRe[channel] += rotationSmoothing * (re - rotRe[channel]);
+            rotIm[channel] += rotationSmoothing * (im - rotIm[channel]);
+        }
+    }
+    
+    // Keep only the most recent envelope
+    inPhase.erase(inPhase.begin(), inPhase.end() - numChannels);
+    quadrature.erase(quadrature.begin(), quadrature.end() - numChannels);
+}
+
+
+double OpenEphysBandEstimator::getFrequencyPerSample(std::size_t channel) const {
+    double frequency = oscillatorIncrement;
+    if (rotationReal.at(channel) != 0.0f || rotationImag.at(channel) != 0.0f) {
+        frequency += std::atan2(double(rotationImag[channel]), double(rotationReal[channel]));
+    }
+    const double scale = 2.0 * M_PI / sampleRate;
+    return std::max(lowFrequency * scale, std::min(highFrequency * scale, frequency));
+}
+
+
+double OpenEphysBandEstimator::getPhase(std::size_t channel) const {
+    const double envelopePhase = std::atan2(double(quadrature.at(channel)), double(inPhase.at(channel)));
+    
+    // Remove the phase shift of the filters at the channel's current frequency.  The low-pass filters
+    // act on the envelope, whose frequency is the offset from the oscillator.
+    const double frequency = getFrequencyPerSample(channel);
+    const auto bandPassResponse = bandPass1.getResponse(frequency);
+    const double filterPhase = (2.0 * std::arg(bandPassResponse) +
+                                std::arg(inPhaseLowPass.getResponse(frequency - oscillatorIncrement)));
+    
+    return std::remainder(oscillatorPhase + envelopePhase - filterPhase, 2.0 * M_PI);
+}
+
+
+double OpenEphysBandEstimator::getPower(std::size_t channel) const {
+    // The envelope has half the signal amplitude, and a sinusoid's mean square is half its squared
+    // amplitude.  As with phase, remove the filters' gain at the channel's current frequency.
+    const double i = inPhase.at(channel), q = quadrature.at(channel);
+    const double frequency = getFrequencyPerSample(channel);
+    const double bandPassGain = std::norm(bandPass1.getResponse(frequency));
+    const double lowPassGain = std::norm(inPhaseLowPass.getResponse(frequency - oscillatorIncrement));
+    return 2.0 * (i * i + q * q) / (bandPassGain * bandPassGain * lowPassGain);
+}
+
+
+double OpenEphysBandEstimator::getFrequency(std::size_t channel) const {
+    return getFrequencyPerSample(channel) * sampleRate / (2.0 * M_PI);
+}
+
+
+END_NAMESPACE_MW
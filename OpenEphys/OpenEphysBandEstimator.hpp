@@ -0,0 +1,99 @@
+//
+//  OpenEphysBandEstimator.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysBandEstimator_hpp
+#define OpenEphysBandEstimator_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Second-order IIR filter section (transposed direct form II) applied independently to each channel
+// of interleaved frames
+//
+class OpenEphysBiquad {
+    
+public:
+    static OpenEphysBiquad lowPass(double sampleRate, double cutoff, double q);
+    static OpenEphysBiquad bandPass(double sampleRate, double center, double q);
+    
+    // One of two identical sections whose cascade passes the given band (edges at -3 dB, approximately)
+    static OpenEphysBiquad cascadedBandPass(double sampleRate, double lowFrequency, double highFrequency);
+    
+    // Complex frequency response at the given frequency (in radians per sample)
+    std::complex<double> getResponse(double frequency) const;
+    
+    void setNumChannels(std::size_t numChannels);
+    void reset();
+    
+    // Filters the frames in place
+    void process(float *frames, std::size_t numFrames);
+    
+private:
+    OpenEphysBiquad(double b0, double b1, double b2, double a0, double a1, double a2);
+    
+    float b0, b1, b2, a1, a2;
+    std::size_t numChannels;
+    std::vector<float> state1, state2;
+    
+};
+
+
+//
+// Streaming estimate of the instantaneous phase and power of each channel within a frequency band.
+// The signal is band-pass filtered and then demodulated at the band's center frequency: multiplying by
+// a complex oscillator and low-pass filtering yields the complex envelope, whose angle (plus the
+// oscillator phase) is the signal phase, and whose magnitude gives the power.  Unlike a Hilbert
+// transformer, this needs no look-ahead.  The filters shift the phase (and reduce the gain) of
+// off-center frequencies, so each channel's instantaneous frequency is tracked from the rotation of its
+// envelope, and the filters' response at that frequency is removed from the estimates.
+//
+// All per-sample work runs across channels of interleaved frames.  Phase and power are computed (with
+// the corresponding trigonometric functions) only when requested.
+//
+class OpenEphysBandEstimator : boost::noncopyable {
+    
+public:
+    OpenEphysBandEstimator(std::size_t numChannels, double sampleRate, double lowFrequency, double highFrequency);
+    
+    std::size_t getNumChannels() const { return numChannels; }
+    
+    void reset();
+    void process(const float *frames, std::size_t numFrames);
+    
+    // Estimates as of the most recent frame.  Phase is in radians, in [-pi, pi], with zero at the peak
+    // of the oscillation.  Power is the mean square of the band-limited signal.
+    double getPhase(std::size_t channel) const;
+    double getPower(std::size_t channel) const;
+    double getFrequency(std::size_t channel) const;  // Hz
+    
+private:
+    double getFrequencyPerSample(std::size_t channel) const;
+    
+    const std::size_t numChannels;
+    const double sampleRate;
+    const double lowFrequency, highFrequency;
+    const double oscillatorIncrement;  // Radians per sample
+    const float rotationSmoothing;
+    
+    OpenEphysBiquad bandPass1, bandPass2;
+    OpenEphysBiquad inPhaseLowPass, quadratureLowPass;
+    
+    double oscillatorPhase;
+    std::vector<float> bandSignal, inPhase, quadrature;
+    std::vector<float> rotationReal, rotationImag;  // Smoothed product of successive envelopes
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysBandEstimator_hpp */
@@ -40,6 +40,25 @@ void * OpenEphysBase::getZMQContext() {
 }
 
 
+std::vector<std::uint8_t> OpenEphysBase::parseSyncChannels(const std::string &expr) {
+    std::vector<std::uint8_t> syncChannels;
+    std::vector<Datum> syncChannelsValues;
+    ParsedExpressionVariable::evaluateExpressionList(expr, syncChannelsValues);
+    for (auto &channel : syncChannelsValues) {
+        auto channelNumber = channel.getInteger();
+        // Open Ephys reports TTL states as a 64-bit word
+        if (channelNumber < 1 || channelNumber > 64) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid sync channel number");
+        }
+        syncChannels.push_back(channelNumber - 1);
+    }
+    if (syncChannels.empty()) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "At least one sync channel is required");
+    }
+    return syncChannels;
+}
+
+
 END_NAMESPACE_MW
 
 
@@ -25,6 +25,7 @@ public:
     
 protected:
     static void * getZMQContext();
+    static std::vector<std::uint8_t> parseSyncChannels(const std::string &expr);
     static void logZMQError(const std::string &message) {
         merror(M_IODEVICE_MESSAGE_DOMAIN, "%s: %s", message.c_str(), zmq_strerror(zmq_errno()));
     }
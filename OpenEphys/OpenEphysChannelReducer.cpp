@@ -0,0 +1,166 @@
+//
+//  OpenEphysChannelReducer.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysChannelReducer.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+// Half of a typical 32 KB L1 data cache, leaving room for the output
+constexpr std::size_t blockBytes = 16 * 1024;
+
+
+inline std::size_t getGroupSize(std::size_t groupSize, std::size_t numChannels) {
+    return ((groupSize == 0 || groupSize > numChannels) ? numChannels : groupSize);
+}
+
+
+// Sums contiguous values with independent partial sums, since the compiler won't reorder a single
+// floating-point accumulation to vectorize it
+inline float sum(const float *x, std::size_t n) {
+    constexpr std::size_t numLanes = 8;
+    float partial[numLanes] = {};
+    std::size_t i = 0;
+    for (; i + numLanes <= n; i += numLanes) {
+        for (std::size_t lane = 0; lane < numLanes; lane++) {
+            partial[lane] += x[i + lane];
+        }
+    }
+    float total = 0.0f;
+    for (; i < n; i++) {
+        total += x[i];
+    }
+    for (std::size_t lane = 0; lane < numLanes; lane++) {
+        total += partial[lane];
+    }
+    return total;
+}
+
+
+END_NAMESPACE()
+
+
+auto OpenEphysChannelReducer::parseReference(const std::string &name) -> Reference {
+    if (name == "none") {
+        return Reference::None;
+    } else if (name == "average") {
+        return Reference::Average;
+    } else if (name == "median") {
+        return Reference::Median;
+    }
+    throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid reference (must be none, average, or median)", name);
+}
+
+
+OpenEphysChannelReducer::OpenEphysChannelReducer(std::size_t numChannels,
+                                                 Reference reference,
+                                                 std::size_t referenceGroupSize,
+                                                 std::size_t averageGroupSize) :
+    numChannels(numChannels),
+    reference(reference),
+    referenceGroupSize(getGroupSize(referenceGroupSize, numChannels)),
+    averageGroupSize(getGroupSize(averageGroupSize, numChannels)),
+    numOutputChannels((numChannels + this->averageGroupSize - 1) / std::max(std::size_t(1), this->averageGroupSize)),
+    blockSize(std::max(std::size_t(1), blockBytes / (sizeof(float) * std::max(std::size_t(1), numChannels))))
+{
+    if (numChannels < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Channel reducer requires at least one channel");
+    }
+}
+
+
+void OpenEphysChannelReducer::process(const float *input, std::size_t numFrames, std::vector<float> &output) {
+    output.resize(numFrames * numOutputChannels);
+    
+    for (std::size_t first = 0; first < numFrames; first += blockSize) {
+        const std::size_t blockFrames = std::min(blockSize, numFrames - first);
+        const float *in = input + first * numChannels;
+        float *out = output.data() + first * numOutputChannels;
+        
+        if (reference != Reference::None) {
+            block.assign(in, in + blockFrames * numChannels);
+            subtractReference(block.data(), blockFrames);
+            in = block.data();
+        }
+        
+        if (averageGroupSize == 1) {
+            std::copy(in, in + blockFrames * numChannels, out);
+            continue;
+        }
+        
+        // Only the last group can be smaller than the others
+        const std::size_t numFullGroups = numChannels / averageGroupSize;
+        const std::size_t lastGroupSize = numChannels - numFullGroups * averageGroupSize;
+        const float scale = 1.0f / float(averageGroupSize);
+        
+        for (std::size_t frame = 0; frame < blockFrames; frame++) {
+            const float *x = in + frame * numChannels;
+            float *y = out + frame * numOutputChannels;
+            
+            // Accumulate the groups' first channels, then their second channels, and so on, so that
+            // the inner loop runs across groups
+            for (std::size_t group = 0; group < numFullGroups; group++) {
+                y[group] = x[group * averageGroupSize];
+            }
+            for (std::size_t member = 1; member < averageGroupSize; member++) {
+                for (std::size_t group = 0; group < numFullGroups; group++) {
+                    y[group] += x[group * averageGroupSize + member];
+                }
+            }
+            for (std::size_t group = 0; group < numFullGroups; group++) {
+                y[group] *= scale;
+            }
+            
+            if (lastGroupSize > 0) {
+                y[numFullGroups] = sum(x + numFullGroups * averageGroupSize, lastGroupSize) / float(lastGroupSize);
+            }
+        }
+    }
+}
+
+
+void OpenEphysChannelReducer::subtractReference(float *frames, std::size_t numFrames) {
+    for (std::size_t start = 0; start < numChannels; start += referenceGroupSize) {
+        const std::size_t end = std::min(start + referenceGroupSize, numChannels);
+        const std::size_t groupSize = end - start;
+        
+        // Compute the reference for every frame in the block, then subtract it
+        scratch.resize(groupSize);
+        references.resize(numFrames);
+        for (std::size_t frame = 0; frame < numFrames; frame++) {
+            float *x = frames + frame * numChannels + start;
+            if (reference == Reference::Average) {
+                references[frame] = sum(x, groupSize) / float(groupSize);
+            } else {
+                std::copy(x, x + groupSize, scratch.begin());
+                auto middle = scratch.begin() + groupSize / 2;
+                std::nth_element(scratch.begin(), middle, scratch.begin() + groupSize);
+                float median = *middle;
+                if (groupSize % 2 == 0) {
+                    // Average the two middle values; the lower one is the largest below the midpoint
+                    median = (median + *std::max_element(scratch.begin(), middle)) / 2.0f;
+                }
+                references[frame] = median;
+            }
+        }
+        
+        for (std::size_t frame = 0; frame < numFrames; frame++) {
+            float *x = frames + frame * numChannels + start;
+            const float ref = references[frame];
+            for (std::size_t channel = 0; channel < groupSize; channel++) {
+                x[channel] -= ref;
+            }
+        }
+    }
+}
+
+
+END_NAMESPACE_MW
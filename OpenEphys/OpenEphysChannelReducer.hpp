@@ -0,0 +1,75 @@
+//
+//  OpenEphysChannelReducer.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysChannelReducer_hpp
+#define OpenEphysChannelReducer_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Re-references and reduces interleaved continuous frames:
+//
+//   1. Optionally, the average or median of each reference group (consecutive runs of channels, e.g.
+//      the channels of one shank) is subtracted from every channel in the group.
+//   2. Optionally, consecutive runs of channels are averaged into a single output channel.
+//
+// Frames are processed in blocks small enough to stay in the L1 cache, and each step runs over an
+// entire block before the next begins.  The average reference sums each group's contiguous channels.
+// Channel averaging instead accumulates every group's first channel, then every group's second
+// channel, and so on, so its inner loop runs across groups with a stride of the group size.  That
+// vectorizes across groups, and for small groups it is faster than summing each group separately.
+// The median isn't vectorized.
+//
+class OpenEphysChannelReducer : boost::noncopyable {
+    
+public:
+    enum class Reference { None, Average, Median };
+    
+    // Accepts "none", "average", or "median"
+    static Reference parseReference(const std::string &name);
+    
+    // A group size of zero means all channels
+    OpenEphysChannelReducer(std::size_t numChannels,
+                            Reference reference,
+                            std::size_t referenceGroupSize,
+                            std::size_t averageGroupSize);
+    
+    std::size_t getNumInputChannels() const { return numChannels; }
+    std::size_t getNumOutputChannels() const { return numOutputChannels; }
+    std::size_t getAverageGroupSize() const { return averageGroupSize; }
+    
+    // True if process would merely copy its input
+    bool isIdentity() const { return (reference == Reference::None && averageGroupSize == 1); }
+    
+    // Replaces the contents of output with the reduced frames
+    void process(const float *input, std::size_t numFrames, std::vector<float> &output);
+    
+private:
+    void subtractReference(float *frames, std::size_t numFrames);
+    
+    const std::size_t numChannels;
+    const Reference reference;
+    const std::size_t referenceGroupSize;
+    const std::size_t averageGroupSize;
+    const std::size_t numOutputChannels;
+    const std::size_t blockSize;  // Frames
+    
+    std::vector<float> block;
+    std::vector<float> references;  // Per frame of the block
+    std::vector<float> scratch;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysChannelReducer_hpp */
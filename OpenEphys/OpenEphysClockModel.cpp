@@ -0,0 +1,318 @@
+//
+//  OpenEphysClockModel.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysClockModel.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+constexpr std::size_t maxSyncMatches = 32;
+constexpr double singleMatchUncertainty = 1000.0;  // us
+constexpr double defaultDriftUncertainty = 50e-6;  // 50 ppm, typical of uncompensated crystals
+constexpr double provisionalRejectionThreshold = 3.0;  // In units of provisional uncertainty
+constexpr double matchRejectionThreshold = 5.0;  // In units of expected residual spread
+constexpr double minMatchRejectionThreshold = 1000.0;  // us
+constexpr std::size_t maxConsecutiveRejections = 8;
+constexpr std::size_t minLockedMatches = 3;
+constexpr MWTime defaultHoldoverTimeout = 5000000;  // 5 seconds
+
+
+END_NAMESPACE()
+
+
+const char * OpenEphysClockModel::getLockStateName(LockState state) {
+    switch (state) {
+        case LockState::Unlocked:
+            return "unlocked";
+        case LockState::Acquiring:
+            return "acquiring";
+        case LockState::Locked:
+            return "locked";
+        case LockState::Holdover:
+            return "holdover";
+    }
+    return "unlocked";
+}
+
+
+OpenEphysClockModel::OpenEphysClockModel() :
+    holdoverTimeout(defaultHoldoverTimeout)
+{
+    reset();
+}
+
+
+void OpenEphysClockModel::reset() {
+    matches.clear();
+    rejectedMatches.clear();
+    numRejectedMatches = 0;
+    valid = false;
+    provisional = false;
+    referenceTime = 0;
+    offset = 0.0;
+    drift = 0.0;
+    offsetUncertainty = std::numeric_limits<double>::infinity();
+    driftUncertainty = defaultDriftUncertainty;
+    residualSpread = singleMatchUncertainty;
+    lastMatchTime = 0;
+}
+
+
+bool OpenEphysClockModel::addSyncMatch(MWTime oeTime, MWTime mwTime) {
+    if (!provisional && matches.size() >= minLockedMatches && !checkResidual(oeTime, mwTime)) {
+        rejectedMatches.push_back({oeTime, mwTime});
+        numRejectedMatches++;
+        if (rejectedMatches.size() < maxConsecutiveRejections) {
+            return false;
+        }
+        mwarning(M_IODEVICE_MESSAGE_DOMAIN,
+                 "Last %lu Open Ephys clock sync matches disagree with the clock model; refitting the model to them",
+                 (unsigned long)rejectedMatches.size());
+        matches.swap(rejectedMatches);
+        rejectedMatches.clear();
+        lastMatchTime = mwTime;
+        fit();
+        return true;
+    }
+    rejectedMatches.clear();
+    
+    if (provisional) {
+        const double residual = double(mwTime - oeTime) - getOffset(oeTime);
+        const double threshold = provisionalRejectionThreshold * getUncertainty(oeTime);
+        if (std::fabs(residual) > threshold) {
+            mwarning(M_IODEVICE_MESSAGE_DOMAIN,
+                     "Saved Open Ephys clock model is off by %g ms (expected at most %g ms); discarding it",
+                     residual / 1e3,
+                     threshold / 1e3);
+            drift = 0.0;
+        }
+        // Otherwise, retain the saved drift as a prior until we have enough matches to fit our own
+        provisional = false;
+    }
+    
+    matches.push_back({oeTime, mwTime});
+    while (matches.size() > maxSyncMatches) {
+        matches.pop_front();
+    }
+    
+    lastMatchTime = mwTime;
+    
+    fit();
+    valid = true;
+    return true;
+}
+
+
+double OpenEphysClockModel::getOffset(MWTime oeTime) const {
+    if (!valid) {
+        return 0.0;
+    }
+    return offset + drift * double(oeTime - referenceTime);
+}
+
+
+double OpenEphysClockModel::getUncertainty(MWTime oeTime) const {
+    if (!valid) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return offsetUncertainty + driftUncertainty * std::fabs(double(oeTime - referenceTime));
+}
+
+
+OpenEphysClockModel::LockState OpenEphysClockModel::getLockState(MWTime mwNow) const {
+    if (!valid) {
+        return LockState::Unlocked;
+    }
+    if (provisional || matches.size() < minLockedMatches) {
+        return LockState::Acquiring;
+    }
+    if (getSyncAge(mwNow) > holdoverTimeout) {
+        return LockState::Holdover;
+    }
+    return LockState::Locked;
+}
+
+
+double OpenEphysClockModel::getCurrentUncertainty(MWTime mwNow) const {
+    if (!valid) {
+        return std::numeric_limits<double>::infinity();
+    }
+    // Invert the model to find the current Open Ephys time
+    const double oeNow = double(referenceTime) + (double(mwNow - referenceTime) - offset) / (1.0 + drift);
+    return getUncertainty(MWTime(oeNow));
+}
+
+
+bool OpenEphysClockModel::checkResidual(MWTime oeTime, MWTime mwTime) const {
+    const double residual = double(mwTime - oeTime) - getOffset(oeTime);
+    // A valid match deviates from the fit by the scatter of the matches, plus the fit's own uncertainty
+    const double uncertainty = getUncertainty(oeTime);
+    const double threshold = std::max(minMatchRejectionThreshold,
+                                      matchRejectionThreshold * std::sqrt(residualSpread * residualSpread +
+                                                                          uncertainty * uncertainty));
+    if (std::fabs(residual) <= threshold) {
+        return true;
+    }
+    if (rejectedMatches.empty()) {
+        mwarning(M_IODEVICE_MESSAGE_DOMAIN,
+                 "Open Ephys clock sync match is off by %g ms from the clock model (expected at most %g ms); "
+                 "ignoring it",
+                 residual / 1e3,
+                 threshold / 1e3);
+    }
+    return false;
+}
+
+
+void OpenEphysClockModel::fit() {
+    const std::size_t n = matches.size();
+    referenceTime = matches.back().oeTime;
+    
+    double meanX = 0.0, meanY = 0.0;
+    for (auto &match : matches) {
+        meanX += double(match.oeTime - referenceTime);
+        meanY += double(match.mwTime - match.oeTime);
+    }
+    meanX /= double(n);
+    meanY /= double(n);
+    
+    double sxx = 0.0, sxy = 0.0;
+    for (auto &match : matches) {
+        const double dx = double(match.oeTime - referenceTime) - meanX;
+        sxx += dx * dx;
+        sxy += dx * (double(match.mwTime - match.oeTime) - meanY);
+    }
+    
+    if (n < 2 || sxx <= 0.0) {
+        // Not enough information to estimate drift, so keep the current (or prior) value
+        offset = meanY - drift * meanX;
+        offsetUncertainty = singleMatchUncertainty;
+        driftUncertainty = defaultDriftUncertainty;
+        residualSpread = singleMatchUncertainty;
+        return;
+    }
+    
+    drift = sxy / sxx;
+    offset = meanY - drift * meanX;
+    
+    double sigma = singleMatchUncertainty;
+    if (n > 2) {
+        double ssr = 0.0;
+        for (auto &match : matches) {
+            const double x = double(match.oeTime - referenceTime);
+            const double residual = double(match.mwTime - match.oeTime) - (offset + drift * x);
+            ssr += residual * residual;
+        }
+        sigma = std::sqrt(ssr / double(n - 2));
+    }
+    residualSpread = sigma;
+    offsetUncertainty = sigma * std::sqrt(1.0 / double(n) + meanX * meanX / sxx);
+    driftUncertainty = sigma / std::sqrt(sxx);
+}
+
+
+bool OpenEphysClockModel::save(const std::string &path, const std::string &key) const {
+    if (!valid || provisional) {
+        return false;
+    }
+    
+    // Preserve models saved by other interfaces (i.e. for other endpoints) in the same file
+    std::vector<std::string> lines;
+    {
+        std::ifstream input(path);
+        std::string line;
+        while (std::getline(input, line)) {
+            std::istringstream fields(line);
+            std::string lineKey;
+            if ((fields >> lineKey) && lineKey != key) {
+                lines.push_back(line);
+            }
+        }
+    }
+    
+    std::ostringstream entry;
+    entry.precision(17);
+    entry << key << ' '
+          << referenceTime << ' '
+          << offset << ' '
+          << drift << ' '
+          << offsetUncertainty << ' '
+          << driftUncertainty << ' '
+          << lastMatchTime;
+    lines.push_back(entry.str());
+    
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream output(tempPath, std::ios::trunc);
+        for (auto &line : lines) {
+            output << line << '\n';
+        }
+        if (!output) {
+            merror(M_IODEVICE_MESSAGE_DOMAIN, "Unable to write Open Ephys clock model to %s", tempPath.c_str());
+            return false;
+        }
+    }
+    if (0 != std::rename(tempPath.c_str(), path.c_str())) {
+        merror(M_IODEVICE_MESSAGE_DOMAIN,
+               "Unable to save Open Ephys clock model to %s: %s",
+               path.c_str(),
+               std::strerror(errno));
+        return false;
+    }
+    
+    return true;
+}
+
+
+bool OpenEphysClockModel::load(const std::string &path, const std::string &key, MWTime mwNow) {
+    std::ifstream input(path);
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream fields(line);
+        std::string lineKey;
+        MWTime savedReferenceTime, savedLastMatchTime;
+        double savedOffset, savedDrift, savedOffsetUncertainty, savedDriftUncertainty;
+        if (!(fields >> lineKey) || lineKey != key) {
+            continue;
+        }
+        if (!(fields >> savedReferenceTime
+                     >> savedOffset
+                     >> savedDrift
+                     >> savedOffsetUncertainty
+                     >> savedDriftUncertainty
+                     >> savedLastMatchTime))
+        {
+            merror(M_IODEVICE_MESSAGE_DOMAIN, "Saved Open Ephys clock model for %s is malformed", key.c_str());
+            return false;
+        }
+        if (savedLastMatchTime > mwNow) {
+            // The MWorks clock has been reset since the model was saved
+            return false;
+        }
+        
+        reset();
+        valid = true;
+        provisional = true;
+        referenceTime = savedReferenceTime;
+        offset = savedOffset;
+        drift = savedDrift;
+        offsetUncertainty = savedOffsetUncertainty;
+        // Drift can change between runs (e.g. with temperature), so don't trust it more than usual
+        driftUncertainty = std::max(savedDriftUncertainty, defaultDriftUncertainty);
+        lastMatchTime = savedLastMatchTime;
+        return true;
+    }
+    
+    return false;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,100 @@
+//
+//  OpenEphysClockModel.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysClockModel_hpp
+#define OpenEphysClockModel_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Linear model of the MWorks clock as a function of the Open Ephys clock (both in microseconds),
+// fit by least squares to the most recent sync matches.  The model can be saved at the end of a
+// run and restored at the start of the next one as a provisional estimate, whose uncertainty grows
+// with the time elapsed since it was saved.
+//
+// The model also tracks its own quality: a lock state, the uncertainty (in microseconds) of converted
+// times, and the age of the most recent sync match.
+//
+// Once the model has been fit, each new sync match is checked against it, and a match whose residual
+// is far outside the expected spread (e.g. one made to the wrong sync word) is rejected rather than
+// added to the fit.  If several consecutive matches are rejected, the clocks have presumably jumped
+// (e.g. because Open Ephys restarted acquisition), so the model is refit to the rejected matches.
+//
+class OpenEphysClockModel {
+    
+public:
+    enum class LockState {
+        Unlocked,   // No model
+        Acquiring,  // Provisional model, or too few matches for a reliable fit
+        Locked,     // Reliable fit, recently updated
+        Holdover    // Reliable fit, but no recent matches
+    };
+    
+    static const char * getLockStateName(LockState state);
+    
+    OpenEphysClockModel();
+    
+    void setHoldoverTimeout(MWTime timeout) { holdoverTimeout = timeout; }
+    
+    void reset();
+    
+    bool isValid() const { return valid; }
+    bool isProvisional() const { return provisional; }
+    std::size_t getNumMatches() const { return matches.size(); }
+    MWTime getReferenceTime() const { return referenceTime; }
+    double getDrift() const { return drift; }
+    
+    // Returns false if the match was rejected
+    bool addSyncMatch(MWTime oeTime, MWTime mwTime);
+    std::size_t getNumRejectedMatches() const { return numRejectedMatches; }
+    
+    double getOffset(MWTime oeTime) const;
+    MWTime convert(MWTime oeTime) const { return oeTime + MWTime(std::llround(getOffset(oeTime))); }
+    double getUncertainty(MWTime oeTime) const;
+    
+    LockState getLockState(MWTime mwNow) const;
+    double getCurrentUncertainty(MWTime mwNow) const;
+    MWTime getSyncAge(MWTime mwNow) const { return (valid ? mwNow - lastMatchTime : -1); }
+    
+    bool save(const std::string &path, const std::string &key) const;
+    bool load(const std::string &path, const std::string &key, MWTime mwNow);
+    
+private:
+    struct SyncMatch {
+        MWTime oeTime;
+        MWTime mwTime;
+    };
+    
+    bool checkResidual(MWTime oeTime, MWTime mwTime) const;
+    void fit();
+    
+    std::deque<SyncMatch> matches;
+    std::deque<SyncMatch> rejectedMatches;  // Consecutive rejections only
+    std::size_t numRejectedMatches;
+    MWTime holdoverTimeout;
+    
+    bool valid;
+    bool provisional;
+    MWTime referenceTime;  // Open Ephys time at which offset is evaluated
+    double offset;
+    double drift;
+    double offsetUncertainty;
+    double driftUncertainty;
+    double residualSpread;  // Standard deviation of the fit's residuals
+    MWTime lastMatchTime;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysClockModel_hpp */
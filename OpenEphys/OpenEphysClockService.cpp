@@ -0,0 +1,152 @@
+//
+//  OpenEphysClockService.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysClockService.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+using ServiceRegistry = std::map<std::string, boost::weak_ptr<OpenEphysClockService>>;
+
+
+std::mutex& getRegistryMutex() {
+    static std::mutex registryMutex;
+    return registryMutex;
+}
+
+
+ServiceRegistry& getRegistry() {
+    static ServiceRegistry registry;
+    return registry;
+}
+
+
+END_NAMESPACE()
+
+
+boost::shared_ptr<OpenEphysClockService> OpenEphysClockService::lookup(const std::string &name) {
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    auto &registry = getRegistry();
+    auto iter = registry.find(name);
+    if (iter == registry.end()) {
+        return boost::shared_ptr<OpenEphysClockService>();
+    }
+    return iter->second.lock();
+}
+
+
+void OpenEphysClockService::registerService(const std::string &name,
+                                            const boost::shared_ptr<OpenEphysClockService> &service)
+{
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    auto &entry = getRegistry()[name];
+    if (entry.lock()) {
+        mwarning(M_IODEVICE_MESSAGE_DOMAIN,
+                 "Replacing existing Open Ephys clock service for %s",
+                 name.c_str());
+    }
+    entry = service;
+}
+
+
+void OpenEphysClockService::unregisterService(const std::string &name,
+                                              const boost::shared_ptr<OpenEphysClockService> &service)
+{
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    auto &registry = getRegistry();
+    auto iter = registry.find(name);
+    // Don't remove a service that replaced ours
+    if (iter != registry.end() && iter->second.lock() == service) {
+        registry.erase(iter);
+    }
+}
+
+
+OpenEphysClockService::OpenEphysClockService(double sampleRate) :
+    sampleRate(sampleRate),
+    sequence(0),
+    valid(false),
+    referenceTime(0),
+    offset(0.0),
+    drift(0.0)
+{ }
+
+
+bool OpenEphysClockService::convertSeconds(double oeTime, MWTime &mwTime) const {
+    const auto snapshot = read();
+    if (!snapshot.valid) {
+        return false;
+    }
+    const double oeTimeUS = oeTime * 1e6;
+    mwTime = MWTime(oeTimeUS + snapshot.offset + snapshot.drift * (oeTimeUS - double(snapshot.referenceTime)));
+    return true;
+}
+
+
+bool OpenEphysClockService::inverseConvertSeconds(MWTime mwTime, double &oeTime) const {
+    const auto snapshot = read();
+    if (!snapshot.valid) {
+        return false;
+    }
+    const double ref = double(snapshot.referenceTime);
+    oeTime = (ref + (double(mwTime) - ref - snapshot.offset) / (1.0 + snapshot.drift)) / 1e6;
+    return true;
+}
+
+
+bool OpenEphysClockService::convert(std::int64_t sampleNumber, MWTime &mwTime) const {
+    if (sampleRate <= 0.0) {
+        return false;
+    }
+    return convertSeconds(double(sampleNumber) / sampleRate, mwTime);
+}
+
+
+bool OpenEphysClockService::inverseConvert(MWTime mwTime, std::int64_t &sampleNumber) const {
+    double oeTime = 0.0;
+    if (sampleRate <= 0.0 || !inverseConvertSeconds(mwTime, oeTime)) {
+        return false;
+    }
+    sampleNumber = std::int64_t(std::llround(oeTime * sampleRate));
+    return true;
+}
+
+
+void OpenEphysClockService::update(const OpenEphysClockModel &model) {
+    const auto seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);  // Odd: update in progress
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    valid.store(model.isValid(), std::memory_order_relaxed);
+    referenceTime.store(model.getReferenceTime(), std::memory_order_relaxed);
+    offset.store(model.getOffset(model.getReferenceTime()), std::memory_order_relaxed);
+    drift.store(model.getDrift(), std::memory_order_relaxed);
+    
+    sequence.store(seq + 2, std::memory_order_release);
+}
+
+
+auto OpenEphysClockService::read() const -> Snapshot {
+    Snapshot snapshot;
+    std::uint32_t seq;
+    do {
+        seq = sequence.load(std::memory_order_acquire);
+        snapshot.valid = valid.load(std::memory_order_relaxed);
+        snapshot.referenceTime = referenceTime.load(std::memory_order_relaxed);
+        snapshot.offset = offset.load(std::memory_order_relaxed);
+        snapshot.drift = drift.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((seq & 1) || seq != sequence.load(std::memory_order_relaxed));
+    return snapshot;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,73 @@
+//
+//  OpenEphysClockService.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysClockService_hpp
+#define OpenEphysClockService_hpp
+
+#include "OpenEphysClockModel.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// In-process service for converting between Open Ephys and MWorks times.  Each Open Ephys interface
+// registers a service under its endpoint (e.g. "tcp://localhost:5557").  Conversions read a snapshot
+// of the interface's current clock model via a sequence lock, so they never block, never allocate,
+// and are safe to call from any thread.
+//
+// The registry lives in this plugin, so this class is for the plugin's own components.  Other plugins
+// can't link against it, and use the C interface in OpenEphysClockServiceAPI.h instead.
+//
+class OpenEphysClockService : boost::noncopyable {
+    
+public:
+    static boost::shared_ptr<OpenEphysClockService> lookup(const std::string &name);
+    static void registerService(const std::string &name, const boost::shared_ptr<OpenEphysClockService> &service);
+    static void unregisterService(const std::string &name, const boost::shared_ptr<OpenEphysClockService> &service);
+    
+    // A sample rate of zero disables the sample-number conversions
+    explicit OpenEphysClockService(double sampleRate = 0.0);
+    
+    double getSampleRate() const { return sampleRate; }
+    
+    // Open Ephys time in seconds <-> MWorks time
+    bool convertSeconds(double oeTime, MWTime &mwTime) const;
+    bool inverseConvertSeconds(MWTime mwTime, double &oeTime) const;
+    
+    // Open Ephys sample number <-> MWorks time
+    bool convert(std::int64_t sampleNumber, MWTime &mwTime) const;
+    bool inverseConvert(MWTime mwTime, std::int64_t &sampleNumber) const;
+    
+    // Must be called by only one thread at a time
+    void update(const OpenEphysClockModel &model);
+    
+private:
+    struct Snapshot {
+        bool valid;
+        MWTime referenceTime;
+        double offset;
+        double drift;
+    };
+    
+    Snapshot read() const;
+    
+    const double sampleRate;
+    
+    std::atomic<std::uint32_t> sequence;
+    std::atomic<bool> valid;
+    std::atomic<MWTime> referenceTime;
+    std::atomic<double> offset;
+    std::atomic<double> drift;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysClockService_hpp */
@@ -0,0 +1,98 @@
+//
+//  OpenEphysClockServiceAPI.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysClockService.hpp"
+#include "OpenEphysClockServiceAPI.h"
+
+
+// The API's opaque service type holds a reference to the C++ service
+struct OpenEphysClockServiceHandle {
+    boost::shared_ptr<mw::OpenEphysClockService> service;
+};
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+OpenEphysClockServiceRef lookupService(const char *name) {
+    auto service = OpenEphysClockService::lookup(name);
+    if (!service) {
+        return nullptr;
+    }
+    return new OpenEphysClockServiceHandle { std::move(service) };
+}
+
+
+void releaseService(OpenEphysClockServiceRef service) {
+    delete service;
+}
+
+
+double getSampleRate(OpenEphysClockServiceRef service) {
+    return service->service->getSampleRate();
+}
+
+
+bool convertSeconds(OpenEphysClockServiceRef service, double oeTime, std::int64_t *mwTime) {
+    MWTime result;
+    if (!service->service->convertSeconds(oeTime, result)) {
+        return false;
+    }
+    *mwTime = result;
+    return true;
+}
+
+
+bool inverseConvertSeconds(OpenEphysClockServiceRef service, std::int64_t mwTime, double *oeTime) {
+    return service->service->inverseConvertSeconds(mwTime, *oeTime);
+}
+
+
+bool convert(OpenEphysClockServiceRef service, std::int64_t sampleNumber, std::int64_t *mwTime) {
+    MWTime result;
+    if (!service->service->convert(sampleNumber, result)) {
+        return false;
+    }
+    *mwTime = result;
+    return true;
+}
+
+
+bool inverseConvert(OpenEphysClockServiceRef service, std::int64_t mwTime, std::int64_t *sampleNumber) {
+    std::int64_t result;
+    if (!service->service->inverseConvert(mwTime, result)) {
+        return false;
+    }
+    *sampleNumber = result;
+    return true;
+}
+
+
+const OpenEphysClockServiceAPI clockServiceAPI {
+    OPENEPHYS_CLOCK_SERVICE_API_VERSION,
+    lookupService,
+    releaseService,
+    getSampleRate,
+    convertSeconds,
+    inverseConvertSeconds,
+    convert,
+    inverseConvert
+};
+
+
+END_NAMESPACE()
+
+
+END_NAMESPACE_MW
+
+
+__attribute__((visibility("default"))) const OpenEphysClockServiceAPI * OpenEphysGetClockServiceAPI() {
+    return &mw::clockServiceAPI;
+}
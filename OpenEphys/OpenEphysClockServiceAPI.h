@@ -0,0 +1,108 @@
+//
+//  OpenEphysClockServiceAPI.h
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysClockServiceAPI_h
+#define OpenEphysClockServiceAPI_h
+
+//
+// C interface to the Open Ephys clock conversion service, for use by other MWorks plugins.  This
+// header is self-contained: copy it into the other plugin's sources.  That plugin doesn't link
+// against the Open Ephys plugin; instead, OpenEphysFindClockServiceAPI looks up the entry point that
+// the Open Ephys plugin exports, at run time.
+//
+// Each Open Ephys interface registers a service under its endpoint (e.g. "tcp://localhost:5557") when
+// it's initialized, so look up services no earlier than the other component's own initialization.
+// The conversion functions never block and never allocate, and may be called from any thread.  Times
+// on the MWorks clock are in microseconds.
+//
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__APPLE__)
+#  include <CoreFoundation/CoreFoundation.h>
+#else
+#  include <dlfcn.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define OPENEPHYS_CLOCK_SERVICE_API_VERSION 1
+#define OPENEPHYS_CLOCK_SERVICE_API_ENTRY_POINT "OpenEphysGetClockServiceAPI"
+#define OPENEPHYS_PLUGIN_BUNDLE_IDENTIFIER "org.mworks-project.OpenEphys"
+
+
+typedef struct OpenEphysClockServiceHandle *OpenEphysClockServiceRef;
+
+
+typedef struct {
+    uint32_t version;
+    
+    // Returns NULL if no service is registered under name.  The caller must release the returned
+    // service, which remains usable (though it stops updating) after its interface is destroyed.
+    OpenEphysClockServiceRef (*lookupService)(const char *name);
+    void (*releaseService)(OpenEphysClockServiceRef service);
+    
+    // Zero if the service doesn't convert sample numbers
+    double (*getSampleRate)(OpenEphysClockServiceRef service);
+    
+    // The conversions return false if the service's clock model isn't valid yet
+    
+    // Open Ephys time in seconds <-> MWorks time
+    bool (*convertSeconds)(OpenEphysClockServiceRef service, double oeTime, int64_t *mwTime);
+    bool (*inverseConvertSeconds)(OpenEphysClockServiceRef service, int64_t mwTime, double *oeTime);
+    
+    // Open Ephys sample number <-> MWorks time
+    bool (*convert)(OpenEphysClockServiceRef service, int64_t sampleNumber, int64_t *mwTime);
+    bool (*inverseConvert)(OpenEphysClockServiceRef service, int64_t mwTime, int64_t *sampleNumber);
+} OpenEphysClockServiceAPI;
+
+
+// Exported by the Open Ephys plugin.  Other plugins call OpenEphysFindClockServiceAPI instead of
+// linking against it.
+const OpenEphysClockServiceAPI * OpenEphysGetClockServiceAPI(void);
+typedef const OpenEphysClockServiceAPI * (*OpenEphysGetClockServiceAPIFunction)(void);
+
+
+// Returns NULL if the Open Ephys plugin isn't loaded, or is too old to provide this version of the API
+static inline const OpenEphysClockServiceAPI * OpenEphysFindClockServiceAPI(void) {
+    OpenEphysGetClockServiceAPIFunction getAPI = NULL;
+    
+#if defined(__APPLE__)
+    // MWorks loads each plugin as a bundle, and finds its entry points the same way
+    CFBundleRef bundle = CFBundleGetBundleWithIdentifier(CFSTR(OPENEPHYS_PLUGIN_BUNDLE_IDENTIFIER));
+    if (bundle) {
+        getAPI = (OpenEphysGetClockServiceAPIFunction)CFBundleGetFunctionPointerForName(bundle, CFSTR(OPENEPHYS_CLOCK_SERVICE_API_ENTRY_POINT));
+    }
+#else
+    void *process = dlopen(NULL, RTLD_LAZY);
+    if (process) {
+        getAPI = (OpenEphysGetClockServiceAPIFunction)dlsym(process, OPENEPHYS_CLOCK_SERVICE_API_ENTRY_POINT);
+        dlclose(process);
+    }
+#endif
+    
+    if (!getAPI) {
+        return NULL;
+    }
+    const OpenEphysClockServiceAPI *api = getAPI();
+    if (!api || api->version < OPENEPHYS_CLOCK_SERVICE_API_VERSION) {
+        return NULL;
+    }
+    return api;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OpenEphysClockServiceAPI_h */
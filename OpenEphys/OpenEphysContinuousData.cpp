@@ -0,0 +1,95 @@
+//
+//  OpenEphysContinuousData.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysContinuousData.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+//
+// The header is small and flat, with unique key names, so rather than parse the JSON fully, we just
+// find each key and read the number that follows it
+//
+bool findNumber(const std::string &json, const char *key, double &value) {
+    const std::string quotedKey = std::string("\"") + key + "\"";
+    auto pos = json.find(quotedKey);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    pos = json.find_first_not_of(" \t\r\n", pos + quotedKey.size());
+    if (pos == std::string::npos || json[pos] != ':') {
+        return false;
+    }
+    
+    const char *start = json.c_str() + pos + 1;
+    char *end = nullptr;
+    value = std::strtod(start, &end);
+    return (end != start && std::isfinite(value));
+}
+
+
+END_NAMESPACE()
+
+
+bool OpenEphysContinuousHeader::parse(const char *json, std::size_t size) {
+    const std::string text(json, size);
+    double channels = 0.0, samples = 0.0, rate = 0.0, timestamp = 0.0, bytes = 0.0;
+    if (!findNumber(text, "n_channels", channels) ||
+        !findNumber(text, "n_samples", samples) ||
+        !findNumber(text, "sample_rate", rate) ||
+        !findNumber(text, "timestamp", timestamp) ||
+        channels < 1.0 ||
+        samples < 0.0 ||
+        rate <= 0.0)
+    {
+        return false;
+    }
+    
+    numChannels = std::size_t(channels);
+    numSamples = std::size_t(samples);
+    sampleRate = rate;
+    firstSampleNumber = std::int64_t(timestamp);
+    
+    // Older versions of the module omit the data size, so derive it if necessary
+    if (findNumber(text, "data_size", bytes) && bytes >= 0.0) {
+        dataSize = std::size_t(bytes);
+    } else {
+        dataSize = numChannels * numSamples * sizeof(float);
+    }
+    
+    return true;
+}
+
+
+void gatherContinuousChannels(const float *data,
+                              std::size_t numSamples,
+                              const std::vector<std::size_t> &channels,
+                              std::vector<float> &frames)
+{
+    const std::size_t numChannels = channels.size();
+    frames.resize(numSamples * numChannels);
+    
+    // Transpose in blocks of samples, so that the frames being written stay in cache while every
+    // channel is copied into them
+    constexpr std::size_t blockSize = 32;
+    for (std::size_t first = 0; first < numSamples; first += blockSize) {
+        const std::size_t last = std::min(first + blockSize, numSamples);
+        for (std::size_t i = 0; i < numChannels; i++) {
+            const float *source = data + channels[i] * numSamples;
+            for (std::size_t sample = first; sample < last; sample++) {
+                frames[sample * numChannels + i] = source[sample];
+            }
+        }
+    }
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,53 @@
+//
+//  OpenEphysContinuousData.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysContinuousData_hpp
+#define OpenEphysContinuousData_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Continuous data published by the Open Ephys ZMQ Interface module.  Each message has three parts:
+// the envelope "DATA", a JSON header, and the samples as 32-bit floats in channel-major order (all
+// samples of the first channel, then all samples of the second, and so on).  The header looks like
+//
+//   {"message_num": 17, "type": "data", "data_size": 49152,
+//    "content": {"n_channels": 384, "n_samples": 32, "n_real_samples": 32,
+//                "sample_rate": 30000, "timestamp": 1234567}}
+//
+// where "timestamp" is the sample number of the first sample in the message.
+//
+struct OpenEphysContinuousHeader {
+    std::size_t numChannels;
+    std::size_t numSamples;
+    double sampleRate;
+    std::int64_t firstSampleNumber;
+    std::size_t dataSize;
+    
+    // Returns false if a required field is missing or invalid
+    bool parse(const char *json, std::size_t size);
+};
+
+
+//
+// Copies the selected (zero-based) channels from channel-major message data into interleaved frames,
+// replacing the contents of frames
+//
+void gatherContinuousChannels(const float *data,
+                              std::size_t numSamples,
+                              const std::vector<std::size_t> &channels,
+                              std::vector<float> &frames);
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysContinuousData_hpp */
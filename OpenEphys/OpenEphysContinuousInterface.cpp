@@ -0,0 +1,648 @@
+//
+//  OpenEphysContinuousInterface.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysContinuousInterface.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+inline MWTime currentTimeUS() {
+    return Clock::instance()->getCurrentTimeUS();
+}
+
+
+// RAII wrapper for a ZeroMQ message part
+class ZMQMessage : boost::noncopyable {
+public:
+    ZMQMessage() { zmq_msg_init(&msg); }
+    ~ZMQMessage() { zmq_msg_close(&msg); }
+    
+    bool receive(void *socket, int flags) { return (-1 != zmq_msg_recv(&msg, socket, flags)); }
+    bool hasMore() { return zmq_msg_more(&msg); }
+    const char * data() { return static_cast<const char *>(zmq_msg_data(&msg)); }
+    std::size_t size() { return zmq_msg_size(&msg); }
+    
+private:
+    zmq_msg_t msg;
+};
+
+
+const std::string dataEnvelope("DATA");
+
+
+std::vector<std::size_t> parseChannels(const std::string &expr) {
+    std::vector<Datum> values;
+    ParsedExpressionVariable::evaluateExpressionList(expr, values);
+    
+    std::vector<std::size_t> channels;
+    for (auto &value : values) {
+        auto channelNumber = value.getInteger();
+        if (channelNumber < 1) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid continuous channel number");
+        }
+        channels.push_back(channelNumber - 1);
+    }
+    if (channels.empty()) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "At least one continuous channel is required");
+    }
+    
+    return channels;
+}
+
+
+std::size_t getDecimationFactor(const ParameterValue &value) {
+    const long factor(value);
+    if (factor < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decimation factor must be at least 1");
+    }
+    return std::size_t(factor);
+}
+
+
+std::size_t getGroupSize(const ParameterValue &value) {
+    const long size(value);
+    if (size < 0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Channel group size must be non-negative");
+    }
+    return std::size_t(size);
+}
+
+
+std::size_t getRingCapacity(const ParameterValue &bufferDuration, double sampleRate, std::size_t decimationFactor) {
+    if (sampleRate <= 0.0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Sample rate must be greater than zero");
+    }
+    const double duration = double(MWTime(bufferDuration)) / 1e6;
+    if (duration <= 0.0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Buffer duration must be greater than zero");
+    }
+    return std::max(std::size_t(1), std::size_t(std::ceil(duration * sampleRate / double(decimationFactor))));
+}
+
+
+std::unique_ptr<OpenEphysBandEstimator> createBandEstimator(const ParameterValue &band,
+                                                            std::size_t numChannels,
+                                                            double sampleRate)
+{
+    if (band.empty()) {
+        return nullptr;
+    }
+    
+    std::vector<Datum> values;
+    ParsedExpressionVariable::evaluateExpressionList(band.str(), values);
+    if (values.size() != 2) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                              "Frequency band must contain exactly two values (low and high frequency)");
+    }
+    
+    return std::unique_ptr<OpenEphysBandEstimator>(new OpenEphysBandEstimator(numChannels,
+                                                                              sampleRate,
+                                                                              values[0].getFloat(),
+                                                                              values[1].getFloat()));
+}
+
+
+std::unique_ptr<OpenEphysEnvelopeDetector> createEnvelopeDetector(const ParameterValueMap &parameters,
+                                                                  std::size_t numChannels,
+                                                                  double sampleRate)
+{
+    if (parameters[OpenEphysContinuousInterface::DETECTION_BAND].empty()) {
+        return nullptr;
+    }
+    
+    std::vector<Datum> values;
+    ParsedExpressionVariable::evaluateExpressionList(parameters[OpenEphysContinuousInterface::DETECTION_BAND].str(),
+                                                     values);
+    if (values.size() != 2) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                              "Detection band must contain exactly two values (low and high frequency)");
+    }
+    
+    auto getSeconds = [&parameters](const std::string &name) {
+        return double(MWTime(parameters[name])) / 1e6;
+    };
+    
+    return std::unique_ptr<OpenEphysEnvelopeDetector>(
+        new OpenEphysEnvelopeDetector(numChannels,
+                                      sampleRate,
+                                      values[0].getFloat(),
+                                      values[1].getFloat(),
+                                      getSeconds(OpenEphysContinuousInterface::DETECTION_RMS_WINDOW),
+                                      getSeconds(OpenEphysContinuousInterface::DETECTION_BASELINE_WINDOW),
+                                      double(parameters[OpenEphysContinuousInterface::DETECTION_THRESHOLD]),
+                                      getSeconds(OpenEphysContinuousInterface::DETECTION_MIN_DURATION)));
+}
+
+
+END_NAMESPACE()
+
+
+const std::string OpenEphysContinuousInterface::CHANNELS("channels");
+const std::string OpenEphysContinuousInterface::SAMPLE_RATE("sample_rate");
+const std::string OpenEphysContinuousInterface::DECIMATION("decimation");
+const std::string OpenEphysContinuousInterface::BUFFER_DURATION("buffer_duration");
+const std::string OpenEphysContinuousInterface::CLOCK_SOURCE("clock_source");
+const std::string OpenEphysContinuousInterface::REFERENCE("reference");
+const std::string OpenEphysContinuousInterface::REFERENCE_GROUP_SIZE("reference_group_size");
+const std::string OpenEphysContinuousInterface::CHANNEL_GROUP_SIZE("channel_group_size");
+const std::string OpenEphysContinuousInterface::DATA_QUERY("data_query");
+const std::string OpenEphysContinuousInterface::DATA_QUERY_RESULT("data_query_result");
+const std::string OpenEphysContinuousInterface::BAND("band");
+const std::string OpenEphysContinuousInterface::BAND_PHASE("band_phase");
+const std::string OpenEphysContinuousInterface::BAND_POWER("band_power");
+const std::string OpenEphysContinuousInterface::BAND_LATENCY("band_latency");
+const std::string OpenEphysContinuousInterface::BAND_PUBLISH_INTERVAL("band_publish_interval");
+const std::string OpenEphysContinuousInterface::DETECTION_BAND("detection_band");
+const std::string OpenEphysContinuousInterface::DETECTION_THRESHOLD("detection_threshold");
+const std::string OpenEphysContinuousInterface::DETECTION_RMS_WINDOW("detection_rms_window");
+const std::string OpenEphysContinuousInterface::DETECTION_BASELINE_WINDOW("detection_baseline_window");
+const std::string OpenEphysContinuousInterface::DETECTION_MIN_DURATION("detection_min_duration");
+const std::string OpenEphysContinuousInterface::DETECTED_EVENT("detected_event");
+const std::string OpenEphysContinuousInterface::DETECTED_EVENT_END("detected_event_end");
+
+
+void OpenEphysContinuousInterface::describeComponent(ComponentInfo &info) {
+    OpenEphysBase::describeComponent(info);
+    
+    info.setSignature("iodevice/open_ephys_continuous_interface");
+    
+    info.addParameter(CHANNELS);
+    info.addParameter(SAMPLE_RATE, "30000");
+    info.addParameter(DECIMATION, "30");
+    info.addParameter(BUFFER_DURATION, "10s");
+    info.addParameter(CLOCK_SOURCE);
+    info.addParameter(REFERENCE, "none");
+    info.addParameter(REFERENCE_GROUP_SIZE, "0");
+    info.addParameter(CHANNEL_GROUP_SIZE, "1");
+    info.addParameter(DATA_QUERY, false);
+    info.addParameter(DATA_QUERY_RESULT, false);
+    info.addParameter(BAND, false);
+    info.addParameter(BAND_PHASE, false);
+    info.addParameter(BAND_POWER, false);
+    info.addParameter(BAND_LATENCY, false);
+    info.addParameter(BAND_PUBLISH_INTERVAL, "10ms");
+    info.addParameter(DETECTION_BAND, false);
+    info.addParameter(DETECTION_THRESHOLD, "5");
+    info.addParameter(DETECTION_RMS_WINDOW, "8ms");
+    info.addParameter(DETECTION_BASELINE_WINDOW, "10s");
+    info.addParameter(DETECTION_MIN_DURATION, "10ms");
+    info.addParameter(DETECTED_EVENT, false);
+    info.addParameter(DETECTED_EVENT_END, false);
+}
+
+
+OpenEphysContinuousInterface::OpenEphysContinuousInterface(const ParameterValueMap &parameters) :
+    OpenEphysBase(parameters),
+    channels(parseChannels(parameters[CHANNELS].str())),
+    sampleRate(parameters[SAMPLE_RATE]),
+    decimationFactor(getDecimationFactor(parameters[DECIMATION])),
+    clockSource(parameters[CLOCK_SOURCE].str()),
+    bandPublishInterval(parameters[BAND_PUBLISH_INTERVAL]),
+    channelReducer(channels.size(),
+                   OpenEphysChannelReducer::parseReference(parameters[REFERENCE].str()),
+                   getGroupSize(parameters[REFERENCE_GROUP_SIZE]),
+                   getGroupSize(parameters[CHANNEL_GROUP_SIZE])),
+    decimator(channelReducer.getNumOutputChannels(), decimationFactor),
+    nextSampleNumber(-1),
+    warnedUnsynchronized(false),
+    warnedInvalidData(false),
+    bandEstimator(createBandEstimator(parameters[BAND],
+                                      channelReducer.getNumOutputChannels(),
+                                      sampleRate / double(decimationFactor))),
+    lastBandPublishTime(-1),
+    envelopeDetector(createEnvelopeDetector(parameters,
+                                            channelReducer.getNumOutputChannels(),
+                                            sampleRate / double(decimationFactor))),
+    detectedEventStartTime(-1),
+    ring(channelReducer.getNumOutputChannels(), getRingCapacity(parameters[BUFFER_DURATION], sampleRate, decimationFactor)),
+    running(false)
+{
+    if (!parameters[DATA_QUERY].empty()) {
+        if (parameters[DATA_QUERY_RESULT].empty()) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                  "Data query result variable is required when data query is provided");
+        }
+        dataQuery = VariablePtr(parameters[DATA_QUERY]);
+        dataQueryResult = VariablePtr(parameters[DATA_QUERY_RESULT]);
+    }
+    
+    if (bandEstimator) {
+        if (parameters[BAND_PHASE].empty() && parameters[BAND_POWER].empty()) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                  "Band phase or band power variable is required when frequency band is provided");
+        }
+        if (bandPublishInterval < 0) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Band publish interval must be non-negative");
+        }
+        if (!parameters[BAND_PHASE].empty()) {
+            bandPhase = VariablePtr(parameters[BAND_PHASE]);
+        }
+        if (!parameters[BAND_POWER].empty()) {
+            bandPower = VariablePtr(parameters[BAND_POWER]);
+        }
+        if (!parameters[BAND_LATENCY].empty()) {
+            bandLatency = VariablePtr(parameters[BAND_LATENCY]);
+        }
+    }
+    
+    if (envelopeDetector) {
+        if (parameters[DETECTED_EVENT].empty()) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                  "Detected event variable is required when detection band is provided");
+        }
+        detectedEvent = VariablePtr(parameters[DETECTED_EVENT]);
+        if (!parameters[DETECTED_EVENT_END].empty()) {
+            detectedEventEnd = VariablePtr(parameters[DETECTED_EVENT_END]);
+        }
+    }
+}
+
+
+OpenEphysContinuousInterface::~OpenEphysContinuousInterface() {
+    terminateDataHandlerThread();
+}
+
+
+bool OpenEphysContinuousInterface::initialize() {
+    zmqSocket.reset(zmq_socket(getZMQContext(), ZMQ_SUB));
+    if (!zmqSocket) {
+        logZMQError("Unable to create ZeroMQ socket");
+        return false;
+    }
+    
+    const int recvTimeout = 500;  // ms
+    if (0 != zmq_setsockopt(zmqSocket.get(), ZMQ_RCVTIMEO, &recvTimeout, sizeof(recvTimeout))) {
+        logZMQError("Unable to set ZeroMQ socket receive timeout");
+        return false;
+    }
+    
+    if (0 != zmq_setsockopt(zmqSocket.get(), ZMQ_SUBSCRIBE, dataEnvelope.data(), dataEnvelope.size())) {
+        logZMQError("Unable to establish ZeroMQ message filter");
+        return false;
+    }
+    
+    if (dataQuery) {
+        boost::weak_ptr<OpenEphysContinuousInterface> weakThis(component_shared_from_this<OpenEphysContinuousInterface>());
+        auto queryNotification = [weakThis](const Datum &data, MWTime time) {
+            if (auto sharedThis = weakThis.lock()) {
+                sharedThis->handleDataQuery(data);
+            }
+        };
+        dataQuery->addNotification(boost::make_shared<VariableCallbackNotification>(queryNotification));
+    }
+    
+    return true;
+}
+
+
+bool OpenEphysContinuousInterface::startDeviceIO() {
+    scoped_lock lock(mutex);
+    
+    if (!running) {
+        if (0 != zmq_connect(zmqSocket.get(), endpoint.c_str())) {
+            logZMQError("Unable to connect to Open Ephys ZMQ interface");
+            return false;
+        }
+        
+        decimator.reset();
+        nextSampleNumber = -1;
+        warnedUnsynchronized = false;
+        warnedInvalidData = false;
+        if (bandEstimator) {
+            bandEstimator->reset();
+        }
+        lastBandPublishTime = -1;
+        if (envelopeDetector) {
+            envelopeDetector->reset();
+        }
+        detectedEventStartTime = -1;
+        
+        continueHandlingData.test_and_set();
+        dataHandlerThread = std::thread([this]() {
+            handleData();
+        });
+        
+        running = true;
+    }
+    
+    return true;
+}
+
+
+bool OpenEphysContinuousInterface::stopDeviceIO() {
+    scoped_lock lock(mutex);
+    
+    if (running) {
+        terminateDataHandlerThread();
+        
+        if (0 != zmq_disconnect(zmqSocket.get(), endpoint.c_str())) {
+            logZMQError("Unable to disconnect from Open Ephys ZMQ interface");
+            return false;
+        }
+        
+        running = false;
+    }
+    
+    return true;
+}
+
+
+void OpenEphysContinuousInterface::handleData() {
+    while (continueHandlingData.test_and_set()) {
+        ZMQMessage envelope;
+        if (!envelope.receive(zmqSocket.get(), 0)) {
+            if (zmq_errno() != EAGAIN) {
+                logZMQError("Received failed on ZeroMQ socket");
+            }
+            continue;
+        }
+        
+        // Multipart messages arrive atomically, so the remaining parts are already here
+        ZMQMessage header, data;
+        if (!envelope.hasMore() ||
+            !header.receive(zmqSocket.get(), ZMQ_DONTWAIT) ||
+            !header.hasMore() ||
+            !data.receive(zmqSocket.get(), ZMQ_DONTWAIT))
+        {
+            merror(M_IODEVICE_MESSAGE_DOMAIN, "Received incomplete continuous data message from Open Ephys");
+            continue;
+        }
+        while (data.hasMore()) {
+            // Discard any unexpected trailing parts
+            ZMQMessage extra;
+            if (!extra.receive(zmqSocket.get(), ZMQ_DONTWAIT) || !extra.hasMore()) {
+                break;
+            }
+        }
+        
+        OpenEphysContinuousHeader info;
+        if (!info.parse(header.data(), header.size()) ||
+            info.dataSize != info.numChannels * info.numSamples * sizeof(float) ||
+            data.size() < info.dataSize)
+        {
+            if (!warnedInvalidData) {
+                merror(M_IODEVICE_MESSAGE_DOMAIN, "Received invalid continuous data message from Open Ephys");
+                warnedInvalidData = true;
+            }
+            continue;
+        }
+        
+        processData(info, reinterpret_cast<const float *>(data.data()));
+    }
+}
+
+
+void OpenEphysContinuousInterface::terminateDataHandlerThread() {
+    if (dataHandlerThread.joinable()) {
+        continueHandlingData.clear();
+        dataHandlerThread.join();
+    }
+}
+
+
+void OpenEphysContinuousInterface::processData(const OpenEphysContinuousHeader &header, const float *data) {
+    if (header.sampleRate != sampleRate ||
+        *std::max_element(channels.begin(), channels.end()) >= header.numChannels)
+    {
+        if (!warnedInvalidData) {
+            merror(M_IODEVICE_MESSAGE_DOMAIN,
+                   "Open Ephys continuous data (%lu channels at %g Hz) does not match the configured channels "
+                   "and sample rate",
+                   (unsigned long)header.numChannels,
+                   header.sampleRate);
+            warnedInvalidData = true;
+        }
+        return;
+    }
+    
+    if (nextSampleNumber >= 0 && header.firstSampleNumber != nextSampleNumber) {
+        // Data were lost (or acquisition restarted), so the filter history no longer applies
+        mwarning(M_IODEVICE_MESSAGE_DOMAIN,
+                 "Gap in Open Ephys continuous data: expected sample %lld, received %lld",
+                 (long long)nextSampleNumber,
+                 (long long)header.firstSampleNumber);
+        decimator.reset();
+        if (bandEstimator) {
+            bandEstimator->reset();
+        }
+        if (envelopeDetector) {
+            envelopeDetector->reset();
+        }
+        detectedEventStartTime = -1;
+    }
+    nextSampleNumber = header.firstSampleNumber + std::int64_t(header.numSamples);
+    
+    gatherContinuousChannels(data, header.numSamples, channels, inputFrames);
+    
+    // Re-reference and reduce before decimating, so that the filter runs on fewer channels
+    const float *frames = inputFrames.data();
+    if (!channelReducer.isIdentity()) {
+        channelReducer.process(inputFrames.data(), header.numSamples, reducedFrames);
+        frames = reducedFrames.data();
+    }
+    
+    outputFrames.clear();
+    outputSampleNumbers.clear();
+    const std::size_t numOutputFrames = decimator.process(frames,
+                                                          header.numSamples,
+                                                          header.firstSampleNumber,
+                                                          outputFrames,
+                                                          outputSampleNumbers);
+    if (numOutputFrames == 0) {
+        return;
+    }
+    
+    // Run the band estimator and envelope detector even when the clock is unavailable, so that their
+    // filters stay continuous
+    if (bandEstimator) {
+        bandEstimator->process(outputFrames.data(), numOutputFrames);
+    }
+    const std::vector<OpenEphysEnvelopeDetector::Event> noEvents;
+    const auto &detectedEvents = (envelopeDetector ?
+                                  envelopeDetector->process(outputFrames.data(), numOutputFrames) :
+                                  noEvents);
+    
+    // Time each output frame at the center of its filter, so that the decimated signal lines up with
+    // the input in time
+    outputTimes.resize(numOutputFrames);
+    for (std::size_t i = 0; i < numOutputFrames; i++) {
+        if (!convertSampleNumber(double(outputSampleNumbers[i]) - decimator.getDelay(), outputTimes[i])) {
+            // Without a start time, the end of an ongoing event can't be reported
+            detectedEventStartTime = -1;
+            return;
+        }
+    }
+    
+    // A refit of the clock model can move converted times backwards.  The ring's time lookups assume
+    // that times never decrease, so hold any such frames at the last time written.
+    MWTime latestTime;
+    if (ring.getLatestTime(latestTime)) {
+        for (auto &time : outputTimes) {
+            time = latestTime = std::max(time, latestTime);
+        }
+    }
+    
+    ring.write(outputFrames.data(), outputTimes.data(), numOutputFrames);
+    
+    if (!detectedEvents.empty()) {
+        publishDetectedEvents(detectedEvents);
+    }
+    
+    if (bandEstimator) {
+        publishBandEstimates(outputTimes.back());
+    }
+}
+
+
+bool OpenEphysContinuousInterface::convertSampleNumber(double sampleNumber, MWTime &time) {
+    if (!clockService) {
+        // The interface providing the clock may not have been initialized when we were
+        clockService = OpenEphysClockService::lookup(clockSource);
+    }
+    if (clockService && clockService->convertSeconds(sampleNumber / sampleRate, time)) {
+        warnedUnsynchronized = false;
+        return true;
+    }
+    if (!warnedUnsynchronized) {
+        mwarning(M_IODEVICE_MESSAGE_DOMAIN,
+                 "Open Ephys clock from %s is not available; discarding continuous data until it is",
+                 clockSource.c_str());
+        warnedUnsynchronized = true;
+    }
+    return false;
+}
+
+
+void OpenEphysContinuousInterface::publishBandEstimates(MWTime sampleTime) {
+    const MWTime currentTime = currentTimeUS();
+    if (lastBandPublishTime >= 0 && currentTime - lastBandPublishTime < bandPublishInterval) {
+        return;
+    }
+    lastBandPublishTime = currentTime;
+    
+    const std::size_t numChannels = bandEstimator->getNumChannels();
+    
+    if (bandPhase) {
+        Datum phase(M_LIST, int(numChannels));
+        for (std::size_t channel = 0; channel < numChannels; channel++) {
+            phase.addElement(Datum(bandEstimator->getPhase(channel)));
+        }
+        bandPhase->setValue(phase, sampleTime);
+    }
+    
+    if (bandPower) {
+        Datum power(M_LIST, int(numChannels));
+        for (std::size_t channel = 0; channel < numChannels; channel++) {
+            power.addElement(Datum(bandEstimator->getPower(channel)));
+        }
+        bandPower->setValue(power, sampleTime);
+    }
+    
+    if (bandLatency) {
+        // Time from acquisition of the newest sample to publication of the estimates derived from it
+        // (including the delay of the decimation filter and of the transfer from Open Ephys)
+        const MWTime publishTime = currentTimeUS();
+        bandLatency->setValue(Datum(publishTime - sampleTime), publishTime);
+    }
+}
+
+
+void OpenEphysContinuousInterface::publishDetectedEvents(const std::vector<OpenEphysEnvelopeDetector::Event> &events) {
+    const double frameInterval = 1e6 * double(decimationFactor) / sampleRate;  // us
+    
+    for (auto &event : events) {
+        const MWTime detectionTime = outputTimes.at(event.frame);
+        const long channelNumber = getOutputChannelNumber(event.channel);
+        
+        if (event.type == OpenEphysEnvelopeDetector::Event::Type::Onset) {
+            // Report when the envelope first crossed the threshold, not when the event was confirmed
+            detectedEventStartTime = detectionTime - MWTime(std::llround(double(event.duration - 1) * frameInterval));
+            
+            Datum value(M_DICTIONARY, 4);
+            value.addElement("start", detectedEventStartTime);
+            value.addElement("channel", channelNumber);
+            value.addElement("zscore", event.zScore);
+            value.addElement("latency", currentTimeUS() - detectedEventStartTime);
+            detectedEvent->setValue(value, detectedEventStartTime);
+        } else if (detectedEventStartTime >= 0) {
+            if (detectedEventEnd) {
+                Datum value(M_DICTIONARY, 4);
+                value.addElement("start", detectedEventStartTime);
+                value.addElement("end", detectionTime);
+                value.addElement("channel", channelNumber);
+                value.addElement("zscore", event.zScore);
+                detectedEventEnd->setValue(value, detectionTime);
+            }
+            detectedEventStartTime = -1;
+        }
+    }
+}
+
+
+void OpenEphysContinuousInterface::handleDataQuery(const Datum &query) {
+    if (!query.isDictionary()) {
+        merror(M_IODEVICE_MESSAGE_DOMAIN, "Open Ephys continuous data query must be a dictionary");
+        return;
+    }
+    
+    MWTime start = 0, end = 0;
+    const Datum duration = query.getElement("duration");
+    if (duration.isNumber()) {
+        // Most recent data
+        if (!ring.getLatestTime(end)) {
+            dataQueryResult->setValue(Datum(M_DICTIONARY, 0));
+            return;
+        }
+        end += 1;
+        start = end - duration.getInteger();
+    } else {
+        const Datum startValue = query.getElement("start");
+        const Datum endValue = query.getElement("end");
+        if (!startValue.isNumber()) {
+            merror(M_IODEVICE_MESSAGE_DOMAIN, "Open Ephys continuous data query must include duration or start");
+            return;
+        }
+        start = startValue.getInteger();
+        end = (endValue.isNumber() ? MWTime(endValue.getInteger()) : currentTimeUS());
+    }
+    
+    std::vector<MWTime> times;
+    std::vector<float> frames;
+    const std::size_t numFrames = ring.read(start, end, times, frames);
+    const std::size_t numChannels = ring.getNumChannels();
+    
+    Datum samples(M_LIST, int(numChannels));
+    for (std::size_t channel = 0; channel < numChannels; channel++) {
+        Datum channelSamples(M_LIST, int(numFrames));
+        for (std::size_t frame = 0; frame < numFrames; frame++) {
+            channelSamples.addElement(Datum(double(frames[frame * numChannels + channel])));
+        }
+        samples.addElement(channelSamples);
+    }
+    
+    Datum result(M_DICTIONARY, 3);
+    result.addElement("start", (numFrames > 0 ? times.front() : MWTime(0)));
+    result.addElement("end", (numFrames > 0 ? times.back() : MWTime(0)));
+    result.addElement("samples", samples);
+    dataQueryResult->setValue(result);
+}
+
+
+long OpenEphysContinuousInterface::getOutputChannelNumber(std::size_t outputChannel) const {
+    if (channelReducer.getAverageGroupSize() > 1) {
+        // Channel groups are numbered from 1
+        return long(outputChannel + 1);
+    }
+    return long(channels.at(outputChannel) + 1);
+}
+
+
+END_NAMESPACE_MW
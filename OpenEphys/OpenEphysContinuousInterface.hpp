@@ -0,0 +1,114 @@
+//
+//  OpenEphysContinuousInterface.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysContinuousInterface_hpp
+#define OpenEphysContinuousInterface_hpp
+
+#include "OpenEphysBandEstimator.hpp"
+#include "OpenEphysBase.hpp"
+#include "OpenEphysChannelReducer.hpp"
+#include "OpenEphysClockService.hpp"
+#include "OpenEphysContinuousData.hpp"
+#include "OpenEphysContinuousRing.hpp"
+#include "OpenEphysDecimator.hpp"
+#include "OpenEphysEnvelopeDetector.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+class OpenEphysContinuousInterface : public OpenEphysBase {
+    
+public:
+    static const std::string CHANNELS;
+    static const std::string SAMPLE_RATE;
+    static const std::string DECIMATION;
+    static const std::string BUFFER_DURATION;
+    static const std::string CLOCK_SOURCE;
+    static const std::string REFERENCE;
+    static const std::string REFERENCE_GROUP_SIZE;
+    static const std::string CHANNEL_GROUP_SIZE;
+    static const std::string DATA_QUERY;
+    static const std::string DATA_QUERY_RESULT;
+    static const std::string BAND;
+    static const std::string BAND_PHASE;
+    static const std::string BAND_POWER;
+    static const std::string BAND_LATENCY;
+    static const std::string BAND_PUBLISH_INTERVAL;
+    static const std::string DETECTION_BAND;
+    static const std::string DETECTION_THRESHOLD;
+    static const std::string DETECTION_RMS_WINDOW;
+    static const std::string DETECTION_BASELINE_WINDOW;
+    static const std::string DETECTION_MIN_DURATION;
+    static const std::string DETECTED_EVENT;
+    static const std::string DETECTED_EVENT_END;
+    
+    static void describeComponent(ComponentInfo &info);
+    
+    explicit OpenEphysContinuousInterface(const ParameterValueMap &parameters);
+    ~OpenEphysContinuousInterface();
+    
+    bool initialize() override;
+    bool startDeviceIO() override;
+    bool stopDeviceIO() override;
+    
+private:
+    void handleData();
+    void terminateDataHandlerThread();
+    void processData(const OpenEphysContinuousHeader &header, const float *data);
+    bool convertSampleNumber(double sampleNumber, MWTime &time);
+    void publishBandEstimates(MWTime sampleTime);
+    void publishDetectedEvents(const std::vector<OpenEphysEnvelopeDetector::Event> &events);
+    void handleDataQuery(const Datum &query);
+    long getOutputChannelNumber(std::size_t outputChannel) const;
+    
+    std::vector<std::size_t> channels;  // Zero-based
+    const double sampleRate;
+    const std::size_t decimationFactor;
+    const std::string clockSource;
+    VariablePtr dataQuery;
+    VariablePtr dataQueryResult;
+    VariablePtr bandPhase;
+    VariablePtr bandPower;
+    VariablePtr bandLatency;
+    const MWTime bandPublishInterval;
+    VariablePtr detectedEvent;
+    VariablePtr detectedEventEnd;
+    
+    // Used only by the data handler thread
+    boost::shared_ptr<OpenEphysClockService> clockService;
+    OpenEphysChannelReducer channelReducer;
+    OpenEphysDecimator decimator;
+    std::int64_t nextSampleNumber;
+    std::vector<float> inputFrames;
+    std::vector<float> reducedFrames;
+    std::vector<float> outputFrames;
+    std::vector<std::int64_t> outputSampleNumbers;
+    std::vector<MWTime> outputTimes;
+    bool warnedUnsynchronized;
+    bool warnedInvalidData;
+    std::unique_ptr<OpenEphysBandEstimator> bandEstimator;
+    MWTime lastBandPublishTime;
+    std::unique_ptr<OpenEphysEnvelopeDetector> envelopeDetector;
+    MWTime detectedEventStartTime;
+    
+    OpenEphysContinuousRing ring;
+    
+    std::thread dataHandlerThread;
+    std::atomic_flag continueHandlingData;
+    std::mutex mutex;
+    using scoped_lock = std::lock_guard<decltype(mutex)>;
+    
+    bool running;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysContinuousInterface_hpp */
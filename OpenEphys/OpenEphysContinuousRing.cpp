@@ -0,0 +1,127 @@
+//
+//  OpenEphysContinuousRing.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysContinuousRing.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+constexpr int maxReadAttempts = 4;
+
+
+END_NAMESPACE()
+
+
+OpenEphysContinuousRing::OpenEphysContinuousRing(std::size_t numChannels, std::size_t capacity) :
+    numChannels(numChannels),
+    capacity(capacity),
+    samples(numChannels * capacity),
+    sampleTimes(capacity),
+    writeStarted(0),
+    writeCompleted(0)
+{
+    if (numChannels < 1 || capacity < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid continuous data buffer size");
+    }
+}
+
+
+void OpenEphysContinuousRing::clear() {
+    writeStarted.store(0, std::memory_order_relaxed);
+    writeCompleted.store(0, std::memory_order_release);
+}
+
+
+void OpenEphysContinuousRing::write(const float *frames, const MWTime *times, std::size_t numFrames) {
+    // Only the last capacity frames can be kept
+    if (numFrames > capacity) {
+        frames += (numFrames - capacity) * numChannels;
+        times += numFrames - capacity;
+        numFrames = capacity;
+    }
+    
+    const auto first = writeCompleted.load(std::memory_order_relaxed);
+    writeStarted.store(first + numFrames, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    for (std::size_t i = 0; i < numFrames; i++) {
+        const std::size_t slot = (first + i) % capacity;
+        std::copy(frames + i * numChannels, frames + (i + 1) * numChannels, samples.begin() + slot * numChannels);
+        sampleTimes[slot] = times[i];
+    }
+    
+    writeCompleted.store(first + numFrames, std::memory_order_release);
+}
+
+
+std::size_t OpenEphysContinuousRing::read(MWTime start,
+                                          MWTime end,
+                                          std::vector<MWTime> &times,
+                                          std::vector<float> &frames) const
+{
+    for (int attempt = 0; attempt < maxReadAttempts; attempt++) {
+        times.clear();
+        frames.clear();
+        
+        const auto completed = writeCompleted.load(std::memory_order_acquire);
+        const auto oldest = (completed > capacity ? completed - capacity : 0);
+        const auto first = lowerBound(oldest, completed, start);
+        const auto last = lowerBound(first, completed, end);
+        
+        for (auto index = first; index < last; index++) {
+            const std::size_t slot = index % capacity;
+            times.push_back(sampleTimes[slot]);
+            frames.insert(frames.end(),
+                          samples.begin() + slot * numChannels,
+                          samples.begin() + (slot + 1) * numChannels);
+        }
+        
+        // If the writer has started overwriting any of the frames we copied, try again.  (Overwritten
+        // frames have newer times, so if the search was misled by one, first will be among them.)
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto started = writeStarted.load(std::memory_order_relaxed);
+        const auto overwritten = (started > capacity ? started - capacity : 0);
+        if (overwritten <= first) {
+            return times.size();
+        }
+    }
+    
+    // The writer kept lapping us, which means the requested data are being discarded as we read them
+    times.clear();
+    frames.clear();
+    return 0;
+}
+
+
+bool OpenEphysContinuousRing::getLatestTime(MWTime &time) const {
+    const auto completed = writeCompleted.load(std::memory_order_acquire);
+    if (completed == 0) {
+        return false;
+    }
+    time = sampleTimes[(completed - 1) % capacity];
+    return true;
+}
+
+
+std::uint64_t OpenEphysContinuousRing::lowerBound(std::uint64_t first, std::uint64_t last, MWTime time) const {
+    while (first < last) {
+        const auto middle = first + (last - first) / 2;
+        if (sampleTimes[middle % capacity] < time) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return first;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,63 @@
+//
+//  OpenEphysContinuousRing.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysContinuousRing_hpp
+#define OpenEphysContinuousRing_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Fixed-capacity history of multichannel sample frames, each stamped with its MWorks time.  One
+// thread writes; any number of threads may read concurrently without locking.  Readers validate their
+// copy against the writer's progress afterwards, in the manner of a sequence lock, and discard (or
+// retry) anything the writer overwrote while they were reading.
+//
+class OpenEphysContinuousRing : boost::noncopyable {
+    
+public:
+    OpenEphysContinuousRing(std::size_t numChannels, std::size_t capacity);
+    
+    std::size_t getNumChannels() const { return numChannels; }
+    std::size_t getCapacity() const { return capacity; }
+    
+    // Must not be called concurrently with write
+    void clear();
+    
+    // Frames are interleaved, and times must be nondecreasing.  Writer only.
+    void write(const float *frames, const MWTime *times, std::size_t numFrames);
+    
+    //
+    // Copies the frames with times in [start, end) into times and frames (interleaved), replacing their
+    // contents, and returns the number of frames copied
+    //
+    std::size_t read(MWTime start, MWTime end, std::vector<MWTime> &times, std::vector<float> &frames) const;
+    
+    // Time of the most recent frame, or false if the ring is empty
+    bool getLatestTime(MWTime &time) const;
+    
+private:
+    std::uint64_t lowerBound(std::uint64_t first, std::uint64_t last, MWTime time) const;
+    
+    const std::size_t numChannels;
+    const std::size_t capacity;
+    std::vector<float> samples;
+    std::vector<MWTime> sampleTimes;
+    
+    std::atomic<std::uint64_t> writeStarted;    // Frames the writer has begun to store
+    std::atomic<std::uint64_t> writeCompleted;  // Frames available to readers
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysContinuousRing_hpp */
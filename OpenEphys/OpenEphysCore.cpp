@@ -0,0 +1,59 @@
+//
+//  OpenEphysCore.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysCore.hpp"
+
+#ifdef OPENEPHYS_STANDALONE
+
+#include <cstdarg>
+#include <cstdio>
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+void logMessage(const char *prefix, const char *format, va_list args) {
+    std::fputs(prefix, stderr);
+    std::vfprintf(stderr, format, args);
+    std::fputc('\n', stderr);
+}
+
+
+END_NAMESPACE()
+
+
+void merror(MessageDomain, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    logMessage("ERROR: ", format, args);
+    va_end(args);
+}
+
+
+void mwarning(MessageDomain, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    logMessage("WARNING: ", format, args);
+    va_end(args);
+}
+
+
+void mprintf(MessageDomain, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    logMessage("", format, args);
+    va_end(args);
+}
+
+
+END_NAMESPACE_MW
+
+
+#endif /* defined(OPENEPHYS_STANDALONE) */
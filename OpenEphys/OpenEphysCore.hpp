@@ -0,0 +1,85 @@
+//
+//  OpenEphysCore.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysCore_hpp
+#define OpenEphysCore_hpp
+
+
+//
+// The classes that decode Open Ephys events, model the clocks, and store, archive, and encode spikes
+// use only a few basic MWorksCore facilities (MWTime, logging, SimpleException).  When they're built
+// outside of the plugin (with OPENEPHYS_STANDALONE defined), this header supplies minimal equivalents,
+// so that they can be compiled, tested, and profiled on their own.  In the plugin, the prefix header
+// provides the real definitions, and this header adds nothing.
+//
+#ifdef OPENEPHYS_STANDALONE
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/weak_ptr.hpp>
+
+#define BEGIN_NAMESPACE_MW namespace mw {
+#define END_NAMESPACE_MW }
+#define BEGIN_NAMESPACE(name) namespace name {
+#define END_NAMESPACE(name) }
+
+
+BEGIN_NAMESPACE_MW
+
+
+using MWTime = long long;
+
+
+enum MessageDomain { M_IODEVICE_MESSAGE_DOMAIN };
+
+
+class SimpleException : public std::runtime_error {
+public:
+    SimpleException(MessageDomain, const std::string &message) :
+        std::runtime_error(message)
+    { }
+    SimpleException(MessageDomain, const std::string &message, const std::string &subject) :
+        std::runtime_error(message + ": " + subject)
+    { }
+};
+
+
+// Messages are written to standard error
+void merror(MessageDomain domain, const char *format, ...) __attribute__((format(printf, 2, 3)));
+void mwarning(MessageDomain domain, const char *format, ...) __attribute__((format(printf, 2, 3)));
+void mprintf(MessageDomain domain, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+
+END_NAMESPACE_MW
+
+
+#endif /* defined(OPENEPHYS_STANDALONE) */
+
+
+#endif /* OpenEphysCore_hpp */
@@ -0,0 +1,149 @@
+//
+//  OpenEphysCrossCorrelogram.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysCrossCorrelogram.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+void OpenEphysCrossCorrelogram::SpikeWindow::add(MWTime time, MWTime discardBefore) {
+    // Spikes from a single unit almost always arrive in order, so this is nearly always an append
+    times.insert(std::upper_bound(times.begin() + first, times.end(), time), time);
+    
+    while (first < times.size() && times[first] < discardBefore) {
+        first++;
+    }
+    
+    // Compact occasionally, so that the cost of discarding is amortized over many spikes
+    if (first > times.size() / 2) {
+        times.erase(times.begin(), times.begin() + first);
+        first = 0;
+    }
+}
+
+
+auto OpenEphysCrossCorrelogram::SpikeWindow::find(MWTime start, MWTime end) const -> std::pair<const MWTime *, const MWTime *> {
+    const auto lower = std::lower_bound(times.begin() + first, times.end(), start);
+    const auto upper = std::upper_bound(lower, times.end(), end);
+    return { times.data() + (lower - times.begin()), times.data() + (upper - times.begin()) };
+}
+
+
+OpenEphysCrossCorrelogram::OpenEphysCrossCorrelogram(std::size_t numUnits, MWTime window, MWTime binWidth) :
+    numUnits(numUnits),
+    binWidth(binWidth),
+    binsPerSide(binWidth > 0 ? std::size_t((window + binWidth - 1) / binWidth) : 0),
+    windows(numUnits),
+    counts(numUnits * numUnits * (2 * binsPerSide + 1), 0),
+    spikeCounts(numUnits, 0)
+{
+    if (numUnits < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Cross-correlograms require at least one unit");
+    }
+    if (window <= 0 || binWidth <= 0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                              "Cross-correlogram window and bin width must be greater than zero");
+    }
+}
+
+
+void OpenEphysCrossCorrelogram::clear() {
+    scoped_lock lock(mutex);
+    for (auto &window : windows) {
+        window.clear();
+    }
+    std::fill(counts.begin(), counts.end(), 0);
+    std::fill(spikeCounts.begin(), spikeCounts.end(), 0);
+}
+
+
+void OpenEphysCrossCorrelogram::clearCorrelograms() {
+    scoped_lock lock(mutex);
+    std::fill(counts.begin(), counts.end(), 0);
+    std::fill(spikeCounts.begin(), spikeCounts.end(), 0);
+}
+
+
+void OpenEphysCrossCorrelogram::addSpike(std::size_t unit, MWTime time) {
+    scoped_lock lock(mutex);
+    
+    if (unit >= numUnits) {
+        return;
+    }
+    
+    for (std::size_t otherUnit = 0; otherUnit < numUnits; otherUnit++) {
+        accumulate(unit, otherUnit, time);
+    }
+    
+    // Retain an extra window's worth of spikes, so that spikes from other units that arrive late can
+    // still be paired with them
+    windows[unit].add(time, time - 2 * getWindow());
+    spikeCounts[unit]++;
+}
+
+
+std::size_t OpenEphysCrossCorrelogram::getSpikeCount(std::size_t unit) const {
+    scoped_lock lock(mutex);
+    return spikeCounts.at(unit);
+}
+
+
+void OpenEphysCrossCorrelogram::getCorrelogram(std::size_t reference,
+                                               std::size_t target,
+                                               std::vector<std::uint64_t> &result) const
+{
+    scoped_lock lock(mutex);
+    
+    const std::size_t numBins = getNumBins();
+    result.assign(numBins, 0);
+    if (reference < numUnits && target < numUnits) {
+        std::copy_n(counts.begin() + getPairIndex(reference, target) * (numBins + 1), numBins, result.begin());
+    }
+}
+
+
+void OpenEphysCrossCorrelogram::accumulate(std::size_t unit, std::size_t otherUnit, MWTime time) {
+    const MWTime window = getWindow();
+    const auto spikes = windows[otherUnit].find(time - window, time + window);
+    const std::size_t numSpikes = spikes.second - spikes.first;
+    if (numSpikes == 0) {
+        return;
+    }
+    
+    const std::size_t numBins = getNumBins();
+    const std::uint64_t span = std::uint64_t(numBins) * std::uint64_t(binWidth);
+    
+    // Compute every bin index in one branch-free pass over the contiguous window, then scatter the
+    // counts.  Lags outside the window go to an extra bin, which is never reported.  Each pair of
+    // spikes is counted in both directions, so that every correlogram's bins are exact (negating a
+    // lag doesn't map bin edges onto bin edges).
+    binIndexes.resize(2 * numSpikes);
+    auto binIndex = [&](MWTime lag) {
+        const std::uint64_t offset = std::uint64_t(lag + window);
+        return std::uint32_t(offset < span ? offset / std::uint64_t(binWidth) : numBins);
+    };
+    for (std::size_t i = 0; i < numSpikes; i++) {
+        binIndexes[i] = binIndex(time - spikes.first[i]);
+    }
+    for (std::size_t i = 0; i < numSpikes; i++) {
+        binIndexes[numSpikes + i] = binIndex(spikes.first[i] - time);
+    }
+    
+    // Spikes of otherUnit as reference, unit as target, and vice versa
+    auto forwardCounts = counts.data() + getPairIndex(otherUnit, unit) * (numBins + 1);
+    auto reverseCounts = counts.data() + getPairIndex(unit, otherUnit) * (numBins + 1);
+    for (std::size_t i = 0; i < numSpikes; i++) {
+        forwardCounts[binIndexes[i]]++;
+    }
+    for (std::size_t i = numSpikes; i < 2 * numSpikes; i++) {
+        reverseCounts[binIndexes[i]]++;
+    }
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,93 @@
+//
+//  OpenEphysCrossCorrelogram.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysCrossCorrelogram_hpp
+#define OpenEphysCrossCorrelogram_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Cross-correlograms (and autocorrelograms) of every pair of a fixed set of units, updated
+// incrementally as spikes arrive.  Each unit keeps a sorted window of its recent spike times.  A new
+// spike is paired with the spikes of every unit that lie within the correlogram window of it, so that
+// each pair of spikes is counted exactly once (when the later-received one arrives), even if spikes
+// from different units arrive slightly out of order.  The cost per spike is proportional to the number
+// of spikes in the window, not to the length of the session.
+//
+// The correlogram of reference unit i and target unit j counts target spike times relative to
+// reference spike times.  Bin k covers lags [-window + k * bin width, -window + (k + 1) * bin width),
+// where the window is rounded up to a whole number of bins.  Autocorrelograms exclude each spike's
+// pairing with itself.
+//
+// Times are in microseconds.  Safe to use from multiple threads.
+//
+class OpenEphysCrossCorrelogram : boost::noncopyable {
+    
+public:
+    OpenEphysCrossCorrelogram(std::size_t numUnits, MWTime window, MWTime binWidth);
+    
+    std::size_t getNumUnits() const { return numUnits; }
+    std::size_t getNumBins() const { return 2 * binsPerSide; }
+    MWTime getWindow() const { return MWTime(binsPerSide) * binWidth; }
+    MWTime getBinWidth() const { return binWidth; }
+    
+    // Discards the spike windows and the correlograms
+    void clear();
+    
+    // Discards the correlograms only
+    void clearCorrelograms();
+    
+    void addSpike(std::size_t unit, MWTime time);
+    
+    std::size_t getSpikeCount(std::size_t unit) const;
+    void getCorrelogram(std::size_t reference, std::size_t target, std::vector<std::uint64_t> &counts) const;
+    
+private:
+    class SpikeWindow {
+    public:
+        SpikeWindow() : first(0) { }
+        
+        void clear() { times.clear(); first = 0; }
+        void add(MWTime time, MWTime discardBefore);
+        
+        // Spikes in [start, end]
+        std::pair<const MWTime *, const MWTime *> find(MWTime start, MWTime end) const;
+        
+    private:
+        std::vector<MWTime> times;
+        std::size_t first;  // Earlier times have been discarded
+    };
+    
+    std::size_t getPairIndex(std::size_t reference, std::size_t target) const {
+        return reference * numUnits + target;
+    }
+    
+    void accumulate(std::size_t unit, std::size_t otherUnit, MWTime time);
+    
+    const std::size_t numUnits;
+    const MWTime binWidth;
+    const std::size_t binsPerSide;
+    
+    std::vector<SpikeWindow> windows;
+    std::vector<std::uint64_t> counts;  // Indexed by reference unit, target unit, then bin, with an extra bin for discarded lags
+    std::vector<std::size_t> spikeCounts;
+    std::vector<std::uint32_t> binIndexes;  // For the current spike
+    
+    mutable std::mutex mutex;
+    using scoped_lock = std::lock_guard<decltype(mutex)>;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysCrossCorrelogram_hpp */
@@ -0,0 +1,108 @@
+//
+//  OpenEphysDecimator.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysDecimator.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+OpenEphysDecimator::OpenEphysDecimator(std::size_t numChannels, std::size_t factor, std::size_t tapsPerPhase) :
+    numChannels(numChannels),
+    factor(factor),
+    phase(0)
+{
+    if (numChannels < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decimator requires at least one channel");
+    }
+    if (factor < 1 || tapsPerPhase < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid decimator configuration");
+    }
+    
+    if (factor == 1) {
+        // No filtering needed
+        coefficients.assign(1, 1.0f);
+    } else {
+        // Odd length, so that the delay is a whole number of samples
+        const std::size_t numTaps = factor * tapsPerPhase + 1;
+        const double cutoff = 0.8 / double(factor);  // Fraction of the input Nyquist frequency
+        const double center = double(numTaps - 1) / 2.0;
+        
+        std::vector<double> taps(numTaps);
+        double sum = 0.0;
+        for (std::size_t i = 0; i < numTaps; i++) {
+            const double x = double(i) - center;
+            const double sinc = (x == 0.0 ? cutoff : std::sin(M_PI * cutoff * x) / (M_PI * x));
+            const double window = (0.42 -
+                                   0.5 * std::cos(2.0 * M_PI * double(i) / double(numTaps - 1)) +
+                                   0.08 * std::cos(4.0 * M_PI * double(i) / double(numTaps - 1)));
+            taps[i] = sinc * window;
+            sum += taps[i];
+        }
+        
+        // Normalize to unity gain at DC
+        for (auto tap : taps) {
+            coefficients.push_back(float(tap / sum));
+        }
+    }
+    
+    reset();
+}
+
+
+void OpenEphysDecimator::reset() {
+    buffer.assign((coefficients.size() - 1) * numChannels, 0.0f);
+    phase = 0;
+}
+
+
+std::size_t OpenEphysDecimator::process(const float *input,
+                                        std::size_t numFrames,
+                                        std::int64_t firstSampleNumber,
+                                        std::vector<float> &output,
+                                        std::vector<std::int64_t> &outputSampleNumbers)
+{
+    const std::size_t numTaps = coefficients.size();
+    const std::size_t historyFrames = numTaps - 1;
+    
+    buffer.resize((historyFrames + numFrames) * numChannels);
+    std::copy(input, input + numFrames * numChannels, buffer.begin() + historyFrames * numChannels);
+    
+    std::size_t numOutputFrames = 0;
+    for (std::size_t frame = 0; frame < numFrames; frame++) {
+        if (++phase < factor) {
+            continue;
+        }
+        phase = 0;
+        
+        const std::size_t outputOffset = output.size();
+        output.resize(outputOffset + numChannels, 0.0f);
+        float * const out = output.data() + outputOffset;
+        
+        // The newest input frame is at historyFrames + frame in the buffer
+        const float *newest = buffer.data() + (historyFrames + frame) * numChannels;
+        for (std::size_t tap = 0; tap < numTaps; tap++) {
+            const float coefficient = coefficients[tap];
+            const float *in = newest - tap * numChannels;
+            for (std::size_t channel = 0; channel < numChannels; channel++) {
+                out[channel] += coefficient * in[channel];
+            }
+        }
+        
+        outputSampleNumbers.push_back(firstSampleNumber + std::int64_t(frame));
+        numOutputFrames++;
+    }
+    
+    // Keep the most recent frames as history for the next call
+    std::copy(buffer.end() - historyFrames * numChannels, buffer.end(), buffer.begin());
+    buffer.resize(historyFrames * numChannels);
+    
+    return numOutputFrames;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,67 @@
+//
+//  OpenEphysDecimator.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysDecimator_hpp
+#define OpenEphysDecimator_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Multichannel FIR decimator.  The anti-aliasing filter is a Blackman-windowed sinc with its cutoff at
+// 80% of the output Nyquist frequency.  In polyphase fashion, the filter is evaluated only at the input
+// samples that produce output, so the cost per input sample is (number of taps / factor) multiply-adds
+// per channel.
+//
+// Samples are interleaved (frame-major: all channels of the first sample, then all channels of the
+// second, and so on).  The inner loop of the filter runs across channels, so it operates on contiguous
+// memory and can be vectorized by the compiler.
+//
+class OpenEphysDecimator : boost::noncopyable {
+    
+public:
+    OpenEphysDecimator(std::size_t numChannels, std::size_t factor, std::size_t tapsPerPhase = 8);
+    
+    std::size_t getNumChannels() const { return numChannels; }
+    std::size_t getFactor() const { return factor; }
+    std::size_t getNumTaps() const { return coefficients.size(); }
+    
+    // Group delay of the filter, in input samples
+    double getDelay() const { return double(coefficients.size() - 1) / 2.0; }
+    
+    // Discards the filter history, e.g. after a gap in the input
+    void reset();
+    
+    //
+    // Filters numFrames input frames, whose first frame has the given sample number.  Output frames
+    // are appended to output, and the sample number of the newest input frame contributing to each
+    // output frame is appended to outputSampleNumbers.  Returns the number of output frames.
+    //
+    std::size_t process(const float *input,
+                        std::size_t numFrames,
+                        std::int64_t firstSampleNumber,
+                        std::vector<float> &output,
+                        std::vector<std::int64_t> &outputSampleNumbers);
+    
+private:
+    const std::size_t numChannels;
+    const std::size_t factor;
+    std::vector<float> coefficients;
+    
+    std::vector<float> buffer;  // History (numTaps - 1 frames) followed by the current input
+    std::size_t phase;          // Input frames since the last output frame
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysDecimator_hpp */
@@ -0,0 +1,156 @@
+//
+//  OpenEphysEnvelopeDetector.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysEnvelopeDetector.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+inline float getSmoothingFactor(double timeConstant, double sampleRate) {
+    return float(1.0 - std::exp(-1.0 / (timeConstant * sampleRate)));
+}
+
+
+END_NAMESPACE()
+
+
+OpenEphysEnvelopeDetector::OpenEphysEnvelopeDetector(std::size_t numChannels,
+                                                     double sampleRate,
+                                                     double lowFrequency,
+                                                     double highFrequency,
+                                                     double rmsTimeConstant,
+                                                     double baselineTimeConstant,
+                                                     double threshold,
+                                                     double minDuration) :
+    numChannels(numChannels),
+    rmsSmoothing(getSmoothingFactor(rmsTimeConstant, sampleRate)),
+    baselineSmoothing(getSmoothingFactor(baselineTimeConstant, sampleRate)),
+    // Don't detect events until the baseline has had one time constant to settle
+    warmupFrames(std::size_t(std::ceil(baselineTimeConstant * sampleRate))),
+    threshold(threshold),
+    endThreshold(std::min(1.0, threshold)),
+    minDurationFrames(std::max(std::size_t(1), std::size_t(std::llround(minDuration * sampleRate)))),
+    bandPass1(OpenEphysBiquad::cascadedBandPass(sampleRate, lowFrequency, highFrequency)),
+    bandPass2(bandPass1)
+{
+    if (numChannels < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Envelope detector requires at least one channel");
+    }
+    if (lowFrequency <= 0.0 || highFrequency <= lowFrequency || highFrequency >= sampleRate / 2.0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                              "Frequency band must be positive, increasing, and below the Nyquist frequency");
+    }
+    if (rmsTimeConstant <= 0.0 || baselineTimeConstant <= 0.0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Envelope and baseline time constants must be positive");
+    }
+    if (threshold <= 0.0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Detection threshold must be positive");
+    }
+    if (minDuration < 0.0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Minimum event duration must be non-negative");
+    }
+    
+    bandPass1.setNumChannels(numChannels);
+    bandPass2.setNumChannels(numChannels);
+    
+    reset();
+}
+
+
+void OpenEphysEnvelopeDetector::reset() {
+    bandPass1.reset();
+    bandPass2.reset();
+    meanSquare.assign(numChannels, 0.0f);
+    baselineMean.assign(numChannels, 0.0f);
+    baselineVariance.assign(numChannels, 0.0f);
+    zScores.assign(numChannels, 0.0f);
+    numBaselineFrames = 0;
+    framesAboveThreshold = 0;
+    inEvent = false;
+    eventDuration = 0;
+    peakChannel = 0;
+    peakZScore = 0.0;
+    events.clear();
+}
+
+
+auto OpenEphysEnvelopeDetector::process(const float *frames, std::size_t numFrames) -> const std::vector<Event>& {
+    events.clear();
+    
+    bandSignal.assign(frames, frames + numFrames * numChannels);
+    bandPass1.process(bandSignal.data(), numFrames);
+    bandPass2.process(bandSignal.data(), numFrames);
+    
+    float * const ms = meanSquare.data();
+    float * const mean = baselineMean.data();
+    float * const variance = baselineVariance.data();
+    float * const z = zScores.data();
+    
+    for (std::size_t frame = 0; frame < numFrames; frame++) {
+        const float *x = bandSignal.data() + frame * numChannels;
+        
+        float maxZ = -std::numeric_limits<float>::infinity();
+        for (std::size_t channel = 0; channel < numChannels; channel++) {
+            ms[channel] += rmsSmoothing * (x[channel] * x[channel] - ms[channel]);
+            const float envelope = std::sqrt(ms[channel]);
+            const float sd = std::sqrt(variance[channel]);
+            z[channel] = (sd > 0.0f ? (envelope - mean[channel]) / sd : 0.0f);
+            maxZ = std::max(maxZ, z[channel]);
+        }
+        
+        const bool warmedUp = (numBaselineFrames >= warmupFrames);
+        
+        if (!inEvent) {
+            if (warmedUp && maxZ >= threshold) {
+                framesAboveThreshold++;
+                if (framesAboveThreshold >= minDurationFrames) {
+                    inEvent = true;
+                    eventDuration = framesAboveThreshold;
+                    peakChannel = std::size_t(std::max_element(zScores.begin(), zScores.end()) - zScores.begin());
+                    peakZScore = maxZ;
+                    events.push_back({ Event::Type::Onset, frame, eventDuration, peakChannel, peakZScore });
+                }
+            } else {
+                framesAboveThreshold = 0;
+            }
+        } else {
+            eventDuration++;
+            if (maxZ > peakZScore) {
+                peakChannel = std::size_t(std::max_element(zScores.begin(), zScores.end()) - zScores.begin());
+                peakZScore = maxZ;
+            }
+            if (maxZ < endThreshold) {
+                inEvent = false;
+                framesAboveThreshold = 0;
+                events.push_back({ Event::Type::Offset, frame, eventDuration, peakChannel, peakZScore });
+            }
+        }
+        
+        // Update the baseline only outside of events (and candidate events), so that they don't
+        // inflate it.  Until the baseline has settled, weight early frames more heavily, so that it
+        // converges quickly from its initial value.
+        if (!inEvent && framesAboveThreshold == 0) {
+            numBaselineFrames++;
+            const float alpha = std::max(baselineSmoothing, 1.0f / float(numBaselineFrames));
+            for (std::size_t channel = 0; channel < numChannels; channel++) {
+                const float envelope = std::sqrt(ms[channel]);
+                const float delta = envelope - mean[channel];
+                mean[channel] += alpha * delta;
+                variance[channel] = (1.0f - alpha) * (variance[channel] + alpha * delta * delta);
+            }
+        }
+    }
+    
+    return events;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,89 @@
+//
+//  OpenEphysEnvelopeDetector.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysEnvelopeDetector_hpp
+#define OpenEphysEnvelopeDetector_hpp
+
+#include "OpenEphysBandEstimator.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Detects transient increases in band-limited power (e.g. hippocampal sharp-wave ripples).  Each
+// channel is band-pass filtered, and its RMS envelope is computed with an exponentially weighted
+// moving average of the squared signal.  The envelope is compared with an adaptive baseline (the
+// exponentially weighted mean and standard deviation of the envelope outside of events).  An event
+// starts when any channel's envelope has exceeded the baseline by the threshold (in standard
+// deviations) for the minimum duration, and ends when every channel's envelope has fallen back to
+// within one standard deviation of the baseline.
+//
+// As with OpenEphysBandEstimator, per-sample work runs across channels of interleaved frames.
+//
+class OpenEphysEnvelopeDetector : boost::noncopyable {
+    
+public:
+    struct Event {
+        enum class Type { Onset, Offset };
+        
+        Type type;
+        std::size_t frame;           // Index (within the processed frames) of the frame at which it was detected
+        std::size_t duration;        // Number of frames since the envelope first crossed the threshold
+        std::size_t channel;         // Channel with the largest envelope (at onset) or peak envelope (at offset)
+        double zScore;               // Envelope of that channel, in standard deviations above the baseline
+    };
+    
+    OpenEphysEnvelopeDetector(std::size_t numChannels,
+                              double sampleRate,
+                              double lowFrequency,
+                              double highFrequency,
+                              double rmsTimeConstant,       // Seconds
+                              double baselineTimeConstant,  // Seconds
+                              double threshold,             // Standard deviations
+                              double minDuration);          // Seconds
+    
+    std::size_t getNumChannels() const { return numChannels; }
+    
+    void reset();
+    
+    // Returns the events detected in the given frames (valid until the next call)
+    const std::vector<Event>& process(const float *frames, std::size_t numFrames);
+    
+private:
+    const std::size_t numChannels;
+    const float rmsSmoothing;
+    const float baselineSmoothing;
+    const std::size_t warmupFrames;
+    const double threshold;
+    const double endThreshold;
+    const std::size_t minDurationFrames;
+    
+    OpenEphysBiquad bandPass1, bandPass2;
+    
+    std::vector<float> bandSignal;
+    std::vector<float> meanSquare;     // Per channel
+    std::vector<float> baselineMean;   // Per channel
+    std::vector<float> baselineVariance;  // Per channel
+    std::vector<float> zScores;        // Per channel, for the current frame
+    
+    std::size_t numBaselineFrames;
+    std::size_t framesAboveThreshold;
+    bool inEvent;
+    std::size_t eventDuration;
+    std::size_t peakChannel;
+    double peakZScore;
+    
+    std::vector<Event> events;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysEnvelopeDetector_hpp */
@@ -0,0 +1,91 @@
+//
+//  OpenEphysEvent.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysEvent_hpp
+#define OpenEphysEvent_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Body of an Event Broadcaster message.  Each message consists of three parts: the event type
+// (one byte), the event timestamp (a double, in seconds), and this body.
+//
+struct OpenEphysEvent {
+    
+    static constexpr std::uint8_t spikeType = 2;
+    static constexpr std::uint8_t ttlType = 3;
+    
+    static constexpr std::size_t maxSpikeChannels = 4;
+    
+    // Number of channels of a spike's electrode (single electrode, stereotrode, or tetrode), given its
+    // elecType, or zero if the type is unknown
+    static std::size_t getNumSpikeChannels(std::uint8_t elecType) {
+        switch (elecType) {
+            case 0:
+                return 1;
+            case 1:
+                return 2;
+            case 2:
+                return 4;
+            default:
+                return 0;
+        }
+    }
+    
+    struct TTL {
+        std::uint8_t nodeID;
+        std::uint8_t eventID;
+        std::uint8_t eventChannel;
+        std::uint8_t _savingFlag;
+        std::uint8_t sourceNodeID;
+        std::uint64_t word;
+    } __attribute__((packed));
+    
+    // Header of a SpikeEvent.  It's followed by one float threshold per channel, the waveform (float
+    // samples, in microvolts, with each channel's samples contiguous), and metadata.
+    struct Spike {
+        std::uint8_t evtType;
+        std::uint8_t elecType;
+        std::uint16_t _source;  // Used internally by spike detector
+        std::uint16_t channel;
+        std::uint16_t electrodeID;
+        std::int64_t timestamp;
+        std::uint16_t sortedID;
+
+/*        std::int64_t timestamp;
+        std::int64_t timestampSoftware;
+        std::uint16_t _source;  // Used internally by spike detector
+        std::uint16_t nChannels;
+        std::uint16_t nSamples;
+        std::uint16_t sortedID;
+        std::uint16_t electrodeID;
+        std::uint16_t channel;  */
+        /* Other fields ignored */
+    } __attribute__((packed));
+    
+    union {
+        TTL ttl;
+        Spike spike;
+    };
+    
+};
+
+// Verify packing
+BOOST_STATIC_ASSERT(sizeof(OpenEphysEvent::TTL) == 13);
+//BOOST_STATIC_ASSERT(sizeof(OpenEphysEvent::Spike) == 28);
+BOOST_STATIC_ASSERT(sizeof(OpenEphysEvent::Spike) == 18);
+BOOST_STATIC_ASSERT(sizeof(OpenEphysEvent) == sizeof(OpenEphysEvent::Spike));
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysEvent_hpp */
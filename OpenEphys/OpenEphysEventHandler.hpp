@@ -0,0 +1,46 @@
+//
+//  OpenEphysEventHandler.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysEventHandler_hpp
+#define OpenEphysEventHandler_hpp
+
+#include "OpenEphysEvent.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Consumer of the events an OpenEphysEventReceiver receives.  begin, handleEvent, update, and end are
+// called from the receiver's thread.
+//
+class OpenEphysEventHandler {
+    
+public:
+    virtual ~OpenEphysEventHandler() { }
+    
+    // Event types to subscribe to
+    virtual bool needsSyncWords() const = 0;
+    virtual bool needsSpikes() const = 0;
+    // Longest time that may pass between calls to update
+    virtual MWTime getUpdateInterval() const = 0;
+    // Longest event body that is used in full
+    virtual std::size_t getMaxEventSize() const = 0;
+    
+    virtual void begin() = 0;
+    // size is the full size of the event body, which may exceed the getMaxEventSize() bytes read
+    virtual void handleEvent(std::uint8_t type, double timestamp, const std::uint8_t *body, std::size_t size) = 0;
+    virtual void update() = 0;
+    virtual void end() = 0;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysEventHandler_hpp */
@@ -0,0 +1,516 @@
+//
+//  OpenEphysEventPipeline.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysEventPipeline.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+inline MWTime secsToUS(double timestamp) {
+    return MWTime(timestamp * 1e6);
+}
+
+
+// Received sync words are matched only against this many recent transmissions, limited so that the
+// values in the window are distinct
+inline std::size_t getSyncMatchWindow(std::size_t numSyncChannels) {
+    constexpr std::size_t maxSyncMatchWindow = 8;
+    if (numSyncChannels >= 4) {
+        return maxSyncMatchWindow;
+    }
+    return std::max(std::size_t(1), (std::size_t(1) << numSyncChannels) - 1);
+}
+
+
+constexpr std::size_t minSyncLatencySamples = 16;
+constexpr MWTime maxSyncLatency = 1000000;  // 1 second
+constexpr MWTime clockQualityPublishInterval = 1000000;  // 1 second
+constexpr MWTime syncReceiptCheckInterval = 5000000;  // 5 seconds
+constexpr MWTime maxUpdateInterval = 500000;  // 0.5 seconds
+constexpr std::size_t maxSpikesPerBatch = 1024;
+
+
+END_NAMESPACE()
+
+
+OpenEphysEventPipeline::OpenEphysEventPipeline(Delegate &delegate,
+                                               const std::vector<std::uint8_t> &syncChannels,
+                                               boost::shared_ptr<OpenEphysClockService> clockService) :
+    delegate(delegate),
+    syncWordDecoder(syncChannels),
+    clockService(std::move(clockService)),
+    syncLatency(0),
+    spikesEnabled(false),
+    spikeBatchInterval(0),
+    spikeBatchStartTime(0),
+    spikeSummaryInterval(0),
+    spikeSummaryStartTime(0),
+    unitQualityInterval(0),
+    unitQualityStartTime(0),
+    unitQualityOverflowReported(false),
+    lastSyncReceived(-1),
+    lastSyncReceivedTime(0),
+    lastSyncReceiptCheckTime(0),
+    lastClockQualityPublishTime(0),
+    lastLockState(OpenEphysClockModel::LockState::Unlocked),
+    syncMatcher(getSyncMatchWindow(syncWordDecoder.getNumChannels()))
+{ }
+
+
+void OpenEphysEventPipeline::setSyncInterval(MWTime interval) {
+    if (interval <= 0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Sync interval must be greater than zero");
+    }
+    syncSequence.reset(new OpenEphysSyncSequence(syncWordDecoder.getNumChannels()));
+    
+    // Consider the clock to be in holdover after several consecutive sync words are missed
+    clockModel.setHoldoverTimeout(3 * interval);
+}
+
+
+void OpenEphysEventPipeline::setSyncLatency(MWTime latency) {
+    if (latency < 0 || latency > maxSyncLatency) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid sync latency");
+    }
+    syncLatency = latency;
+}
+
+
+void OpenEphysEventPipeline::setClockModelFile(const std::string &path, const std::string &key) {
+    clockModelFile = path;
+    clockModelKey = key;
+}
+
+
+void OpenEphysEventPipeline::enableSpikes(MWTime batchInterval) {
+    if (batchInterval < 0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Spike batch interval cannot be negative");
+    }
+    spikesEnabled = true;
+    spikeBatchInterval = batchInterval;
+}
+
+
+void OpenEphysEventPipeline::setSpikeStore(std::unique_ptr<OpenEphysSpikeStore> store) {
+    spikeStore = std::move(store);
+}
+
+
+void OpenEphysEventPipeline::setSpikeArchive(std::unique_ptr<OpenEphysSpikeArchive> archive) {
+    spikeArchive = std::move(archive);
+}
+
+
+void OpenEphysEventPipeline::setSpikeClassifier(std::unique_ptr<OpenEphysSpikeClassifier> classifier) {
+    spikeClassifier = std::move(classifier);
+}
+
+
+void OpenEphysEventPipeline::enableSpikeSummaries(std::unique_ptr<OpenEphysOverloadController> controller,
+                                                  MWTime interval)
+{
+    if (!spikesEnabled) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Spike summaries require spike publication");
+    }
+    if (interval <= 0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Spike summary interval must be greater than zero");
+    }
+    overloadController = std::move(controller);
+    spikeSummaryInterval = interval;
+}
+
+
+void OpenEphysEventPipeline::enableUnitQuality(std::unique_ptr<OpenEphysUnitQuality> tracker, MWTime interval) {
+    if (interval <= 0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Unit quality interval must be greater than zero");
+    }
+    unitQualityTracker = std::move(tracker);
+    unitQualityInterval = interval;
+}
+
+
+bool OpenEphysEventPipeline::needsSpikes() const {
+    return (spikesEnabled || spikeStore || spikeArchive || unitQualityTracker);
+}
+
+
+MWTime OpenEphysEventPipeline::getUpdateInterval() const {
+    MWTime interval = maxUpdateInterval;
+    if (spikesEnabled && spikeBatchInterval > 0) {
+        // Update often enough to publish partial batches on time
+        interval = std::min(interval, spikeBatchInterval);
+    }
+    if (unitQualityTracker) {
+        interval = std::min(interval, unitQualityInterval);
+    }
+    return interval;
+}
+
+
+std::size_t OpenEphysEventPipeline::getMaxEventSize() const {
+    if (spikeClassifier) {
+        return sizeof(OpenEphysEvent::Spike) + spikeClassifier->getMaxWaveformBytes();
+    }
+    return sizeof(OpenEphysEvent);
+}
+
+
+bool OpenEphysEventPipeline::reset() {
+    if (spikeArchive && !spikeArchive->open()) {
+        return false;
+    }
+    
+    clockModel.reset();
+    if (!clockModelFile.empty() && clockModel.load(clockModelFile, clockModelKey, delegate.getCurrentTime())) {
+        mprintf(M_IODEVICE_MESSAGE_DOMAIN, "Using saved Open Ephys clock model until clock sync is received");
+    }
+    clockService->update(clockModel);
+    
+    spikeBatchEncoder.reset();
+    if (unitQualityTracker) {
+        // Open Ephys timestamps may restart with the new acquisition
+        unitQualityTracker->reset();
+        unitQualityStartTime = delegate.getCurrentTime();
+    }
+    
+    return true;
+}
+
+
+void OpenEphysEventPipeline::stop() {
+    if (spikeArchive) {
+        spikeArchive->close();
+    }
+    
+    double latency = 0.0, jitter = 0.0;
+    std::size_t numSamples = 0;
+    if (getSyncLatencyEstimate(latency, jitter, numSamples)) {
+        mprintf(M_IODEVICE_MESSAGE_DOMAIN,
+                "Open Ephys sync latency: %g ms (residual jitter %g ms, %lu samples)",
+                latency / 1e3,
+                jitter / 1e3,
+                (unsigned long)numSamples);
+    }
+    
+    if (clockModel.getNumRejectedMatches() > 0) {
+        mprintf(M_IODEVICE_MESSAGE_DOMAIN,
+                "Open Ephys clock model rejected %lu inconsistent sync matches",
+                (unsigned long)clockModel.getNumRejectedMatches());
+    }
+    
+    if (!clockModelFile.empty() && clockModel.isValid() && !clockModel.isProvisional()) {
+        clockModel.save(clockModelFile, clockModelKey);
+    }
+}
+
+
+void OpenEphysEventPipeline::begin() {
+    const MWTime currentTime = delegate.getCurrentTime();
+    
+    lastSyncReceived = -1;
+    lastSyncReceivedTime = currentTime;
+    lastSyncReceiptCheckTime = currentTime;
+    lastClockQualityPublishTime = currentTime;
+    lastLockState = clockModel.getLockState(currentTime);
+    
+    delegate.publishClockQuality(clockModel, currentTime);
+    if (overloadController) {
+        delegate.publishOverloadMode(overloadController->getMode(), currentTime);
+    }
+}
+
+
+void OpenEphysEventPipeline::handleEvent(std::uint8_t type,
+                                         double timestamp,
+                                         const std::uint8_t *body,
+                                         std::size_t size)
+{
+    OpenEphysEvent event;
+    std::memset(&event, 0, sizeof(event));
+    std::memcpy(&event, body, std::min(sizeof(event), size));
+    
+    switch (type) {
+        case OpenEphysEvent::ttlType:
+            handleSyncWord(int(syncWordDecoder.decode(event.ttl.word)), timestamp);
+            break;
+        
+        case OpenEphysEvent::spikeType: {
+            // The thresholds, waveform, and metadata follow the spike header.  The size is that of the
+            // whole body, even if only its first getMaxEventSize() bytes were read.
+            const std::size_t payloadSize = (size > sizeof(event.spike) ? size - sizeof(event.spike) : 0);
+            handleSpike(event.spike, timestamp, body + sizeof(event.spike), payloadSize);
+            break;
+        }
+        
+        default:
+            merror(M_IODEVICE_MESSAGE_DOMAIN, "Open Ephys event has unexpected type (%hhu)", type);
+            break;
+    }
+}
+
+
+void OpenEphysEventPipeline::update() {
+    const MWTime currentTime = delegate.getCurrentTime();
+    
+    const auto currentLockState = clockModel.getLockState(currentTime);
+    if (currentLockState != lastLockState ||
+        currentTime - lastClockQualityPublishTime >= clockQualityPublishInterval)
+    {
+        delegate.publishClockQuality(clockModel, currentTime);
+        lastLockState = currentLockState;
+        lastClockQualityPublishTime = currentTime;
+    }
+    
+    if (!spikeBatchEncoder.empty() && currentTime - spikeBatchStartTime >= spikeBatchInterval) {
+        publishSpikeBatch();
+    }
+    
+    if (overloadController) {
+        updateOverloadMode(currentTime);
+    }
+    
+    if (unitQualityTracker && currentTime - unitQualityStartTime >= unitQualityInterval) {
+        publishUnitQuality(currentTime);
+    }
+    
+    if (currentTime - lastSyncReceiptCheckTime >= syncReceiptCheckInterval) {
+        merror(M_IODEVICE_MESSAGE_DOMAIN,
+               "No Open Ephys clock sync received after %g seconds",
+               std::round(double(currentTime - lastSyncReceivedTime) / 1e6));
+        lastSyncReceiptCheckTime = currentTime;
+    }
+}
+
+
+void OpenEphysEventPipeline::end() {
+    if (!spikeBatchEncoder.empty()) {
+        publishSpikeBatch();
+    }
+    if (overloadController && overloadController->getMode() == OpenEphysOverloadController::Mode::Summary) {
+        publishSpikeSummary(delegate.getCurrentTime());
+    }
+    if (unitQualityTracker && unitQualityTracker->hasStats()) {
+        publishUnitQuality(delegate.getCurrentTime());
+    }
+}
+
+
+int OpenEphysEventPipeline::nextSyncWord() {
+    scoped_lock lock(mutex);
+    if (!syncSequence) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Open Ephys sync interval is not set");
+    }
+    return syncSequence->next();
+}
+
+
+void OpenEphysEventPipeline::addSentSyncWord(int value, MWTime sendTime) {
+    scoped_lock lock(mutex);
+    syncMatcher.addSentValue(value, sendTime);
+}
+
+
+bool OpenEphysEventPipeline::handleSyncLoopback(int value, MWTime receiptTime) {
+    scoped_lock lock(mutex);
+    MWTime sendTime = 0;
+    if (!syncMatcher.getSendTime(value, sendTime)) {
+        return false;
+    }
+    const MWTime latency = receiptTime - sendTime;
+    if (latency < 0 || latency > maxSyncLatency) {
+        return false;
+    }
+    syncLatencyEstimator.addSample(latency);
+    return true;
+}
+
+
+bool OpenEphysEventPipeline::getSyncLatencyEstimate(double &latency, double &jitter, std::size_t &numSamples) const {
+    scoped_lock lock(mutex);
+    if (!syncLatencyEstimator.getEstimate(latency, jitter)) {
+        return false;
+    }
+    numSamples = syncLatencyEstimator.getNumSamples();
+    return true;
+}
+
+
+void OpenEphysEventPipeline::handleSyncWord(int syncReceived, double timestamp) {
+    if (syncReceived == lastSyncReceived) {
+        return;
+    }
+    
+    const MWTime receiptTime = delegate.getCurrentTime();
+    lastSyncReceived = syncReceived;
+    lastSyncReceivedTime = receiptTime;
+    lastSyncReceiptCheckTime = receiptTime;
+    
+    MWTime syncSendTime = 0;
+    auto matchResult = OpenEphysSyncMatcher::Result::Unmatched;
+    int lastSyncSent = -1;
+    {
+        // Hold the lock only while using the state shared with the sync notifications
+        scoped_lock lock(mutex);
+        matchResult = syncMatcher.matchReceivedValue(syncReceived, syncSendTime);
+        syncSendTime += getSyncLatency();
+        lastSyncSent = (syncMatcher.empty() ? -1 : syncMatcher.getLastSentValue());
+    }
+    
+    if (matchResult == OpenEphysSyncMatcher::Result::Matched) {
+        const MWTime oeTime = secsToUS(timestamp);
+        // The model rejects (and reports) matches that are inconsistent with it
+        if (clockModel.addSyncMatch(oeTime, syncSendTime)) {
+            clockService->update(clockModel);
+            delegate.publishClockOffset(MWTime(std::llround(clockModel.getOffset(oeTime))), receiptTime);
+            delegate.publishClockQuality(clockModel, receiptTime);
+        }
+    } else if (matchResult == OpenEphysSyncMatcher::Result::Unmatched) {
+        merror(M_IODEVICE_MESSAGE_DOMAIN,
+               "Open Ephys clock sync has unexpected value: sent %d, received %d",
+               lastSyncSent,
+               syncReceived);
+    }
+}
+
+
+void OpenEphysEventPipeline::handleSpike(const OpenEphysEvent::Spike &event,
+                                         double timestamp,
+                                         const std::uint8_t *payload,
+                                         std::size_t payloadSize)
+{
+    const MWTime oeTime = secsToUS(timestamp);
+    const OpenEphysSpikeRecord spike {
+        clockModel.convert(oeTime),
+        event.timestamp,
+        event.electrodeID,
+        event.sortedID,
+        event.channel,
+        (spikeClassifier ?
+         spikeClassifier->classify(event.electrodeID,
+                                   OpenEphysEvent::getNumSpikeChannels(event.elecType),
+                                   payload,
+                                   payloadSize) :
+         OpenEphysSpikeClassifier::unclassifiedID)
+    };
+    
+    if (spikeStore) {
+        spikeStore->addSpike(spike.electrodeID, spike.sortedID, spike.time);
+    }
+    
+    if (spikeArchive) {
+        spikeArchive->append(spike);
+    }
+    
+    if (unitQualityTracker &&
+        !unitQualityTracker->addSpike(spike.electrodeID, spike.sortedID, oeTime) &&
+        !unitQualityOverflowReported)
+    {
+        merror(M_IODEVICE_MESSAGE_DOMAIN,
+               "Open Ephys unit IDs are too large to track unit quality (electrode %hu, sorted ID %hu)",
+               spike.electrodeID,
+               spike.sortedID);
+        unitQualityOverflowReported = true;
+    }
+    
+    if (overloadController) {
+        const MWTime currentTime = delegate.getCurrentTime();
+        if (clockModel.isValid()) {
+            overloadController->addLagSample(currentTime - spike.time);
+        } else {
+            overloadController->addReceiveDelaySample(oeTime, currentTime);
+        }
+        if (overloadController->getMode() == OpenEphysOverloadController::Mode::Summary) {
+            overloadController->countSpike(spike.electrodeID, spike.sortedID);
+        } else {
+            publishSpike(spike);
+        }
+    } else if (spikesEnabled) {
+        publishSpike(spike);
+    }
+}
+
+
+MWTime OpenEphysEventPipeline::getSyncLatency() const {
+    // Caller must hold the lock
+    double latency = 0.0, jitter = 0.0;
+    if (syncLatencyEstimator.getNumSamples() >= minSyncLatencySamples &&
+        syncLatencyEstimator.getEstimate(latency, jitter))
+    {
+        return MWTime(std::llround(latency));
+    }
+    return syncLatency;
+}
+
+
+void OpenEphysEventPipeline::publishSpike(const OpenEphysSpikeRecord &spike) {
+    if (spikeBatchInterval == 0) {
+        delegate.publishSpike(spike);
+        return;
+    }
+    
+    if (spikeBatchEncoder.empty()) {
+        spikeBatchStartTime = delegate.getCurrentTime();
+    }
+    spikeBatchEncoder.add(spike);
+    if (spikeBatchEncoder.size() >= maxSpikesPerBatch) {
+        publishSpikeBatch();
+    }
+}
+
+
+void OpenEphysEventPipeline::publishSpikeBatch() {
+    const MWTime firstSpikeTime = spikeBatchEncoder.getFirstSpikeTime();
+    delegate.publishSpikeBatch(spikeBatchEncoder.finish(), firstSpikeTime);
+}
+
+
+void OpenEphysEventPipeline::updateOverloadMode(MWTime currentTime) {
+    if (!overloadController->update(currentTime, delegate.getQueueFill())) {
+        if (overloadController->getMode() == OpenEphysOverloadController::Mode::Summary &&
+            currentTime - spikeSummaryStartTime >= spikeSummaryInterval)
+        {
+            publishSpikeSummary(currentTime);
+        }
+        return;
+    }
+    
+    if (overloadController->getMode() == OpenEphysOverloadController::Mode::Summary) {
+        mwarning(M_IODEVICE_MESSAGE_DOMAIN,
+                 "Open Ephys spike rate exceeds what MWorks can absorb; publishing per-unit spike counts instead of individual spikes");
+        if (!spikeBatchEncoder.empty()) {
+            publishSpikeBatch();
+        }
+        spikeSummaryStartTime = currentTime;
+    } else {
+        mprintf(M_IODEVICE_MESSAGE_DOMAIN, "Open Ephys spike load has subsided; resuming publication of individual spikes");
+        publishSpikeSummary(currentTime);
+    }
+    
+    delegate.publishOverloadMode(overloadController->getMode(), currentTime);
+}
+
+
+void OpenEphysEventPipeline::publishSpikeSummary(MWTime endTime) {
+    delegate.publishSpikeSummary(spikeSummaryStartTime, endTime, overloadController->takeCounts());
+    spikeSummaryStartTime = endTime;
+}
+
+
+void OpenEphysEventPipeline::publishUnitQuality(MWTime endTime) {
+    delegate.publishUnitQuality(unitQualityStartTime,
+                                endTime,
+                                unitQualityTracker->takeStats(),
+                                unitQualityTracker->getBinEdges());
+    unitQualityStartTime = endTime;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,167 @@
+//
+//  OpenEphysEventPipeline.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysEventPipeline_hpp
+#define OpenEphysEventPipeline_hpp
+
+#include "OpenEphysClockModel.hpp"
+#include "OpenEphysClockService.hpp"
+#include "OpenEphysEventHandler.hpp"
+#include "OpenEphysOverloadController.hpp"
+#include "OpenEphysSpikeArchive.hpp"
+#include "OpenEphysSpikeClassifier.hpp"
+#include "OpenEphysSpikeCodec.hpp"
+#include "OpenEphysSpikeStore.hpp"
+#include "OpenEphysSyncLatencyEstimator.hpp"
+#include "OpenEphysSyncMatcher.hpp"
+#include "OpenEphysSyncSequence.hpp"
+#include "OpenEphysUnitQuality.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Everything the Open Ephys interface does with the events it receives, independent of both MWorks
+// and ZeroMQ: matching sync words to their transmissions, maintaining the clock model, classifying,
+// storing, and archiving spikes, tracking unit quality, and deciding how spikes are published.  The
+// results are handed to a delegate, which publishes them (in the plugin, by assigning variables).
+//
+// begin, handleEvent, update, and end must be called from a single thread (the event handler thread),
+// which owns the clock model and the delegate calls while it runs.  The sync methods (nextSyncWord,
+// addSentSyncWord, handleSyncLoopback, and getSyncLatencyEstimate) may be called from any thread.
+// Components are configured by the set and enable methods before the first run.
+//
+class OpenEphysEventPipeline : public OpenEphysEventHandler, boost::noncopyable {
+    
+public:
+    class Delegate {
+    public:
+        virtual ~Delegate() { }
+        
+        // MWorks time, in microseconds
+        virtual MWTime getCurrentTime() = 0;
+        // Fill fraction of the queue(s) through which results are published
+        virtual double getQueueFill() { return 0.0; }
+        
+        virtual void publishClockOffset(MWTime offset, MWTime time) = 0;
+        virtual void publishClockQuality(const OpenEphysClockModel &clockModel, MWTime currentTime) = 0;
+        virtual void publishSpike(const OpenEphysSpikeRecord &spike) = 0;
+        virtual void publishSpikeBatch(const std::string &batch, MWTime firstSpikeTime) = 0;
+        virtual void publishOverloadMode(OpenEphysOverloadController::Mode mode, MWTime time) = 0;
+        virtual void publishSpikeSummary(MWTime start,
+                                         MWTime end,
+                                         const std::vector<OpenEphysOverloadController::UnitCount> &counts) = 0;
+        virtual void publishUnitQuality(MWTime start,
+                                        MWTime end,
+                                        const std::vector<OpenEphysUnitQuality::UnitStats> &stats,
+                                        const std::vector<MWTime> &binEdges) = 0;
+    };
+    
+    OpenEphysEventPipeline(Delegate &delegate,
+                           const std::vector<std::uint8_t> &syncChannels,
+                           boost::shared_ptr<OpenEphysClockService> clockService);
+    
+    const OpenEphysSyncWordDecoder & getSyncWordDecoder() const { return syncWordDecoder; }
+    const OpenEphysClockModel & getClockModel() const { return clockModel; }
+    OpenEphysSpikeStore * getSpikeStore() const { return spikeStore.get(); }
+    
+    // Sync words are generated (by nextSyncWord) only if an interval is set
+    void setSyncInterval(MWTime interval);
+    // Used until the loopback measurements provide an estimate
+    void setSyncLatency(MWTime latency);
+    void setClockModelFile(const std::string &path, const std::string &key);
+    
+    // A batch interval of zero publishes each spike individually
+    void enableSpikes(MWTime batchInterval);
+    void setSpikeStore(std::unique_ptr<OpenEphysSpikeStore> store);
+    void setSpikeArchive(std::unique_ptr<OpenEphysSpikeArchive> archive);
+    void setSpikeClassifier(std::unique_ptr<OpenEphysSpikeClassifier> classifier);
+    void enableSpikeSummaries(std::unique_ptr<OpenEphysOverloadController> controller, MWTime interval);
+    void enableUnitQuality(std::unique_ptr<OpenEphysUnitQuality> tracker, MWTime interval);
+    
+    bool needsSyncWords() const override { return true; }
+    bool needsSpikes() const override;
+    MWTime getUpdateInterval() const override;
+    std::size_t getMaxEventSize() const override;
+    
+    // Prepares for a new run, starting from the saved clock model (if any).  Returns false if the
+    // spike archive can't be opened.
+    bool reset();
+    // Closes the spike archive, reports statistics, and saves the clock model, after the run's end
+    void stop();
+    
+    void begin() override;
+    void handleEvent(std::uint8_t type, double timestamp, const std::uint8_t *body, std::size_t size) override;
+    void update() override;
+    void end() override;
+    
+    int nextSyncWord();
+    void addSentSyncWord(int value, MWTime sendTime);
+    // Returns true if the loopback provided a new latency sample
+    bool handleSyncLoopback(int value, MWTime receiptTime);
+    bool getSyncLatencyEstimate(double &latency, double &jitter, std::size_t &numSamples) const;
+    
+private:
+    void handleSyncWord(int syncReceived, double timestamp);
+    void handleSpike(const OpenEphysEvent::Spike &event,
+                     double timestamp,
+                     const std::uint8_t *payload,
+                     std::size_t payloadSize);
+    MWTime getSyncLatency() const;
+    void publishSpike(const OpenEphysSpikeRecord &spike);
+    void publishSpikeBatch();
+    void updateOverloadMode(MWTime currentTime);
+    void publishSpikeSummary(MWTime endTime);
+    void publishUnitQuality(MWTime endTime);
+    
+    Delegate &delegate;
+    const OpenEphysSyncWordDecoder syncWordDecoder;
+    const boost::shared_ptr<OpenEphysClockService> clockService;
+    MWTime syncLatency;
+    std::string clockModelFile;
+    std::string clockModelKey;
+    
+    bool spikesEnabled;
+    MWTime spikeBatchInterval;
+    OpenEphysSpikeBatchEncoder spikeBatchEncoder;
+    MWTime spikeBatchStartTime;
+    std::unique_ptr<OpenEphysSpikeStore> spikeStore;
+    std::unique_ptr<OpenEphysSpikeArchive> spikeArchive;
+    std::unique_ptr<OpenEphysSpikeClassifier> spikeClassifier;
+    std::unique_ptr<OpenEphysOverloadController> overloadController;
+    MWTime spikeSummaryInterval;
+    MWTime spikeSummaryStartTime;
+    std::unique_ptr<OpenEphysUnitQuality> unitQualityTracker;
+    MWTime unitQualityInterval;
+    MWTime unitQualityStartTime;
+    bool unitQualityOverflowReported;
+    
+    // Event handler thread state
+    OpenEphysClockModel clockModel;
+    int lastSyncReceived;
+    MWTime lastSyncReceivedTime;
+    MWTime lastSyncReceiptCheckTime;
+    MWTime lastClockQualityPublishTime;
+    OpenEphysClockModel::LockState lastLockState;
+    
+    // Guards the state shared with the sync notifications.  Variables must not be assigned while
+    // holding it, since a notification on one of them could assign sync and wait for the lock.
+    mutable std::mutex mutex;
+    using scoped_lock = std::lock_guard<decltype(mutex)>;
+    
+    std::unique_ptr<OpenEphysSyncSequence> syncSequence;
+    OpenEphysSyncMatcher syncMatcher;
+    OpenEphysSyncLatencyEstimator syncLatencyEstimator;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysEventPipeline_hpp */
@@ -0,0 +1,105 @@
+//
+//  OpenEphysEventReceiver.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysEventReceiver.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+void logZMQError(const char *message) {
+    merror(M_IODEVICE_MESSAGE_DOMAIN, "%s: %s", message, zmq_strerror(zmq_errno()));
+}
+
+
+END_NAMESPACE()
+
+
+OpenEphysEventReceiver::OpenEphysEventReceiver(OpenEphysEventHandler &handler) :
+    handler(handler),
+    socket(nullptr)
+{ }
+
+
+OpenEphysEventReceiver::~OpenEphysEventReceiver() {
+    stop();
+}
+
+
+bool OpenEphysEventReceiver::configure(void *socket) {
+    this->socket = socket;
+    body.resize(handler.getMaxEventSize());
+    
+    const int recvTimeout = std::max(1, int(handler.getUpdateInterval() / 1000));  // ms
+    if (0 != zmq_setsockopt(socket, ZMQ_RCVTIMEO, &recvTimeout, sizeof(recvTimeout))) {
+        logZMQError("Unable to set ZeroMQ socket receive timeout");
+        return false;
+    }
+    
+    return ((!handler.needsSyncWords() || subscribe(OpenEphysEvent::ttlType)) &&
+            (!handler.needsSpikes() || subscribe(OpenEphysEvent::spikeType)));
+}
+
+
+void OpenEphysEventReceiver::start() {
+    if (!thread.joinable()) {
+        continueReceiving.test_and_set();
+        thread = std::thread([this]() {
+            run();
+        });
+    }
+}
+
+
+void OpenEphysEventReceiver::stop() {
+    if (thread.joinable()) {
+        continueReceiving.clear();
+        thread.join();
+    }
+}
+
+
+bool OpenEphysEventReceiver::subscribe(std::uint8_t type) {
+    if (0 != zmq_setsockopt(socket, ZMQ_SUBSCRIBE, &type, sizeof(type))) {
+        logZMQError("Unable to establish ZeroMQ message filter");
+        return false;
+    }
+    return true;
+}
+
+
+void OpenEphysEventReceiver::run() {
+    handler.begin();
+    
+    while (continueReceiving.test_and_set()) {
+        handler.update();
+        
+        std::uint8_t type = 0;
+        double timestamp = 0.0;
+        int size = -1;
+        
+        if (-1 == zmq_recv(socket, &type, sizeof(type), 0) ||
+            -1 == zmq_recv(socket, &timestamp, sizeof(timestamp), ZMQ_DONTWAIT) ||
+            -1 == (size = zmq_recv(socket, body.data(), body.size(), ZMQ_DONTWAIT)))
+        {
+            if (zmq_errno() != EAGAIN) {
+                logZMQError("Received failed on ZeroMQ socket");
+            }
+        } else {
+            // The reported size is that of the whole message part, even if it didn't fit in the buffer
+            handler.handleEvent(type, timestamp, body.data(), std::size_t(size));
+        }
+    }
+    
+    handler.end();
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,54 @@
+//
+//  OpenEphysEventReceiver.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysEventReceiver_hpp
+#define OpenEphysEventReceiver_hpp
+
+#include <zmq.h>
+
+#include "OpenEphysEventHandler.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Receives messages from the Open Ephys Event Broadcaster on a ZeroMQ SUB socket and passes them to an
+// event handler (typically an OpenEphysEventPipeline), on a thread of its own.  The caller creates,
+// connects, and disconnects the socket.
+//
+class OpenEphysEventReceiver : boost::noncopyable {
+    
+public:
+    explicit OpenEphysEventReceiver(OpenEphysEventHandler &handler);
+    ~OpenEphysEventReceiver();
+    
+    // Subscribes the socket to the event types the handler uses, and sets its receive timeout to the
+    // handler's update interval.  Returns false on failure.
+    bool configure(void *socket);
+    
+    void start();
+    void stop();  // Waits for the handler to finish
+    
+private:
+    bool subscribe(std::uint8_t type);
+    void run();
+    
+    OpenEphysEventHandler &handler;
+    void *socket;
+    std::vector<std::uint8_t> body;
+    
+    std::thread thread;
+    std::atomic_flag continueReceiving;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysEventReceiver_hpp */
@@ -20,54 +20,21 @@ inline MWTime currentTimeUS() {
 }
 
 
-inline MWTime secsToUS(double timestamp) {
-    return MWTime(timestamp * 1e6);
+boost::shared_ptr<OpenEphysClockService> createClockService(const ParameterValue &sampleRateParameter) {
+    double sampleRate = 0.0;
+    if (!sampleRateParameter.empty()) {
+        sampleRate = double(sampleRateParameter);
+        if (sampleRate <= 0.0) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Sample rate must be greater than zero");
+        }
+    }
+    return boost::make_shared<OpenEphysClockService>(sampleRate);
 }
 
 
-struct OpenEphysEvent {
-    
-    struct TTL {
-        std::uint8_t nodeID;
-        std::uint8_t eventID;
-        std::uint8_t eventChannel;
-        std::uint8_t _savingFlag;
-        std::uint8_t sourceNodeID;
-        std::uint64_t word;
-    } __attribute__((packed));
-    
-    struct Spike {
-        std::uint8_t evtType;
-        std::uint8_t elecType;
-        std::uint16_t _source;  // Used internally by spike detector
-        std::uint16_t channel;
-        std::uint16_t electrodeID;
-        std::int64_t timestamp;
-        std::uint16_t sortedID;
-
-/*        std::int64_t timestamp;
-        std::int64_t timestampSoftware;
-        std::uint16_t _source;  // Used internally by spike detector
-        std::uint16_t nChannels;
-        std::uint16_t nSamples;
-        std::uint16_t sortedID;
-        std::uint16_t electrodeID;
-        std::uint16_t channel;  */
-        /* Other fields ignored */
-    } __attribute__((packed));
-    
-    union {
-        TTL ttl;
-        Spike spike;
-    };
-    
-};
-
-// Verify packing
-BOOST_STATIC_ASSERT(sizeof(OpenEphysEvent::TTL) == 13);
-//BOOST_STATIC_ASSERT(sizeof(OpenEphysEvent::Spike) == 28);
-BOOST_STATIC_ASSERT(sizeof(OpenEphysEvent::Spike) == 18);
-BOOST_STATIC_ASSERT(sizeof(OpenEphysEvent) == sizeof(OpenEphysEvent::Spike));
+constexpr std::size_t notificationQueueCapacity = 65536;  // Per worker
+constexpr double overloadQueueFillThreshold = 0.5;
+constexpr MWTime overloadMinDwellTime = 1000000;  // 1 second
 
 
 END_NAMESPACE()
@@ -75,8 +42,36 @@ END_NAMESPACE()
 
 const std::string OpenEphysInterface::SYNC("sync");
 const std::string OpenEphysInterface::SYNC_CHANNELS("sync_channels");
+const std::string OpenEphysInterface::SYNC_INTERVAL("sync_interval");
+const std::string OpenEphysInterface::SYNC_LATENCY("sync_latency");
+const std::string OpenEphysInterface::SYNC_LOOPBACK("sync_loopback");
+const std::string OpenEphysInterface::SYNC_LATENCY_REPORT("sync_latency_report");
 const std::string OpenEphysInterface::CLOCK_OFFSET("clock_offset");
+const std::string OpenEphysInterface::CLOCK_MODEL_FILE("clock_model_file");
+const std::string OpenEphysInterface::CLOCK_LOCK_STATE("clock_lock_state");
+const std::string OpenEphysInterface::CLOCK_UNCERTAINTY("clock_uncertainty");
+const std::string OpenEphysInterface::CLOCK_SYNC_AGE("clock_sync_age");
+const std::string OpenEphysInterface::SAMPLE_RATE("sample_rate");
 const std::string OpenEphysInterface::SPIKES("spikes");
+const std::string OpenEphysInterface::SPIKE_FIELDS("spike_fields");
+const std::string OpenEphysInterface::SPIKE_ENCODING("spike_encoding");
+const std::string OpenEphysInterface::SPIKE_BATCH_INTERVAL("spike_batch_interval");
+const std::string OpenEphysInterface::SPIKE_HISTORY_SIZE("spike_history_size");
+const std::string OpenEphysInterface::SPIKE_QUERY("spike_query");
+const std::string OpenEphysInterface::SPIKE_QUERY_RESULT("spike_query_result");
+const std::string OpenEphysInterface::SPIKE_ARCHIVE("spike_archive");
+const std::string OpenEphysInterface::SPIKE_TEMPLATES("spike_templates");
+const std::string OpenEphysInterface::SPIKE_TEMPLATE_MAX_DISTANCE("spike_template_max_distance");
+const std::string OpenEphysInterface::NOTIFICATION_WORKERS("notification_workers");
+const std::string OpenEphysInterface::SPIKE_SUMMARY("spike_summary");
+const std::string OpenEphysInterface::SPIKE_SUMMARY_INTERVAL("spike_summary_interval");
+const std::string OpenEphysInterface::OVERLOAD_LAG_THRESHOLD("overload_lag_threshold");
+const std::string OpenEphysInterface::OVERLOAD_MODE("overload_mode");
+const std::string OpenEphysInterface::UNIT_QUALITY("unit_quality");
+const std::string OpenEphysInterface::UNIT_QUALITY_INTERVAL("unit_quality_interval");
+const std::string OpenEphysInterface::REFRACTORY_PERIOD("refractory_period");
+const std::string OpenEphysInterface::BURST_MAX_ISI("burst_max_isi");
+const std::string OpenEphysInterface::BURST_MIN_SPIKES("burst_min_spikes");
 
 
 void OpenEphysInterface::describeComponent(ComponentInfo &info) {
@@ -86,43 +81,190 @@ void OpenEphysInterface::describeComponent(ComponentInfo &info) {
     
     info.addParameter(SYNC);
     info.addParameter(SYNC_CHANNELS);
+    info.addParameter(SYNC_INTERVAL, false);
+    info.addParameter(SYNC_LATENCY, "0");
+    info.addParameter(SYNC_LOOPBACK, false);
+    info.addParameter(SYNC_LATENCY_REPORT, false);
     info.addParameter(CLOCK_OFFSET, false);
+    info.addParameter(CLOCK_MODEL_FILE, false);
+    info.addParameter(CLOCK_LOCK_STATE, false);
+    info.addParameter(CLOCK_UNCERTAINTY, false);
+    info.addParameter(CLOCK_SYNC_AGE, false);
+    info.addParameter(SAMPLE_RATE, false);
     info.addParameter(SPIKES, false);
+    info.addParameter(SPIKE_FIELDS, "oe_timestamp, sorted_id, electrode_id, channel");
+    info.addParameter(SPIKE_ENCODING, "dictionary");
+    info.addParameter(SPIKE_BATCH_INTERVAL, "10ms");
+    info.addParameter(SPIKE_HISTORY_SIZE, "1000");
+    info.addParameter(SPIKE_QUERY, false);
+    info.addParameter(SPIKE_QUERY_RESULT, false);
+    info.addParameter(SPIKE_ARCHIVE, false);
+    info.addParameter(SPIKE_TEMPLATES, false);
+    info.addParameter(SPIKE_TEMPLATE_MAX_DISTANCE, "0");
+    info.addParameter(NOTIFICATION_WORKERS, "0");
+    info.addParameter(SPIKE_SUMMARY, false);
+    info.addParameter(SPIKE_SUMMARY_INTERVAL, "100ms");
+    info.addParameter(OVERLOAD_LAG_THRESHOLD, "50ms");
+    info.addParameter(OVERLOAD_MODE, false);
+    info.addParameter(UNIT_QUALITY, false);
+    info.addParameter(UNIT_QUALITY_INTERVAL, "1s");
+    info.addParameter(REFRACTORY_PERIOD, "1.5ms");
+    info.addParameter(BURST_MAX_ISI, "10ms");
+    info.addParameter(BURST_MIN_SPIKES, "3");
 }
 
 
 OpenEphysInterface::OpenEphysInterface(const ParameterValueMap &parameters) :
     OpenEphysBase(parameters),
     sync(parameters[SYNC]),
-    running(false),
-    lastSyncTime(0),
-    lastSyncValue(-1)
+    syncInterval(0),
+    spikeEncoding(SpikeEncoding::Dictionary),
+    clockService(createClockService(parameters[SAMPLE_RATE])),
+    pipeline(*this, parseSyncChannels(parameters[SYNC_CHANNELS].str()), clockService),
+    receiver(pipeline),
+    running(false)
 {
-    std::vector<Datum> syncChannelsValues;
-    ParsedExpressionVariable::evaluateExpressionList(parameters[SYNC_CHANNELS].str(), syncChannelsValues);
-    for (auto &channel : syncChannelsValues) {
-        auto channelNumber = channel.getInteger();
-        if (channelNumber < 1 || channelNumber > 8) {
-            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid sync channel number");
-        }
-        syncChannels.push_back(channelNumber - 1);
+    if (!parameters[SYNC_INTERVAL].empty()) {
+        syncInterval = MWTime(parameters[SYNC_INTERVAL]);
+        pipeline.setSyncInterval(syncInterval);
     }
-    if (syncChannels.empty()) {
-        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "At least one sync channel is required");
+    
+    pipeline.setSyncLatency(MWTime(parameters[SYNC_LATENCY]));
+    
+    if (!parameters[SYNC_LOOPBACK].empty()) {
+        syncLoopback = VariablePtr(parameters[SYNC_LOOPBACK]);
+    }
+    
+    if (!parameters[SYNC_LATENCY_REPORT].empty()) {
+        syncLatencyReport = VariablePtr(parameters[SYNC_LATENCY_REPORT]);
     }
     
     if (!parameters[CLOCK_OFFSET].empty()) {
         clockOffset = VariablePtr(parameters[CLOCK_OFFSET]);
     }
     
+    if (!parameters[CLOCK_MODEL_FILE].empty()) {
+        pipeline.setClockModelFile(parameters[CLOCK_MODEL_FILE].str(), endpoint);
+    }
+    
+    if (!parameters[CLOCK_LOCK_STATE].empty()) {
+        clockLockState = VariablePtr(parameters[CLOCK_LOCK_STATE]);
+    }
+    
+    if (!parameters[CLOCK_UNCERTAINTY].empty()) {
+        clockUncertainty = VariablePtr(parameters[CLOCK_UNCERTAINTY]);
+    }
+    
+    if (!parameters[CLOCK_SYNC_AGE].empty()) {
+        clockSyncAge = VariablePtr(parameters[CLOCK_SYNC_AGE]);
+    }
+    
+    const auto spikeFields = OpenEphysSpikeDatumBuilder::parseFields(parameters[SPIKE_FIELDS].str());
+    
+    const std::string encoding = parameters[SPIKE_ENCODING].str();
+    if (encoding == "compact") {
+        spikeEncoding = SpikeEncoding::Compact;
+    } else if (encoding == "scalar") {
+        spikeEncoding = SpikeEncoding::Scalar;
+    } else if (encoding != "dictionary") {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid spike encoding", encoding);
+    }
+    spikeDatumBuilder.reset(new OpenEphysSpikeDatumBuilder(spikeFields, spikeEncoding == SpikeEncoding::Scalar));
+    
     if (!parameters[SPIKES].empty()) {
         spikes = VariablePtr(parameters[SPIKES]);
+        
+        MWTime spikeBatchInterval = 0;
+        if (spikeEncoding == SpikeEncoding::Compact) {
+            spikeBatchInterval = MWTime(parameters[SPIKE_BATCH_INTERVAL]);
+            if (spikeBatchInterval <= 0) {
+                throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Spike batch interval must be greater than zero");
+            }
+        }
+        pipeline.enableSpikes(spikeBatchInterval);
+    }
+    
+    if (!parameters[SPIKE_QUERY].empty()) {
+        if (parameters[SPIKE_QUERY_RESULT].empty()) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                  "Spike query result variable is required when spike query is provided");
+        }
+        spikeQuery = VariablePtr(parameters[SPIKE_QUERY]);
+        spikeQueryResult = VariablePtr(parameters[SPIKE_QUERY_RESULT]);
+        
+        const long historySize(parameters[SPIKE_HISTORY_SIZE]);
+        if (historySize < 1) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Spike history size must be at least 1");
+        }
+        pipeline.setSpikeStore(std::unique_ptr<OpenEphysSpikeStore>(new OpenEphysSpikeStore(historySize)));
+    }
+    
+    if (!parameters[SPIKE_TEMPLATES].empty()) {
+        std::unique_ptr<OpenEphysSpikeClassifier> spikeClassifier(new OpenEphysSpikeClassifier(double(parameters[SPIKE_TEMPLATE_MAX_DISTANCE])));
+        spikeClassifier->loadTemplates(parameters[SPIKE_TEMPLATES].str());
+        if (spikeClassifier->getNumTemplates() == 0) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                  "Spike template file contains no templates",
+                                  parameters[SPIKE_TEMPLATES].str());
+        }
+        pipeline.setSpikeClassifier(std::move(spikeClassifier));
+    } else if (spikeDatumBuilder->hasField(OpenEphysSpikeDatumBuilder::Field::ClassifiedID)) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Spike field classified_id requires spike templates");
+    }
+    
+    if (!parameters[SPIKE_ARCHIVE].empty()) {
+        pipeline.setSpikeArchive(std::unique_ptr<OpenEphysSpikeArchive>(new OpenEphysSpikeArchive(parameters[SPIKE_ARCHIVE].str())));
+    }
+    
+    const long numNotificationWorkers(parameters[NOTIFICATION_WORKERS]);
+    if (numNotificationWorkers < 0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Number of notification workers cannot be negative");
+    }
+    if (numNotificationWorkers > 0) {
+        notificationDispatcher.reset(new OpenEphysNotificationDispatcher(numNotificationWorkers,
+                                                                         notificationQueueCapacity));
+    }
+    
+    if (!parameters[SPIKE_SUMMARY].empty()) {
+        if (!spikes) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Spike summaries require a spikes variable");
+        }
+        spikeSummary = VariablePtr(parameters[SPIKE_SUMMARY]);
+        std::unique_ptr<OpenEphysOverloadController> overloadController(new OpenEphysOverloadController(MWTime(parameters[OVERLOAD_LAG_THRESHOLD]),
+                                                                                                        overloadQueueFillThreshold,
+                                                                                                        overloadMinDwellTime));
+        pipeline.enableSpikeSummaries(std::move(overloadController), MWTime(parameters[SPIKE_SUMMARY_INTERVAL]));
+        if (!parameters[OVERLOAD_MODE].empty()) {
+            overloadMode = VariablePtr(parameters[OVERLOAD_MODE]);
+        }
+    }
+    
+    if (!parameters[UNIT_QUALITY].empty()) {
+        const MWTime refractoryPeriod(parameters[REFRACTORY_PERIOD]);
+        if (refractoryPeriod <= 0) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Refractory period must be greater than zero");
+        }
+        const MWTime burstMaxISI(parameters[BURST_MAX_ISI]);
+        if (burstMaxISI <= 0) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Burst maximum ISI must be greater than zero");
+        }
+        const long burstMinSpikes(parameters[BURST_MIN_SPIKES]);
+        if (burstMinSpikes < 2) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Burst minimum spikes must be at least 2");
+        }
+        unitQuality = VariablePtr(parameters[UNIT_QUALITY]);
+        std::unique_ptr<OpenEphysUnitQuality> unitQualityTracker(new OpenEphysUnitQuality(refractoryPeriod, burstMaxISI, burstMinSpikes));
+        pipeline.enableUnitQuality(std::move(unitQualityTracker), MWTime(parameters[UNIT_QUALITY_INTERVAL]));
     }
 }
 
 
 OpenEphysInterface::~OpenEphysInterface() {
-    terminateEventHandlerThread();
+    OpenEphysClockService::unregisterService(endpoint, clockService);
+    if (syncTask) {
+        syncTask->cancel();
+    }
+    receiver.stop();
 }
 
 
@@ -133,21 +275,35 @@ bool OpenEphysInterface::initialize() {
         return false;
     }
     
-    const int recvTimeout = 500;  // ms
-    if (0 != zmq_setsockopt(zmqSocket.get(), ZMQ_RCVTIMEO, &recvTimeout, sizeof(recvTimeout))) {
-        logZMQError("Unable to set ZeroMQ socket receive timeout");
+    if (!receiver.configure(zmqSocket.get())) {
         return false;
     }
     
-    if (!subscribeToEventType(TTL) ||
-        (spikes && !subscribeToEventType(SPIKE)))
-    {
-        return false;
-    }
+    OpenEphysClockService::registerService(endpoint, clockService);
     
     auto notification = boost::make_shared<SyncNotification>(component_shared_from_this<OpenEphysInterface>());
     sync->addNotification(notification);
     
+    if (syncLoopback) {
+        boost::weak_ptr<OpenEphysInterface> weakThis(component_shared_from_this<OpenEphysInterface>());
+        auto loopbackNotification = [weakThis](const Datum &data, MWTime time) {
+            if (auto sharedThis = weakThis.lock()) {
+                sharedThis->handleSyncLoopback(data.getInteger(), time);
+            }
+        };
+        syncLoopback->addNotification(boost::make_shared<VariableCallbackNotification>(loopbackNotification));
+    }
+    
+    if (spikeQuery) {
+        boost::weak_ptr<OpenEphysInterface> weakThis(component_shared_from_this<OpenEphysInterface>());
+        auto queryNotification = [weakThis](const Datum &data, MWTime time) {
+            if (auto sharedThis = weakThis.lock()) {
+                sharedThis->handleSpikeQuery(data);
+            }
+        };
+        spikeQuery->addNotification(boost::make_shared<VariableCallbackNotification>(queryNotification));
+    }
+    
     return true;
 }
 
@@ -161,10 +317,36 @@ bool OpenEphysInterface::startDeviceIO() {
             return false;
         }
         
-        continueHandlingEvents.test_and_set();
-        eventHandlerThread = std::thread([this]() {
-            handleEvents();
-        });
+        if (!pipeline.reset()) {
+            if (0 != zmq_disconnect(zmqSocket.get(), endpoint.c_str())) {
+                logZMQError("Unable to disconnect from Open Ephys GUI");
+            }
+            return false;
+        }
+        
+        if (notificationDispatcher) {
+            notificationDispatcher->start();
+        }
+        
+        receiver.start();
+        
+        if (syncInterval > 0) {
+            boost::weak_ptr<OpenEphysInterface> weakThis(component_shared_from_this<OpenEphysInterface>());
+            syncTask = Scheduler::instance()->scheduleUS(FILELINE,
+                                                         0,
+                                                         syncInterval,
+                                                         M_REPEAT_INDEFINITELY,
+                                                         [weakThis]() {
+                                                             if (auto sharedThis = weakThis.lock()) {
+                                                                 sharedThis->sendNextSyncWord();
+                                                             }
+                                                             return nullptr;
+                                                         },
+                                                         M_DEFAULT_IODEVICE_PRIORITY,
+                                                         M_DEFAULT_IODEVICE_WARN_SLOP_US,
+                                                         M_DEFAULT_IODEVICE_FAIL_SLOP_US,
+                                                         M_MISSED_EXECUTION_DROP);
+        }
         
         running = true;
     }
@@ -177,7 +359,23 @@ bool OpenEphysInterface::stopDeviceIO() {
     scoped_lock lock(mutex);
     
     if (running) {
-        terminateEventHandlerThread();
+        if (syncTask) {
+            syncTask->cancel();
+            syncTask.reset();
+        }
+        
+        receiver.stop();
+        if (notificationDispatcher) {
+            notificationDispatcher->stop();
+        }
+        
+        pipeline.stop();
+        
+        if (notificationDispatcher && notificationDispatcher->getNumDropped() > 0) {
+            merror(M_IODEVICE_MESSAGE_DOMAIN,
+                   "Open Ephys notification queue overflowed; %lu spike values were dropped",
+                   (unsigned long)notificationDispatcher->getNumDropped());
+        }
         
         if (0 != zmq_disconnect(zmqSocket.get(), endpoint.c_str())) {
             logZMQError("Unable to disconnect from Open Ephys GUI");
@@ -191,109 +389,206 @@ bool OpenEphysInterface::stopDeviceIO() {
 }
 
 
-bool OpenEphysInterface::subscribeToEventType(std::uint8_t type) {
-    if (0 != zmq_setsockopt(zmqSocket.get(), ZMQ_SUBSCRIBE, &type, sizeof(type))) {
-        logZMQError("Unable to establish ZeroMQ message filter");
-        return false;
+void OpenEphysInterface::sendNextSyncWord() {
+    // The sync notification records the send time
+    sync->setValue(Datum(pipeline.nextSyncWord()));
+}
+
+
+void OpenEphysInterface::handleSyncLoopback(int syncValue, MWTime receiptTime) {
+    if (pipeline.handleSyncLoopback(syncValue, receiptTime)) {
+        reportSyncLatency();
+    }
+}
+
+
+void OpenEphysInterface::reportSyncLatency() {
+    if (!syncLatencyReport) {
+        return;
     }
     
-    return true;
+    double latency = 0.0, jitter = 0.0;
+    std::size_t numSamples = 0;
+    if (!pipeline.getSyncLatencyEstimate(latency, jitter, numSamples)) {
+        return;
+    }
+    
+    Datum report(M_DICTIONARY, 3);
+    report.addElement("latency", latency);
+    report.addElement("jitter", jitter);
+    report.addElement("num_samples", (long long)numSamples);
+    syncLatencyReport->setValue(report);
+}
+
+
+void OpenEphysInterface::assignValue(const VariablePtr &variable, const Datum &value, MWTime time) {
+    if (notificationDispatcher) {
+        notificationDispatcher->setControlValue(variable, value, time);
+    } else {
+        variable->setValue(value, time);
+    }
+}
+
+
+void OpenEphysInterface::assignSpikeValue(const Datum &value, MWTime time) {
+    if (notificationDispatcher) {
+        notificationDispatcher->setValue(spikes, value, time);
+    } else {
+        spikes->setValue(value, time);
+    }
 }
 
 
-void OpenEphysInterface::handleEvents() {
-    int lastSyncReceived = -1;
-    MWTime oeClockOffset = 0;
+void OpenEphysInterface::handleSpikeQuery(const Datum &query) {
+    if (!query.isDictionary()) {
+        merror(M_IODEVICE_MESSAGE_DOMAIN, "Open Ephys spike query must be a dictionary");
+        return;
+    }
     
-    constexpr MWTime syncReceiptCheckInterval = 5000000;  // 5 seconds
-    MWTime lastSyncReceivedTime = currentTimeUS();
-    MWTime lastSyncReceiptCheckTime = lastSyncReceivedTime;
+    const Datum electrodeID = query.getElement("electrode_id");
+    const Datum sortedID = query.getElement("sorted_id");
+    const Datum start = query.getElement("start");
+    if (!electrodeID.isNumber() || !sortedID.isNumber() || !start.isNumber()) {
+        merror(M_IODEVICE_MESSAGE_DOMAIN,
+               "Open Ephys spike query must include electrode_id, sorted_id, and start");
+        return;
+    }
     
-    while (continueHandlingEvents.test_and_set()) {
-        const MWTime currentSyncReceiptCheckTime = currentTimeUS();
-        if (currentSyncReceiptCheckTime - lastSyncReceiptCheckTime >= syncReceiptCheckInterval) {
-            merror(M_IODEVICE_MESSAGE_DOMAIN,
-                   "No Open Ephys clock sync received after %g seconds",
-                   std::round(double(currentSyncReceiptCheckTime - lastSyncReceivedTime) / 1e6));
-            lastSyncReceiptCheckTime = currentSyncReceiptCheckTime;
-        }
-        
-        std::uint8_t eventType = 0;
-        double eventTimestamp = 0.0;
-        OpenEphysEvent event;
-        std::memset(&event, 0, sizeof(event));
-        
-        if (-1 == zmq_recv(zmqSocket.get(), &eventType, sizeof(eventType), 0) ||
-            -1 == zmq_recv(zmqSocket.get(), &eventTimestamp, sizeof(eventTimestamp), ZMQ_DONTWAIT) ||
-            -1 == zmq_recv(zmqSocket.get(), &event, sizeof(event), ZMQ_DONTWAIT))
-        {
-            
-            if (zmq_errno() != EAGAIN) {
-                logZMQError("Received failed on ZeroMQ socket");
-            }
-            
-        } else if (TTL == eventType) {
-            
-            int syncReceived = 0;
-            
-            for (std::size_t i = 0; i < syncChannels.size(); i++) {
-                bool channelState = event.ttl.word & (1 << syncChannels.at(i));
-                syncReceived |= int(channelState) << i;
-            }
-            
-            if (syncReceived != lastSyncReceived) {
-                scoped_lock lock(mutex);
-                
-                lastSyncReceived = syncReceived;
-                lastSyncReceivedTime = currentTimeUS();
-                lastSyncReceiptCheckTime = lastSyncReceivedTime;
-                
-                if (syncReceived == lastSyncValue) {
-                    oeClockOffset = lastSyncTime - secsToUS(eventTimestamp);
-                    if (clockOffset) {
-                        clockOffset->setValue(oeClockOffset);
-                    }
-                } else {
-                    merror(M_IODEVICE_MESSAGE_DOMAIN,
-                           "Open Ephys clock sync has unexpected value: sent %d, received %d",
-                           lastSyncValue,
-                           syncReceived);
-                }
-            }
-            
-        } else if (SPIKE == eventType) {
-            
-            if (spikes) {
-                Datum info(M_DICTIONARY, 4);
-                info.addElement("oe_timestamp", event.spike.timestamp);
-                info.addElement("sorted_id", event.spike.sortedID);
-                info.addElement("electrode_id", event.spike.electrodeID);
-                info.addElement("channel", event.spike.channel);
-                spikes->setValue(info, secsToUS(eventTimestamp) + oeClockOffset);
-            }
-        
-        } else {
-            
-            merror(M_IODEVICE_MESSAGE_DOMAIN, "Open Ephys event has unexpected type (%hhu)", eventType);
-            
+    const Datum end = query.getElement("end");
+    const MWTime endTime = (end.isNumber() ? MWTime(end.getInteger()) : currentTimeUS());
+    const Datum fetch = query.getElement("fetch");
+    
+    if (fetch.isUndefined() || !fetch.getBool()) {
+        const auto count = pipeline.getSpikeStore()->count(electrodeID.getInteger(), sortedID.getInteger(), start.getInteger(), endTime);
+        spikeQueryResult->setValue(Datum((long long)count));
+    } else {
+        const auto times = pipeline.getSpikeStore()->fetch(electrodeID.getInteger(), sortedID.getInteger(), start.getInteger(), endTime);
+        Datum result(M_LIST, int(times.size()));
+        for (auto time : times) {
+            result.addElement(Datum(time));
         }
+        spikeQueryResult->setValue(result);
+    }
+}
+
+
+MWTime OpenEphysInterface::getCurrentTime() {
+    return currentTimeUS();
+}
+
+
+double OpenEphysInterface::getQueueFill() {
+    if (!notificationDispatcher) {
+        return 0.0;
+    }
+    return double(notificationDispatcher->getQueueDepth()) / double(notificationDispatcher->getQueueCapacity());
+}
+
+
+void OpenEphysInterface::publishClockOffset(MWTime offset, MWTime time) {
+    if (clockOffset) {
+        assignValue(clockOffset, Datum(offset), time);
+    }
+}
+
+
+void OpenEphysInterface::publishClockQuality(const OpenEphysClockModel &clockModel, MWTime currentTime) {
+    if (clockLockState) {
+        assignValue(clockLockState,
+                    Datum(OpenEphysClockModel::getLockStateName(clockModel.getLockState(currentTime))),
+                    currentTime);
+    }
+    if (clockUncertainty) {
+        // Without a model, the uncertainty is unbounded, which we report as -1
+        const double uncertainty = clockModel.getCurrentUncertainty(currentTime);
+        assignValue(clockUncertainty, Datum(std::isfinite(uncertainty) ? uncertainty : -1.0), currentTime);
+    }
+    if (clockSyncAge) {
+        assignValue(clockSyncAge, Datum(clockModel.getSyncAge(currentTime)), currentTime);
+    }
+}
+
+
+void OpenEphysInterface::publishSpike(const OpenEphysSpikeRecord &spike) {
+    assignSpikeValue(spikeDatumBuilder->build(spike), spike.time);
+}
+
+
+void OpenEphysInterface::publishSpikeBatch(const std::string &batch, MWTime firstSpikeTime) {
+    assignSpikeValue(Datum(batch), firstSpikeTime);
+}
+
+
+void OpenEphysInterface::publishOverloadMode(OpenEphysOverloadController::Mode mode, MWTime time) {
+    if (overloadMode) {
+        assignValue(overloadMode, Datum(OpenEphysOverloadController::getModeName(mode)), time);
     }
 }
 
 
-void OpenEphysInterface::terminateEventHandlerThread() {
-    if (eventHandlerThread.joinable()) {
-        continueHandlingEvents.clear();
-        eventHandlerThread.join();
+void OpenEphysInterface::publishSpikeSummary(MWTime start,
+                                             MWTime end,
+                                             const std::vector<OpenEphysOverloadController::UnitCount> &counts)
+{
+    Datum unitCounts(M_LIST, int(counts.size()));
+    for (auto &unitCount : counts) {
+        Datum entry(M_DICTIONARY, 3);
+        entry.addElement("electrode_id", unitCount.electrodeID);
+        entry.addElement("sorted_id", unitCount.sortedID);
+        entry.addElement("count", (long long)unitCount.count);
+        unitCounts.addElement(entry);
     }
+    
+    Datum summary(M_DICTIONARY, 3);
+    summary.addElement("start", start);
+    summary.addElement("end", end);
+    summary.addElement("counts", unitCounts);
+    assignValue(spikeSummary, summary, end);
+}
+
+
+void OpenEphysInterface::publishUnitQuality(MWTime start,
+                                            MWTime end,
+                                            const std::vector<OpenEphysUnitQuality::UnitStats> &stats,
+                                            const std::vector<MWTime> &binEdges)
+{
+    Datum units(M_LIST, int(stats.size()));
+    for (auto &unitStats : stats) {
+        Datum histogram(M_LIST, int(unitStats.histogram.size()));
+        for (auto count : unitStats.histogram) {
+            histogram.addElement(Datum((long long)count));
+        }
+        
+        const double isiCount = double(unitStats.isiCount);
+        Datum entry(M_DICTIONARY, 8);
+        entry.addElement("electrode_id", unitStats.electrodeID);
+        entry.addElement("sorted_id", unitStats.sortedID);
+        entry.addElement("count", (long long)unitStats.spikeCount);
+        entry.addElement("isi_histogram", histogram);
+        entry.addElement("refractory_violations", (long long)unitStats.refractoryViolations);
+        entry.addElement("violation_rate", (isiCount > 0.0 ? double(unitStats.refractoryViolations) / isiCount : 0.0));
+        entry.addElement("bursts", (long long)unitStats.burstCount);
+        entry.addElement("burst_fraction", double(unitStats.burstSpikeCount) / double(unitStats.spikeCount));
+        units.addElement(entry);
+    }
+    
+    Datum isiBinEdges(M_LIST, int(binEdges.size()));
+    for (auto edge : binEdges) {
+        isiBinEdges.addElement(Datum(double(edge) / 1e6));
+    }
+    
+    Datum quality(M_DICTIONARY, 4);
+    quality.addElement("start", start);
+    quality.addElement("end", end);
+    quality.addElement("isi_bin_edges", isiBinEdges);
+    quality.addElement("units", units);
+    assignValue(unitQuality, quality, end);
 }
 
 
 void OpenEphysInterface::SyncNotification::notify(const Datum &data, MWTime time) {
     if (auto oeInterface = oeInterfaceWeak.lock()) {
-        scoped_lock lock(oeInterface->mutex);
-        oeInterface->lastSyncTime = time;
-        oeInterface->lastSyncValue = data.getInteger();
+        oeInterface->pipeline.addSentSyncWord(data.getInteger(), time);
     }
 }
 
@@ -10,18 +10,55 @@
 #define __OpenEphys__OpenEphysInterface__
 
 #include "OpenEphysBase.hpp"
+#include "OpenEphysEventPipeline.hpp"
+#include "OpenEphysEventReceiver.hpp"
+#include "OpenEphysNotificationDispatcher.hpp"
+#include "OpenEphysSpikeDatumBuilder.hpp"
 
 
 BEGIN_NAMESPACE_MW
 
 
-class OpenEphysInterface : public OpenEphysBase {
+//
+// Connects an event pipeline to MWorks: the interface's parameters configure the pipeline, sync words
+// are sent and looped back through variables, and the pipeline's results are published by assigning
+// variables.  The pipeline itself runs on the thread of an event receiver.
+//
+class OpenEphysInterface : public OpenEphysBase, private OpenEphysEventPipeline::Delegate {
     
 public:
     static const std::string SYNC;
     static const std::string SYNC_CHANNELS;
+    static const std::string SYNC_INTERVAL;
+    static const std::string SYNC_LATENCY;
+    static const std::string SYNC_LOOPBACK;
+    static const std::string SYNC_LATENCY_REPORT;
     static const std::string CLOCK_OFFSET;
+    static const std::string CLOCK_MODEL_FILE;
+    static const std::string CLOCK_LOCK_STATE;
+    static const std::string CLOCK_UNCERTAINTY;
+    static const std::string CLOCK_SYNC_AGE;
+    static const std::string SAMPLE_RATE;
     static const std::string SPIKES;
+    static const std::string SPIKE_FIELDS;
+    static const std::string SPIKE_ENCODING;
+    static const std::string SPIKE_BATCH_INTERVAL;
+    static const std::string SPIKE_HISTORY_SIZE;
+    static const std::string SPIKE_QUERY;
+    static const std::string SPIKE_QUERY_RESULT;
+    static const std::string SPIKE_ARCHIVE;
+    static const std::string SPIKE_TEMPLATES;
+    static const std::string SPIKE_TEMPLATE_MAX_DISTANCE;
+    static const std::string NOTIFICATION_WORKERS;
+    static const std::string SPIKE_SUMMARY;
+    static const std::string SPIKE_SUMMARY_INTERVAL;
+    static const std::string OVERLOAD_LAG_THRESHOLD;
+    static const std::string OVERLOAD_MODE;
+    static const std::string UNIT_QUALITY;
+    static const std::string UNIT_QUALITY_INTERVAL;
+    static const std::string REFRACTORY_PERIOD;
+    static const std::string BURST_MAX_ISI;
+    static const std::string BURST_MIN_SPIKES;
     
     static void describeComponent(ComponentInfo &info);
     
@@ -33,28 +70,61 @@ public:
     bool stopDeviceIO() override;
     
 private:
-//    static constexpr std::uint8_t TTL = 3;
-//    static constexpr std::uint8_t SPIKE = 4;
-    static constexpr std::uint16_t TTL = 3;
-    static constexpr std::uint16_t SPIKE = 2;
-
-    bool subscribeToEventType(std::uint8_t type);
-    void handleEvents();
-    void terminateEventHandlerThread();
+    enum class SpikeEncoding { Dictionary, Compact, Scalar };
+    
+    void sendNextSyncWord();
+    void handleSyncLoopback(int syncValue, MWTime receiptTime);
+    void reportSyncLatency();
+    // Never dropped, even if the notification queue is full
+    void assignValue(const VariablePtr &variable, const Datum &value, MWTime time);
+    // Dropped if the notification queue is full
+    void assignSpikeValue(const Datum &value, MWTime time);
+    void handleSpikeQuery(const Datum &query);
+    
+    // OpenEphysEventPipeline::Delegate
+    MWTime getCurrentTime() override;
+    double getQueueFill() override;
+    void publishClockOffset(MWTime offset, MWTime time) override;
+    void publishClockQuality(const OpenEphysClockModel &clockModel, MWTime currentTime) override;
+    void publishSpike(const OpenEphysSpikeRecord &spike) override;
+    void publishSpikeBatch(const std::string &batch, MWTime firstSpikeTime) override;
+    void publishOverloadMode(OpenEphysOverloadController::Mode mode, MWTime time) override;
+    void publishSpikeSummary(MWTime start,
+                             MWTime end,
+                             const std::vector<OpenEphysOverloadController::UnitCount> &counts) override;
+    void publishUnitQuality(MWTime start,
+                            MWTime end,
+                            const std::vector<OpenEphysUnitQuality::UnitStats> &stats,
+                            const std::vector<MWTime> &binEdges) override;
     
     const VariablePtr sync;
-    std::vector<std::uint8_t> syncChannels;
+    MWTime syncInterval;
+    boost::shared_ptr<ScheduleTask> syncTask;
+    VariablePtr syncLoopback;
+    VariablePtr syncLatencyReport;
     VariablePtr clockOffset;
+    VariablePtr clockLockState;
+    VariablePtr clockUncertainty;
+    VariablePtr clockSyncAge;
     VariablePtr spikes;
+    SpikeEncoding spikeEncoding;
+    std::unique_ptr<OpenEphysSpikeDatumBuilder> spikeDatumBuilder;
+    VariablePtr spikeQuery;
+    VariablePtr spikeQueryResult;
+    std::unique_ptr<OpenEphysNotificationDispatcher> notificationDispatcher;
+    VariablePtr spikeSummary;
+    VariablePtr overloadMode;
+    VariablePtr unitQuality;
+    
+    boost::shared_ptr<OpenEphysClockService> clockService;
+    OpenEphysEventPipeline pipeline;
+    OpenEphysEventReceiver receiver;
     
-    std::thread eventHandlerThread;
-    std::atomic_flag continueHandlingEvents;
+    // Guards running, and the starting and stopping of the receiver and the sync task
     std::mutex mutex;
     using scoped_lock = std::lock_guard<decltype(mutex)>;
     
     bool running;
-    MWTime lastSyncTime;
-    int lastSyncValue;
     
     
     class SyncNotification : public VariableNotification {
@@ -51,16 +51,7 @@ bool OpenEphysNetworkEventsClient::initialize() {
         return false;
     }
     
-    const int linger = 0;
-    const int timeout = 1000;  // ms
-    const int immediate = 1;
-    if (0 != zmq_setsockopt(zmqSocket.get(), ZMQ_LINGER, &linger, sizeof(linger)) ||
-        0 != zmq_setsockopt(zmqSocket.get(), ZMQ_RCVTIMEO, &timeout, sizeof(timeout)) ||
-        0 != zmq_setsockopt(zmqSocket.get(), ZMQ_SNDTIMEO, &timeout, sizeof(timeout)) ||
-        // Make zmq_send fail if we're not connected (instead of queuing the request for later)
-        0 != zmq_setsockopt(zmqSocket.get(), ZMQ_IMMEDIATE, &immediate, sizeof(immediate)))
-    {
-        logZMQError("Unable to set ZeroMQ socket timeouts");
+    if (!requester.configure(zmqSocket.get())) {
         return false;
     }
     
@@ -86,19 +77,10 @@ bool OpenEphysNetworkEventsClient::initialize() {
 
 
 void OpenEphysNetworkEventsClient::sendRequest(const std::string &req) {
-    if (-1 == zmq_send(zmqSocket.get(), req.data(), req.size(), 0)) {
-        logZMQError("Unable to send request to Open Ephys network events module");
-        return;
+    std::string rep;
+    if (requester.sendRequest(req, rep)) {
+        response->setValue(Datum(rep));
     }
-    
-    std::vector<char> rep(1024);
-    int repSize;
-    if (-1 == (repSize = zmq_recv(zmqSocket.get(), rep.data(), rep.size(), 0))) {
-        logZMQError("Failed to receive response from Open Ephys network events module");
-        return;
-    }
-    
-    response->setValue(Datum(std::string(rep.data(), repSize)));
 }
 
 
@@ -11,6 +11,7 @@
 
 
 #include "OpenEphysBase.hpp"
+#include "OpenEphysNetworkEventsRequester.hpp"
 
 
 BEGIN_NAMESPACE_MW
@@ -34,6 +35,7 @@ private:
     
     const VariablePtr request;
     const VariablePtr response;
+    OpenEphysNetworkEventsRequester requester;
     
 };
 
@@ -0,0 +1,73 @@
+//
+//  OpenEphysNetworkEventsRequester.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysNetworkEventsRequester.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+void logZMQError(const char *message) {
+    merror(M_IODEVICE_MESSAGE_DOMAIN, "%s: %s", message, zmq_strerror(zmq_errno()));
+}
+
+
+END_NAMESPACE()
+
+
+constexpr std::size_t OpenEphysNetworkEventsRequester::maxResponseSize;
+
+
+OpenEphysNetworkEventsRequester::OpenEphysNetworkEventsRequester() :
+    socket(nullptr),
+    responseBuffer(maxResponseSize)
+{ }
+
+
+bool OpenEphysNetworkEventsRequester::configure(void *socket) {
+    this->socket = socket;
+    
+    const int linger = 0;
+    const int timeout = 1000;  // ms
+    const int immediate = 1;
+    if (0 != zmq_setsockopt(socket, ZMQ_LINGER, &linger, sizeof(linger)) ||
+        0 != zmq_setsockopt(socket, ZMQ_RCVTIMEO, &timeout, sizeof(timeout)) ||
+        0 != zmq_setsockopt(socket, ZMQ_SNDTIMEO, &timeout, sizeof(timeout)) ||
+        // Make zmq_send fail if we're not connected (instead of queuing the request for later)
+        0 != zmq_setsockopt(socket, ZMQ_IMMEDIATE, &immediate, sizeof(immediate)))
+    {
+        logZMQError("Unable to set ZeroMQ socket timeouts");
+        return false;
+    }
+    
+    return true;
+}
+
+
+bool OpenEphysNetworkEventsRequester::sendRequest(const std::string &request, std::string &response) {
+    scoped_lock lock(mutex);
+    
+    if (-1 == zmq_send(socket, request.data(), request.size(), 0)) {
+        logZMQError("Unable to send request to Open Ephys network events module");
+        return false;
+    }
+    
+    int responseSize;
+    if (-1 == (responseSize = zmq_recv(socket, responseBuffer.data(), responseBuffer.size(), 0))) {
+        logZMQError("Failed to receive response from Open Ephys network events module");
+        return false;
+    }
+    
+    response.assign(responseBuffer.data(), std::min(std::size_t(responseSize), responseBuffer.size()));
+    return true;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,52 @@
+//
+//  OpenEphysNetworkEventsRequester.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysNetworkEventsRequester_hpp
+#define OpenEphysNetworkEventsRequester_hpp
+
+#include <zmq.h>
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Sends requests to the Open Ephys Network Events module on a ZeroMQ REQ socket, and waits for its
+// responses.  The caller creates, connects, and disconnects the socket.  Requests may be sent from
+// any thread; they're sent one at a time, as a REQ socket requires.
+//
+class OpenEphysNetworkEventsRequester : boost::noncopyable {
+    
+public:
+    // Longer responses are truncated
+    static constexpr std::size_t maxResponseSize = 1024;
+    
+    OpenEphysNetworkEventsRequester();
+    
+    // Sets the socket's timeouts, and makes sends fail while it isn't connected (instead of queuing
+    // requests for later).  Returns false on failure.
+    bool configure(void *socket);
+    
+    // Returns false (after reporting the error) if the request can't be sent or no response arrives
+    bool sendRequest(const std::string &request, std::string &response);
+    
+private:
+    void *socket;
+    std::vector<char> responseBuffer;
+    
+    std::mutex mutex;
+    using scoped_lock = std::lock_guard<decltype(mutex)>;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysNetworkEventsRequester_hpp */
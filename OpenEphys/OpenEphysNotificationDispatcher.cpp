@@ -0,0 +1,155 @@
+//
+//  OpenEphysNotificationDispatcher.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysNotificationDispatcher.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+OpenEphysNotificationDispatcher::OpenEphysNotificationDispatcher(std::size_t numWorkers, std::size_t queueCapacity) :
+    queueCapacity(queueCapacity),
+    queueDepth(0),
+    numDropped(0)
+{
+    if (numWorkers < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Notification dispatcher requires at least one worker");
+    }
+    if (queueCapacity < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Notification queue capacity must be at least 1");
+    }
+    for (std::size_t i = 0; i < numWorkers; i++) {
+        workers.emplace_back(new Worker(queueCapacity));
+    }
+}
+
+
+OpenEphysNotificationDispatcher::~OpenEphysNotificationDispatcher() {
+    stop();
+}
+
+
+void OpenEphysNotificationDispatcher::start() {
+    numDropped.store(0, std::memory_order_relaxed);
+    for (auto &worker : workers) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        if (!worker->running) {
+            worker->running = true;
+            auto &w = *worker;
+            worker->thread = std::thread([this, &w]() {
+                runWorker(w);
+            });
+        }
+    }
+}
+
+
+void OpenEphysNotificationDispatcher::stop() {
+    for (auto &worker : workers) {
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->running = false;
+        }
+        worker->queueNotEmpty.notify_all();
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+
+bool OpenEphysNotificationDispatcher::setValue(const VariablePtr &variable, const Datum &value, MWTime time) {
+    auto &worker = getWorker(variable);
+    
+    {
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        if (!worker.running) {
+            // Not dispatching, so assign directly
+            lock.unlock();
+            variable->setValue(value, time);
+            return true;
+        }
+        if (worker.queueHead - worker.queueTail >= queueCapacity) {
+            lock.unlock();
+            if (0 == numDropped.fetch_add(1, std::memory_order_relaxed)) {
+                mwarning(M_IODEVICE_MESSAGE_DOMAIN,
+                         "Open Ephys notification queue is full; dropping variable assignments until it drains");
+            }
+            return false;
+        }
+        auto &assignment = worker.queue[worker.queueHead % queueCapacity];
+        assignment.variable = variable;
+        assignment.value = value;
+        assignment.time = time;
+        worker.queueHead++;
+        queueDepth.fetch_add(1, std::memory_order_relaxed);
+    }
+    worker.queueNotEmpty.notify_one();
+    return true;
+}
+
+
+void OpenEphysNotificationDispatcher::setControlValue(const VariablePtr &variable, const Datum &value, MWTime time) {
+    auto &worker = getWorker(variable);
+    
+    {
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        if (!worker.running) {
+            // Not dispatching, so assign directly
+            lock.unlock();
+            variable->setValue(value, time);
+            return;
+        }
+        worker.controlQueue.push_back({ variable, value, time });
+    }
+    worker.queueNotEmpty.notify_one();
+}
+
+
+auto OpenEphysNotificationDispatcher::getWorker(const VariablePtr &variable) -> Worker & {
+    // Assign each variable to a fixed worker, to preserve the order of its values
+    return *(workers[std::hash<Variable *>()(variable.get()) % workers.size()]);
+}
+
+
+void OpenEphysNotificationDispatcher::runWorker(Worker &worker) {
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    while (true) {
+        worker.queueNotEmpty.wait(lock, [&worker]() {
+            return (worker.queueHead != worker.queueTail || !worker.controlQueue.empty() || !worker.running);
+        });
+        
+        if (!worker.controlQueue.empty()) {
+            const auto assignment = std::move(worker.controlQueue.front());
+            worker.controlQueue.pop_front();
+            lock.unlock();
+            
+            assignment.variable->setValue(assignment.value, assignment.time);
+            
+            lock.lock();
+            continue;
+        }
+        
+        if (worker.queueHead == worker.queueTail) {
+            // Stopped, and all pending assignments are complete
+            return;
+        }
+        
+        // The slot isn't reused until the tail passes it, so it can be read without the lock
+        const auto &assignment = worker.queue[worker.queueTail % queueCapacity];
+        lock.unlock();
+        
+        assignment.variable->setValue(assignment.value, assignment.time);
+        queueDepth.fetch_sub(1, std::memory_order_relaxed);
+        
+        lock.lock();
+        worker.queueTail++;
+    }
+}
+
+
+END_NAMESPACE_MW
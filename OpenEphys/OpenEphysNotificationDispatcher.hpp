@@ -0,0 +1,88 @@
+//
+//  OpenEphysNotificationDispatcher.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysNotificationDispatcher_hpp
+#define OpenEphysNotificationDispatcher_hpp
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Performs variable assignments (and hence runs their notifications) on a small pool of worker
+// threads, so that slow notifications don't stall the thread that produces the values.  Each
+// variable is always assigned by the same worker, so assignments to a given variable occur in the
+// order they were submitted.  (Assignments to different variables may be reordered.)
+//
+// Each worker's queue is bounded.  If it fills, setValue drops the new value (and counts it) rather
+// than wait, so the caller's cost per assignment stays bounded no matter how slow the notifications
+// are.  Callers should monitor getQueueDepth to shed load before that happens.
+//
+// Low-rate values that must never be lost (e.g. clock updates) are instead queued by setControlValue,
+// in a separate, unbounded queue that each worker serves before its bounded one.  A given variable
+// should always be assigned by the same method, since values queued by different methods may be
+// assigned out of order.
+//
+// The queues are rings of assignment slots, allocated up front, so queuing an assignment never
+// allocates a queue node.  Each slot's value is recycled: a new value is copy-assigned over the one
+// the slot held before, so a value of the same shape (e.g. the spike dictionary, whose keys never
+// change) can reuse its storage.
+//
+class OpenEphysNotificationDispatcher : boost::noncopyable {
+    
+public:
+    OpenEphysNotificationDispatcher(std::size_t numWorkers, std::size_t queueCapacity);
+    ~OpenEphysNotificationDispatcher();
+    
+    void start();
+    void stop();  // Completes all pending assignments before returning
+    
+    // Returns false if the value was dropped because the queue was full
+    bool setValue(const VariablePtr &variable, const Datum &value, MWTime time);
+    // Never drops the value
+    void setControlValue(const VariablePtr &variable, const Datum &value, MWTime time);
+    
+    std::size_t getQueueDepth() const { return queueDepth.load(std::memory_order_relaxed); }
+    std::size_t getQueueCapacity() const { return workers.size() * queueCapacity; }
+    // Values dropped since start
+    std::size_t getNumDropped() const { return numDropped.load(std::memory_order_relaxed); }
+    
+private:
+    struct Assignment {
+        VariablePtr variable;
+        Datum value;
+        MWTime time;
+    };
+    
+    struct Worker {
+        explicit Worker(std::size_t queueCapacity) : queue(queueCapacity), queueHead(0), queueTail(0) { }
+        
+        std::vector<Assignment> queue;
+        std::size_t queueHead;  // Next slot to fill
+        std::size_t queueTail;  // Next slot to assign, which stays occupied until its assignment completes
+        std::deque<Assignment> controlQueue;
+        std::mutex mutex;
+        std::condition_variable queueNotEmpty;
+        bool running = false;
+        std::thread thread;
+    };
+    
+    Worker & getWorker(const VariablePtr &variable);
+    void runWorker(Worker &worker);
+    
+    const std::size_t queueCapacity;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<std::size_t> queueDepth;
+    std::atomic<std::size_t> numDropped;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysNotificationDispatcher_hpp */
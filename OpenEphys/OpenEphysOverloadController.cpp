@@ -0,0 +1,116 @@
+//
+//  OpenEphysOverloadController.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysOverloadController.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+constexpr double lagSmoothing = 0.05;  // Weight of each new lag sample
+constexpr MWTime receiveDelayWindow = 10000000;  // 10 seconds
+
+
+END_NAMESPACE()
+
+
+const char * OpenEphysOverloadController::getModeName(Mode mode) {
+    switch (mode) {
+        case Mode::Normal:
+            return "normal";
+        case Mode::Summary:
+            return "summary";
+    }
+    return "normal";
+}
+
+
+OpenEphysOverloadController::OpenEphysOverloadController(MWTime lagThreshold,
+                                                         double queueFillThreshold,
+                                                         MWTime minDwellTime) :
+    lagThreshold(lagThreshold),
+    queueFillThreshold(queueFillThreshold),
+    minDwellTime(minDwellTime),
+    mode(Mode::Normal),
+    smoothedLag(0.0),
+    lastModeChangeTime(0),
+    delayWindowStartTime(0),
+    minReceiveDelay(std::numeric_limits<MWTime>::max()),
+    previousMinReceiveDelay(std::numeric_limits<MWTime>::max())
+{
+    if (lagThreshold <= 0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Overload lag threshold must be greater than zero");
+    }
+}
+
+
+void OpenEphysOverloadController::addLagSample(MWTime lag) {
+    smoothedLag += lagSmoothing * (double(lag) - smoothedLag);
+}
+
+
+void OpenEphysOverloadController::addReceiveDelaySample(MWTime oeTime, MWTime receiptTime) {
+    const MWTime delay = receiptTime - oeTime;
+    if (receiptTime - delayWindowStartTime >= receiveDelayWindow) {
+        previousMinReceiveDelay = minReceiveDelay;
+        minReceiveDelay = delay;
+        delayWindowStartTime = receiptTime;
+    } else {
+        minReceiveDelay = std::min(minReceiveDelay, delay);
+    }
+    addLagSample(delay - std::min(minReceiveDelay, previousMinReceiveDelay));
+}
+
+
+bool OpenEphysOverloadController::update(MWTime currentTime, double queueFill) {
+    switch (mode) {
+        case Mode::Normal:
+            if (smoothedLag > double(lagThreshold) || queueFill > queueFillThreshold) {
+                mode = Mode::Summary;
+                lastModeChangeTime = currentTime;
+                return true;
+            }
+            break;
+            
+        case Mode::Summary:
+            if (smoothedLag < double(lagThreshold) / 2.0 &&
+                queueFill < queueFillThreshold / 2.0 &&
+                currentTime - lastModeChangeTime >= minDwellTime)
+            {
+                mode = Mode::Normal;
+                lastModeChangeTime = currentTime;
+                return true;
+            }
+            break;
+    }
+    return false;
+}
+
+
+void OpenEphysOverloadController::countSpike(std::uint16_t electrodeID, std::uint16_t sortedID) {
+    counts[(std::uint32_t(electrodeID) << 16) | sortedID]++;
+}
+
+
+auto OpenEphysOverloadController::takeCounts() -> std::vector<UnitCount> {
+    std::vector<UnitCount> result;
+    result.reserve(counts.size());
+    for (auto &entry : counts) {
+        result.push_back({ std::uint16_t(entry.first >> 16), std::uint16_t(entry.first & 0xFFFF), entry.second });
+    }
+    counts.clear();
+    std::sort(result.begin(), result.end(), [](const UnitCount &a, const UnitCount &b) {
+        return (a.electrodeID < b.electrodeID || (a.electrodeID == b.electrodeID && a.sortedID < b.sortedID));
+    });
+    return result;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,80 @@
+//
+//  OpenEphysOverloadController.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysOverloadController_hpp
+#define OpenEphysOverloadController_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Decides when spike publication should degrade from individual spikes to per-unit count summaries.
+// Load is measured as the smoothed lag between a spike's (converted) time and its receipt, along
+// with the fill fraction of the notification queue.  The controller enters summary mode when either
+// exceeds its threshold, and returns to normal mode only after both have stayed below half their
+// thresholds for a minimum dwell time, so that it doesn't oscillate.
+//
+// When spike times can't be converted (i.e. without clock sync), the lag is measured on the receive
+// side instead: the delay between a spike's Open Ephys time and its receipt, minus the smallest such
+// delay seen in the last 10-20 seconds.  The unknown clock offset cancels out, leaving the backlog
+// that has built up since the receive path was last idle.
+//
+class OpenEphysOverloadController : boost::noncopyable {
+    
+public:
+    enum class Mode { Normal, Summary };
+    
+    struct UnitCount {
+        std::uint16_t electrodeID;
+        std::uint16_t sortedID;
+        std::size_t count;
+    };
+    
+    static const char * getModeName(Mode mode);
+    
+    OpenEphysOverloadController(MWTime lagThreshold, double queueFillThreshold, MWTime minDwellTime);
+    
+    Mode getMode() const { return mode; }
+    
+    void addLagSample(MWTime lag);
+    // Receive-side equivalent of addLagSample, for use without clock sync
+    void addReceiveDelaySample(MWTime oeTime, MWTime receiptTime);
+    double getSmoothedLag() const { return smoothedLag; }
+    // Returns true if the mode changed
+    bool update(MWTime currentTime, double queueFill);
+    
+    void countSpike(std::uint16_t electrodeID, std::uint16_t sortedID);
+    bool hasCounts() const { return !counts.empty(); }
+    // Returns the counts accumulated since the last call, and clears them
+    std::vector<UnitCount> takeCounts();
+    
+private:
+    const MWTime lagThreshold;
+    const double queueFillThreshold;
+    const MWTime minDwellTime;
+    
+    Mode mode;
+    double smoothedLag;
+    MWTime lastModeChangeTime;
+    
+    // Minimum receive delays in the current and previous windows
+    MWTime delayWindowStartTime;
+    MWTime minReceiveDelay;
+    MWTime previousMinReceiveDelay;
+    
+    std::unordered_map<std::uint32_t, std::size_t> counts;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysOverloadController_hpp */
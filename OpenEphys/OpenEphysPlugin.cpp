@@ -6,8 +6,11 @@
 //  Copyright (c) 2015 The MWorks Project. All rights reserved.
 //
 
+#include "OpenEphysContinuousInterface.hpp"
 #include "OpenEphysInterface.h"
 #include "OpenEphysNetworkEventsClient.hpp"
+#include "OpenEphysSimulator.hpp"
+#include "OpenEphysSpikeAnalysis.hpp"
 
 
 BEGIN_NAMESPACE_MW
@@ -16,7 +19,10 @@ BEGIN_NAMESPACE_MW
 class OpenEphysPlugin : public Plugin {
     void registerComponents(boost::shared_ptr<ComponentRegistry> registry) override {
         registry->registerFactory<StandardComponentFactory, OpenEphysInterface>();
+        registry->registerFactory<StandardComponentFactory, OpenEphysContinuousInterface>();
         registry->registerFactory<StandardComponentFactory, OpenEphysNetworkEventsClient>();
+        registry->registerFactory<StandardComponentFactory, OpenEphysSimulator>();
+        registry->registerFactory<StandardComponentFactory, OpenEphysSpikeAnalysis>();
     }
 };
 
@@ -0,0 +1,269 @@
+//
+//  OpenEphysPopulationDecoder.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysPopulationDecoder.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+// Dot product with independent partial sums, since the compiler won't reorder a single floating-point
+// accumulation to vectorize it
+inline double dot(const double *x, const double *y, std::size_t n) {
+    constexpr std::size_t numLanes = 8;
+    double partial[numLanes] = {};
+    std::size_t i = 0;
+    for (; i + numLanes <= n; i += numLanes) {
+        for (std::size_t lane = 0; lane < numLanes; lane++) {
+            partial[lane] += x[i + lane] * y[i + lane];
+        }
+    }
+    double total = 0.0;
+    for (; i < n; i++) {
+        total += x[i] * y[i];
+    }
+    for (std::size_t lane = 0; lane < numLanes; lane++) {
+        total += partial[lane];
+    }
+    return total;
+}
+
+
+// y = matrix * x, where matrix is row-major with the given number of rows and columns
+inline void multiply(const double *matrix, std::size_t numRows, std::size_t numColumns, const double *x, double *y) {
+    for (std::size_t row = 0; row < numRows; row++) {
+        y[row] = dot(matrix + row * numColumns, x, numColumns);
+    }
+}
+
+
+// Gauss-Jordan elimination with partial pivoting.  Destroys matrix, and returns false if it's singular.
+bool invert(std::vector<double> &matrix, std::vector<double> &inverse, std::size_t n) {
+    inverse.assign(n * n, 0.0);
+    for (std::size_t i = 0; i < n; i++) {
+        inverse[i * n + i] = 1.0;
+    }
+    
+    double scale = 0.0;
+    for (auto value : matrix) {
+        scale = std::max(scale, std::abs(value));
+    }
+    const double minPivot = scale * double(n) * std::numeric_limits<double>::epsilon();
+    
+    for (std::size_t column = 0; column < n; column++) {
+        std::size_t pivot = column;
+        for (std::size_t row = column + 1; row < n; row++) {
+            if (std::abs(matrix[row * n + column]) > std::abs(matrix[pivot * n + column])) {
+                pivot = row;
+            }
+        }
+        if (!(std::abs(matrix[pivot * n + column]) > minPivot)) {
+            return false;
+        }
+        if (pivot != column) {
+            std::swap_ranges(matrix.begin() + pivot * n, matrix.begin() + (pivot + 1) * n, matrix.begin() + column * n);
+            std::swap_ranges(inverse.begin() + pivot * n, inverse.begin() + (pivot + 1) * n, inverse.begin() + column * n);
+        }
+        
+        const double reciprocal = 1.0 / matrix[column * n + column];
+        for (std::size_t j = 0; j < n; j++) {
+            matrix[column * n + j] *= reciprocal;
+            inverse[column * n + j] *= reciprocal;
+        }
+        
+        for (std::size_t row = 0; row < n; row++) {
+            const double factor = matrix[row * n + column];
+            if (row == column || factor == 0.0) {
+                continue;
+            }
+            for (std::size_t j = 0; j < n; j++) {
+                matrix[row * n + j] -= factor * matrix[column * n + j];
+                inverse[row * n + j] -= factor * inverse[column * n + j];
+            }
+        }
+    }
+    
+    return true;
+}
+
+
+void checkSize(const std::vector<double> &values, std::size_t size, const std::string &name) {
+    if (values.size() != size) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decoder parameter has the wrong number of values", name);
+    }
+}
+
+
+END_NAMESPACE()
+
+
+auto OpenEphysPopulationDecoder::parseType(const std::string &name) -> Type {
+    if (name == "linear") {
+        return Type::Linear;
+    } else if (name == "kalman") {
+        return Type::Kalman;
+    }
+    throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid decoder (must be linear or kalman)", name);
+}
+
+
+OpenEphysPopulationDecoder::OpenEphysPopulationDecoder(std::size_t numUnits, std::size_t numOutputs) :
+    numUnits(numUnits),
+    numOutputs(numOutputs)
+{
+    if (numUnits < 1 || numOutputs < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decoder requires at least one unit and one output");
+    }
+}
+
+
+OpenEphysLinearDecoder::OpenEphysLinearDecoder(std::size_t numUnits,
+                                               std::size_t numOutputs,
+                                               std::vector<double> weights,
+                                               std::vector<double> offsets) :
+    OpenEphysPopulationDecoder(numUnits, numOutputs),
+    weights(std::move(weights)),
+    offsets(std::move(offsets))
+{
+    checkSize(this->weights, numOutputs * numUnits, "weights");
+    checkSize(this->offsets, numOutputs, "offsets");
+}
+
+
+void OpenEphysLinearDecoder::decode(const double *counts, double *output) {
+    multiply(weights.data(), numOutputs, numUnits, counts, output);
+    for (std::size_t i = 0; i < numOutputs; i++) {
+        output[i] += offsets[i];
+    }
+}
+
+
+OpenEphysKalmanDecoder::OpenEphysKalmanDecoder(std::size_t numUnits,
+                                               std::size_t numStates,
+                                               std::vector<double> transition,
+                                               std::vector<double> processNoise,
+                                               std::vector<double> observation,
+                                               std::vector<double> baseline,
+                                               const std::vector<double> &observationNoise) :
+    OpenEphysPopulationDecoder(numUnits, numStates),
+    transition(std::move(transition)),
+    processNoise(std::move(processNoise)),
+    observation(std::move(observation)),
+    baseline(std::move(baseline)),
+    observationGain(numStates * numUnits, 0.0),
+    observationInformation(numStates * numStates, 0.0),
+    predictedState(numStates),
+    predictedCovariance(numStates * numStates),
+    product(numStates * numStates),
+    innovation(numUnits),
+    correction(numStates)
+{
+    checkSize(this->transition, numStates * numStates, "transition matrix");
+    checkSize(this->processNoise, numStates * numStates, "process noise");
+    checkSize(this->observation, numUnits * numStates, "observation matrix");
+    checkSize(this->baseline, numUnits, "baseline");
+    checkSize(observationNoise, numUnits * numUnits, "observation noise");
+    
+    product = this->processNoise;
+    if (!invert(product, inverse, numStates)) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decoder process noise must be invertible");
+    }
+    
+    std::vector<double> noise(observationNoise), noiseInverse;
+    if (!invert(noise, noiseInverse, numUnits)) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decoder observation noise must be invertible");
+    }
+    
+    // These depend only on the model, so compute them once
+    for (std::size_t i = 0; i < numStates; i++) {
+        for (std::size_t k = 0; k < numUnits; k++) {
+            double sum = 0.0;
+            for (std::size_t l = 0; l < numUnits; l++) {
+                sum += this->observation[l * numStates + i] * noiseInverse[l * numUnits + k];
+            }
+            observationGain[i * numUnits + k] = sum;
+        }
+    }
+    for (std::size_t i = 0; i < numStates; i++) {
+        for (std::size_t j = 0; j < numStates; j++) {
+            double sum = 0.0;
+            for (std::size_t k = 0; k < numUnits; k++) {
+                sum += observationGain[i * numUnits + k] * this->observation[k * numStates + j];
+            }
+            observationInformation[i * numStates + j] = sum;
+        }
+    }
+    
+    reset();
+}
+
+
+void OpenEphysKalmanDecoder::reset() {
+    state.assign(numOutputs, 0.0);
+    covariance = processNoise;
+}
+
+
+void OpenEphysKalmanDecoder::decode(const double *counts, double *output) {
+    const std::size_t numStates = numOutputs;
+    
+    // Predict
+    multiply(transition.data(), numStates, numStates, state.data(), predictedState.data());
+    for (std::size_t i = 0; i < numStates; i++) {
+        for (std::size_t j = 0; j < numStates; j++) {
+            double sum = 0.0;
+            for (std::size_t k = 0; k < numStates; k++) {
+                sum += transition[i * numStates + k] * covariance[k * numStates + j];
+            }
+            product[i * numStates + j] = sum;
+        }
+    }
+    for (std::size_t i = 0; i < numStates; i++) {
+        // Rows of the transition matrix are the columns of its transpose
+        multiply(transition.data(), numStates, numStates, &product[i * numStates], &predictedCovariance[i * numStates]);
+    }
+    for (std::size_t i = 0; i < numStates * numStates; i++) {
+        predictedCovariance[i] += processNoise[i];
+    }
+    
+    // Update: covariance = inverse(inverse(predicted covariance) + observation information)
+    product = predictedCovariance;
+    bool updated = invert(product, inverse, numStates);
+    if (updated) {
+        for (std::size_t i = 0; i < numStates * numStates; i++) {
+            inverse[i] += observationInformation[i];
+        }
+        updated = invert(inverse, product, numStates);
+    }
+    
+    if (updated) {
+        covariance.swap(product);
+        
+        // state = predicted state + covariance * observationGain * (counts - baseline - observation * predicted state)
+        multiply(observation.data(), numUnits, numStates, predictedState.data(), innovation.data());
+        for (std::size_t i = 0; i < numUnits; i++) {
+            innovation[i] = counts[i] - baseline[i] - innovation[i];
+        }
+        multiply(observationGain.data(), numStates, numUnits, innovation.data(), correction.data());
+        multiply(covariance.data(), numStates, numStates, correction.data(), state.data());
+        for (std::size_t i = 0; i < numStates; i++) {
+            state[i] += predictedState[i];
+        }
+    } else {
+        // Numerically singular; keep the prediction
+        state = predictedState;
+        covariance = predictedCovariance;
+    }
+    
+    std::copy(state.begin(), state.end(), output);
+}
+
+
+END_NAMESPACE_MW
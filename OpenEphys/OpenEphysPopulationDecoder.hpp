@@ -0,0 +1,120 @@
+//
+//  OpenEphysPopulationDecoder.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysPopulationDecoder_hpp
+#define OpenEphysPopulationDecoder_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Decodes a vector of outputs (e.g. cursor velocity) from each bin of spike counts of a fixed set of
+// units.  Matrices are stored row-major, so that every matrix-vector product is a series of contiguous
+// dot products, which the compiler vectorizes.  Not thread safe.
+//
+class OpenEphysPopulationDecoder : boost::noncopyable {
+    
+public:
+    enum class Type { Linear, Kalman };
+    
+    static Type parseType(const std::string &name);
+    
+    virtual ~OpenEphysPopulationDecoder() { }
+    
+    std::size_t getNumUnits() const { return numUnits; }
+    std::size_t getNumOutputs() const { return numOutputs; }
+    
+    // Discards any state carried between bins
+    virtual void reset() = 0;
+    
+    // counts has one element per unit, and output one element per output
+    virtual void decode(const double *counts, double *output) = 0;
+    
+protected:
+    OpenEphysPopulationDecoder(std::size_t numUnits, std::size_t numOutputs);
+    
+    const std::size_t numUnits;
+    const std::size_t numOutputs;
+    
+};
+
+
+//
+// output = weights * counts + offsets, where weights has one row per output and one column per unit
+//
+class OpenEphysLinearDecoder : public OpenEphysPopulationDecoder {
+    
+public:
+    OpenEphysLinearDecoder(std::size_t numUnits,
+                           std::size_t numOutputs,
+                           std::vector<double> weights,
+                           std::vector<double> offsets);
+    
+    void reset() override { }
+    void decode(const double *counts, double *output) override;
+    
+private:
+    const std::vector<double> weights;
+    const std::vector<double> offsets;
+    
+};
+
+
+//
+// Kalman filter whose state is the output, with the linear Gaussian model
+//
+//     state[t] = transition * state[t - 1] + process noise
+//     counts[t] = observation * state[t] + baseline + observation noise
+//
+// where observation has one row per unit and one column per state element.  Each update is computed
+// in information form, so that the only matrices inverted per bin are the size of the state (which is
+// typically much smaller than the number of units).  The state starts at zero, with covariance equal to
+// the process noise.
+//
+class OpenEphysKalmanDecoder : public OpenEphysPopulationDecoder {
+    
+public:
+    OpenEphysKalmanDecoder(std::size_t numUnits,
+                           std::size_t numStates,
+                           std::vector<double> transition,
+                           std::vector<double> processNoise,
+                           std::vector<double> observation,
+                           std::vector<double> baseline,
+                           const std::vector<double> &observationNoise);
+    
+    void reset() override;
+    void decode(const double *counts, double *output) override;
+    
+private:
+    const std::vector<double> transition;        // numStates x numStates
+    const std::vector<double> processNoise;      // numStates x numStates
+    const std::vector<double> observation;       // numUnits x numStates
+    const std::vector<double> baseline;          // numUnits
+    std::vector<double> observationGain;         // numStates x numUnits: observation' * inverse(observation noise)
+    std::vector<double> observationInformation;  // numStates x numStates: observationGain * observation
+    
+    std::vector<double> state;
+    std::vector<double> covariance;
+    
+    // Scratch space for each update
+    std::vector<double> predictedState;
+    std::vector<double> predictedCovariance;
+    std::vector<double> product;
+    std::vector<double> inverse;
+    std::vector<double> innovation;
+    std::vector<double> correction;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysPopulationDecoder_hpp */
@@ -0,0 +1,243 @@
+//
+//  OpenEphysSimulationModel.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysSimulationModel.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+constexpr float spikeThreshold = -50.0f;  // uV
+constexpr std::size_t spikeMetadataSize = 8;
+
+
+END_NAMESPACE()
+
+
+OpenEphysSimulationModel::OpenEphysSimulationModel(const std::vector<std::uint8_t> &syncChannels,
+                                                   MWTime syncEchoLatency,
+                                                   MWTime syncEchoJitter,
+                                                   MWTime oeClockOffset,
+                                                   double oeClockDrift,
+                                                   double sampleRate,
+                                                   double firingRate,
+                                                   std::uint64_t seed) :
+    syncWordDecoder(syncChannels),
+    syncEchoLatency(syncEchoLatency),
+    syncEchoJitter(syncEchoJitter),
+    oeClockOffset(oeClockOffset),
+    oeClockDrift(oeClockDrift),
+    sampleRate(sampleRate),
+    firingRate(firingRate),
+    tuned(false),
+    tuningWidth(0.0),
+    peakFiringRate(0.0),
+    elecType(0),
+    numChannels(1),
+    samplesPerChannel(0),
+    noiseLevel(0.0),
+    randomEngine(seed),
+    clockStartTime(0),
+    lastUpdateTime(0)
+{
+    if (syncEchoLatency < 0 || syncEchoJitter < 0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Sync echo latency and jitter cannot be negative");
+    }
+    if (oeClockDrift <= -1e6) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid Open Ephys clock drift");
+    }
+    if (sampleRate <= 0.0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Sample rate must be greater than zero");
+    }
+    if (firingRate < 0.0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Firing rates cannot be negative");
+    }
+}
+
+
+void OpenEphysSimulationModel::addUnit(std::uint16_t electrodeID, std::uint16_t sortedID, double preferredStimulus) {
+    units.push_back({ electrodeID, sortedID, preferredStimulus, makeWaveform(units.size()) });
+}
+
+
+void OpenEphysSimulationModel::setTuning(double tuningWidth, double peakFiringRate) {
+    if (tuningWidth <= 0.0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Tuning width must be greater than zero");
+    }
+    if (peakFiringRate < 0.0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Firing rates cannot be negative");
+    }
+    tuned = true;
+    this->tuningWidth = tuningWidth;
+    this->peakFiringRate = peakFiringRate;
+}
+
+
+void OpenEphysSimulationModel::enableWaveforms(std::uint8_t elecType,
+                                               std::size_t samplesPerChannel,
+                                               double noiseLevel)
+{
+    const std::size_t numChannels = OpenEphysEvent::getNumSpikeChannels(elecType);
+    if (numChannels == 0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid spike electrode type");
+    }
+    if (samplesPerChannel < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Spike waveforms must contain at least one sample");
+    }
+    if (noiseLevel < 0.0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Waveform noise level cannot be negative");
+    }
+    this->elecType = elecType;
+    this->numChannels = numChannels;
+    this->samplesPerChannel = samplesPerChannel;
+    this->noiseLevel = noiseLevel;
+    for (std::size_t i = 0; i < units.size(); i++) {
+        units[i].waveform = makeWaveform(i);
+    }
+}
+
+
+double OpenEphysSimulationModel::getOpenEphysTime(MWTime time) const {
+    const double elapsed = double(time - clockStartTime) * (1.0 + oeClockDrift / 1e6);
+    return (double(oeClockOffset) + elapsed) / 1e6;
+}
+
+
+void OpenEphysSimulationModel::start(MWTime time) {
+    lastUpdateTime = time;
+}
+
+
+void OpenEphysSimulationModel::stop() {
+    pendingSyncEchoes.clear();
+}
+
+
+void OpenEphysSimulationModel::handleSync(int value, MWTime time) {
+    MWTime echoTime = time + syncEchoLatency;
+    if (syncEchoJitter > 0) {
+        std::normal_distribution<double> jitter(0.0, double(syncEchoJitter));
+        echoTime = std::max(time, echoTime + MWTime(std::llround(jitter(randomEngine))));
+    }
+    
+    // Jitter can reorder echoes, so insert in time order
+    const auto position = std::upper_bound(pendingSyncEchoes.begin(),
+                                           pendingSyncEchoes.end(),
+                                           echoTime,
+                                           [](MWTime time, const SyncEcho &echo) { return time < echo.time; });
+    pendingSyncEchoes.insert(position, SyncEcho { echoTime, value });
+}
+
+
+void OpenEphysSimulationModel::update(MWTime currentTime, double stimulusValue, const EventHandler &handler) {
+    while (!pendingSyncEchoes.empty() && pendingSyncEchoes.front().time <= currentTime) {
+        const auto &echo = pendingSyncEchoes.front();
+        
+        OpenEphysEvent event;
+        std::memset(&event, 0, sizeof(event));
+        event.ttl.word = syncWordDecoder.encode(echo.value);
+        handler(OpenEphysEvent::ttlType, getOpenEphysTime(echo.time), &(event.ttl), sizeof(event.ttl));
+        
+        pendingSyncEchoes.pop_front();
+    }
+    
+    const MWTime elapsed = currentTime - lastUpdateTime;
+    if (elapsed <= 0) {
+        return;
+    }
+    
+    std::uniform_int_distribution<MWTime> spikeOffset(1, elapsed);
+    
+    // Draw each unit's spike count for the elapsed interval, place the spikes uniformly within it,
+    // and send them in time order
+    pendingSpikes.clear();
+    for (std::size_t i = 0; i < units.size(); i++) {
+        const double expectedCount = getFiringRate(units[i], stimulusValue) * double(elapsed) / 1e6;
+        if (expectedCount <= 0.0) {
+            continue;
+        }
+        std::poisson_distribution<std::size_t> spikeCount(expectedCount);
+        for (std::size_t n = spikeCount(randomEngine); n > 0; n--) {
+            pendingSpikes.emplace_back(lastUpdateTime + spikeOffset(randomEngine), i);
+        }
+    }
+    std::sort(pendingSpikes.begin(), pendingSpikes.end());
+    
+    for (auto &item : pendingSpikes) {
+        const auto &unit = units[item.second];
+        const double oeTime = getOpenEphysTime(item.first);
+        
+        buildSpikeFrame(unit, std::llround(oeTime * sampleRate));
+        handler(OpenEphysEvent::spikeType, oeTime, spikeFrame.data(), spikeFrame.size());
+    }
+    
+    lastUpdateTime = currentTime;
+}
+
+
+double OpenEphysSimulationModel::getFiringRate(const Unit &unit, double stimulusValue) const {
+    if (!tuned) {
+        return firingRate;
+    }
+    
+    // Gaussian tuning curve on top of the baseline rate
+    const double distance = (stimulusValue - unit.preferredStimulus) / tuningWidth;
+    return firingRate + (peakFiringRate - firingRate) * std::exp(-0.5 * distance * distance);
+}
+
+
+std::vector<float> OpenEphysSimulationModel::makeWaveform(std::size_t unit) const {
+    // A trough whose depth varies by unit and channel, so that every unit's waveform is distinct
+    std::vector<float> waveform(numChannels * samplesPerChannel);
+    const double troughPosition = double(samplesPerChannel) / 3.0;
+    const double troughWidth = std::max(1.0, double(samplesPerChannel) / 10.0);
+    for (std::size_t channel = 0; channel < numChannels; channel++) {
+        const double depth = 50.0 * double(1 + (unit * 3 + channel) % 4);
+        for (std::size_t i = 0; i < samplesPerChannel; i++) {
+            const double distance = (double(i) - troughPosition) / troughWidth;
+            waveform[channel * samplesPerChannel + i] = float(-depth * std::exp(-0.5 * distance * distance));
+        }
+    }
+    return waveform;
+}
+
+
+void OpenEphysSimulationModel::buildSpikeFrame(const Unit &unit, std::int64_t sampleNumber) {
+    // Header, thresholds, waveform, and metadata (which receivers ignore)
+    const std::size_t numSamples = unit.waveform.size();
+    spikeFrame.assign(sizeof(OpenEphysEvent::Spike) +
+                      (samplesPerChannel > 0 ? (numChannels + numSamples) * sizeof(float) + spikeMetadataSize : 0),
+                      0);
+    
+    OpenEphysEvent::Spike header;
+    std::memset(&header, 0, sizeof(header));
+    header.elecType = elecType;
+    header.electrodeID = unit.electrodeID;
+    header.sortedID = unit.sortedID;
+    header.timestamp = sampleNumber;
+    std::memcpy(spikeFrame.data(), &header, sizeof(header));
+    
+    if (samplesPerChannel > 0) {
+        auto thresholds = spikeFrame.data() + sizeof(header);
+        for (std::size_t channel = 0; channel < numChannels; channel++) {
+            std::memcpy(thresholds + channel * sizeof(float), &spikeThreshold, sizeof(float));
+        }
+        
+        auto samples = thresholds + numChannels * sizeof(float);
+        std::normal_distribution<float> noise(0.0f, float(noiseLevel));
+        for (std::size_t i = 0; i < numSamples; i++) {
+            const float sample = unit.waveform[i] + (noiseLevel > 0.0 ? noise(randomEngine) : 0.0f);
+            std::memcpy(samples + i * sizeof(float), &sample, sizeof(float));
+        }
+    }
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,113 @@
+//
+//  OpenEphysSimulationModel.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysSimulationModel_hpp
+#define OpenEphysSimulationModel_hpp
+
+#include <functional>
+#include <random>
+
+#include "OpenEphysEvent.hpp"
+#include "OpenEphysSyncMatcher.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Generates the Event Broadcaster messages of a simulated Open Ephys GUI: echoes of sync words on the
+// TTL lines, and the spikes of a set of units with Poisson firing and optional Gaussian tuning to a
+// stimulus.  Spikes can optionally carry waveforms, in the layout of a SpikeEvent.  The Open Ephys
+// clock runs from the time passed to startClock, with a fixed offset (in microseconds) and drift (in
+// parts per million) relative to the MWorks clock.  Not thread safe.
+//
+class OpenEphysSimulationModel : boost::noncopyable {
+    
+public:
+    // Receives each message's event type, timestamp (in seconds), and body
+    using EventHandler = std::function<void(std::uint8_t type, double timestamp, const void *body, std::size_t size)>;
+    
+    OpenEphysSimulationModel(const std::vector<std::uint8_t> &syncChannels,
+                             MWTime syncEchoLatency,
+                             MWTime syncEchoJitter,
+                             MWTime oeClockOffset,
+                             double oeClockDrift,
+                             double sampleRate,
+                             double firingRate,
+                             std::uint64_t seed);
+    
+    // Sorted IDs should start at 1, since Open Ephys uses 0 for unsorted spikes
+    void addUnit(std::uint16_t electrodeID, std::uint16_t sortedID, double preferredStimulus);
+    std::size_t getNumUnits() const { return units.size(); }
+    // Enables tuning, which raises a unit's firing rate toward peakFiringRate near its preferred stimulus
+    void setTuning(double tuningWidth, double peakFiringRate);
+    // Attaches a waveform to each spike: the unit's waveform (see getWaveform), plus Gaussian noise with
+    // standard deviation noiseLevel (in microvolts), on the number of channels given by elecType
+    void enableWaveforms(std::uint8_t elecType, std::size_t samplesPerChannel, double noiseLevel);
+    // Noise-free waveform of a unit, with the samples of each channel contiguous
+    const std::vector<float> & getWaveform(std::size_t unit) const { return units.at(unit).waveform; }
+    
+    void startClock(MWTime time) { clockStartTime = time; }
+    // Seconds
+    double getOpenEphysTime(MWTime time) const;
+    
+    // Spikes are generated for the time after start
+    void start(MWTime time);
+    void stop();
+    
+    void handleSync(int value, MWTime time);
+    // Sends the sync echoes that are due, and the spikes since the previous update
+    void update(MWTime currentTime, double stimulusValue, const EventHandler &handler);
+    
+private:
+    struct Unit {
+        std::uint16_t electrodeID;
+        std::uint16_t sortedID;
+        double preferredStimulus;
+        std::vector<float> waveform;
+    };
+    
+    struct SyncEcho {
+        MWTime time;
+        int value;
+    };
+    
+    double getFiringRate(const Unit &unit, double stimulusValue) const;
+    std::vector<float> makeWaveform(std::size_t unit) const;
+    void buildSpikeFrame(const Unit &unit, std::int64_t sampleNumber);
+    
+    const OpenEphysSyncWordDecoder syncWordDecoder;
+    const MWTime syncEchoLatency;
+    const MWTime syncEchoJitter;
+    const MWTime oeClockOffset;
+    const double oeClockDrift;  // Parts per million
+    const double sampleRate;
+    const double firingRate;
+    bool tuned;
+    double tuningWidth;
+    double peakFiringRate;
+    std::uint8_t elecType;
+    std::size_t numChannels;
+    std::size_t samplesPerChannel;  // Zero if waveforms are disabled
+    double noiseLevel;
+    
+    std::vector<Unit> units;
+    std::mt19937_64 randomEngine;
+    
+    MWTime clockStartTime;
+    MWTime lastUpdateTime;
+    std::deque<SyncEcho> pendingSyncEchoes;  // Ordered by echo time
+    std::vector<std::pair<MWTime, std::size_t>> pendingSpikes;  // (time, unit index)
+    std::vector<std::uint8_t> spikeFrame;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysSimulationModel_hpp */
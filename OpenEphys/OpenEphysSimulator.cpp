@@ -0,0 +1,277 @@
+//
+//  OpenEphysSimulator.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysSimulator.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+inline MWTime currentTimeUS() {
+    return Clock::instance()->getCurrentTimeUS();
+}
+
+
+constexpr int sendHighWaterMark = 1000000;  // Messages
+
+
+END_NAMESPACE()
+
+
+const std::string OpenEphysSimulator::SYNC("sync");
+const std::string OpenEphysSimulator::SYNC_CHANNELS("sync_channels");
+const std::string OpenEphysSimulator::SYNC_ECHO_LATENCY("sync_echo_latency");
+const std::string OpenEphysSimulator::SYNC_ECHO_JITTER("sync_echo_jitter");
+const std::string OpenEphysSimulator::OE_CLOCK_OFFSET("oe_clock_offset");
+const std::string OpenEphysSimulator::OE_CLOCK_DRIFT("oe_clock_drift");
+const std::string OpenEphysSimulator::SAMPLE_RATE("sample_rate");
+const std::string OpenEphysSimulator::NUM_ELECTRODES("num_electrodes");
+const std::string OpenEphysSimulator::UNITS_PER_ELECTRODE("units_per_electrode");
+const std::string OpenEphysSimulator::FIRING_RATE("firing_rate");
+const std::string OpenEphysSimulator::STIMULUS("stimulus");
+const std::string OpenEphysSimulator::PREFERRED_STIMULUS_RANGE("preferred_stimulus_range");
+const std::string OpenEphysSimulator::TUNING_WIDTH("tuning_width");
+const std::string OpenEphysSimulator::PEAK_FIRING_RATE("peak_firing_rate");
+const std::string OpenEphysSimulator::UPDATE_INTERVAL("update_interval");
+const std::string OpenEphysSimulator::SEED("seed");
+
+
+void OpenEphysSimulator::describeComponent(ComponentInfo &info) {
+    OpenEphysBase::describeComponent(info);
+    
+    info.setSignature("iodevice/open_ephys_simulator");
+    
+    info.addParameter(SYNC);
+    info.addParameter(SYNC_CHANNELS);
+    info.addParameter(SYNC_ECHO_LATENCY, "1ms");
+    info.addParameter(SYNC_ECHO_JITTER, "0");
+    info.addParameter(OE_CLOCK_OFFSET, "0");
+    info.addParameter(OE_CLOCK_DRIFT, "0");
+    info.addParameter(SAMPLE_RATE, "30000");
+    info.addParameter(NUM_ELECTRODES, "1");
+    info.addParameter(UNITS_PER_ELECTRODE, "1");
+    info.addParameter(FIRING_RATE, "10");
+    info.addParameter(STIMULUS, false);
+    info.addParameter(PREFERRED_STIMULUS_RANGE, "0, 360");
+    info.addParameter(TUNING_WIDTH, "45");
+    info.addParameter(PEAK_FIRING_RATE, "50");
+    info.addParameter(UPDATE_INTERVAL, "1ms");
+    info.addParameter(SEED, false);
+}
+
+
+OpenEphysSimulator::OpenEphysSimulator(const ParameterValueMap &parameters) :
+    OpenEphysBase(parameters),
+    sync(parameters[SYNC]),
+    updateInterval(parameters[UPDATE_INTERVAL]),
+    running(false),
+    numSpikesSent(0),
+    numSyncEchoesSent(0)
+{
+    if (updateInterval <= 0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Update interval must be greater than zero");
+    }
+    
+    const long numElectrodes(parameters[NUM_ELECTRODES]);
+    const long unitsPerElectrode(parameters[UNITS_PER_ELECTRODE]);
+    if (numElectrodes < 1 || numElectrodes > std::numeric_limits<std::uint16_t>::max()) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid number of electrodes");
+    }
+    if (unitsPerElectrode < 1 || unitsPerElectrode >= std::numeric_limits<std::uint16_t>::max()) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid number of units per electrode");
+    }
+    
+    std::uint64_t seed = 0;
+    if (!parameters[SEED].empty()) {
+        seed = std::uint64_t(long(parameters[SEED]));
+    } else {
+        seed = std::random_device()();
+    }
+    
+    model.reset(new OpenEphysSimulationModel(parseSyncChannels(parameters[SYNC_CHANNELS].str()),
+                                             MWTime(parameters[SYNC_ECHO_LATENCY]),
+                                             MWTime(parameters[SYNC_ECHO_JITTER]),
+                                             MWTime(parameters[OE_CLOCK_OFFSET]),
+                                             double(parameters[OE_CLOCK_DRIFT]),
+                                             double(parameters[SAMPLE_RATE]),
+                                             double(parameters[FIRING_RATE]),
+                                             seed));
+    
+    double minPreferredStimulus = 0.0, maxPreferredStimulus = 0.0;
+    if (!parameters[STIMULUS].empty()) {
+        stimulus = VariablePtr(parameters[STIMULUS]);
+        
+        std::vector<Datum> rangeValues;
+        ParsedExpressionVariable::evaluateExpressionList(parameters[PREFERRED_STIMULUS_RANGE].str(), rangeValues);
+        if (rangeValues.size() != 2) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                  "Preferred stimulus range must contain exactly two values");
+        }
+        minPreferredStimulus = rangeValues.at(0).getFloat();
+        maxPreferredStimulus = rangeValues.at(1).getFloat();
+        
+        model->setTuning(double(parameters[TUNING_WIDTH]), double(parameters[PEAK_FIRING_RATE]));
+    }
+    
+    // Spread the units' preferred stimuli evenly across the range (inclusive)
+    const std::size_t numUnits = numElectrodes * unitsPerElectrode;
+    for (long electrode = 0; electrode < numElectrodes; electrode++) {
+        for (long unit = 0; unit < unitsPerElectrode; unit++) {
+            const double position = (numUnits > 1 ? double(model->getNumUnits()) / double(numUnits - 1) : 0.5);
+            model->addUnit(std::uint16_t(electrode),
+                           std::uint16_t(unit + 1),
+                           minPreferredStimulus + position * (maxPreferredStimulus - minPreferredStimulus));
+        }
+    }
+}
+
+
+OpenEphysSimulator::~OpenEphysSimulator() {
+    if (updateTask) {
+        updateTask->cancel();
+    }
+}
+
+
+bool OpenEphysSimulator::initialize() {
+    zmqSocket.reset(zmq_socket(getZMQContext(), ZMQ_PUB));
+    if (!zmqSocket) {
+        logZMQError("Unable to create ZeroMQ socket");
+        return false;
+    }
+    
+    const int linger = 0;
+    // Queue plenty of messages, so that stress tests measure the consumer rather than ZeroMQ drops
+    const int highWaterMark = sendHighWaterMark;
+    if (0 != zmq_setsockopt(zmqSocket.get(), ZMQ_LINGER, &linger, sizeof(linger)) ||
+        0 != zmq_setsockopt(zmqSocket.get(), ZMQ_SNDHWM, &highWaterMark, sizeof(highWaterMark)))
+    {
+        logZMQError("Unable to configure ZeroMQ socket");
+        return false;
+    }
+    
+    if (0 != zmq_bind(zmqSocket.get(), endpoint.c_str())) {
+        logZMQError("Unable to bind simulated Open Ephys event socket");
+        return false;
+    }
+    
+    // The simulated Open Ephys clock starts running when the experiment is loaded
+    model->startClock(currentTimeUS());
+    
+    boost::weak_ptr<OpenEphysSimulator> weakThis(component_shared_from_this<OpenEphysSimulator>());
+    auto syncNotification = [weakThis](const Datum &data, MWTime time) {
+        if (auto sharedThis = weakThis.lock()) {
+            sharedThis->handleSync(data.getInteger(), time);
+        }
+    };
+    sync->addNotification(boost::make_shared<VariableCallbackNotification>(syncNotification));
+    
+    return true;
+}
+
+
+bool OpenEphysSimulator::startDeviceIO() {
+    scoped_lock lock(mutex);
+    
+    if (!running) {
+        model->start(currentTimeUS());
+        numSpikesSent = 0;
+        numSyncEchoesSent = 0;
+        
+        boost::weak_ptr<OpenEphysSimulator> weakThis(component_shared_from_this<OpenEphysSimulator>());
+        updateTask = Scheduler::instance()->scheduleUS(FILELINE,
+                                                       updateInterval,
+                                                       updateInterval,
+                                                       M_REPEAT_INDEFINITELY,
+                                                       [weakThis]() {
+                                                           if (auto sharedThis = weakThis.lock()) {
+                                                               sharedThis->update();
+                                                           }
+                                                           return nullptr;
+                                                       },
+                                                       M_DEFAULT_IODEVICE_PRIORITY,
+                                                       M_DEFAULT_IODEVICE_WARN_SLOP_US,
+                                                       M_DEFAULT_IODEVICE_FAIL_SLOP_US,
+                                                       M_MISSED_EXECUTION_DROP);
+        
+        running = true;
+    }
+    
+    return true;
+}
+
+
+bool OpenEphysSimulator::stopDeviceIO() {
+    scoped_lock lock(mutex);
+    
+    if (running) {
+        if (updateTask) {
+            updateTask->cancel();
+            updateTask.reset();
+        }
+        
+        model->stop();
+        
+        mprintf(M_IODEVICE_MESSAGE_DOMAIN,
+                "Simulated Open Ephys device sent %lu spikes and %lu sync echoes",
+                (unsigned long)numSpikesSent,
+                (unsigned long)numSyncEchoesSent);
+        
+        running = false;
+    }
+    
+    return true;
+}
+
+
+void OpenEphysSimulator::handleSync(int value, MWTime time) {
+    scoped_lock lock(mutex);
+    
+    if (running) {
+        model->handleSync(value, time);
+    }
+}
+
+
+void OpenEphysSimulator::update() {
+    scoped_lock lock(mutex);
+    
+    if (!running) {
+        return;
+    }
+    
+    const double stimulusValue = (stimulus ? stimulus->getValue().getFloat() : 0.0);
+    model->update(currentTimeUS(),
+                  stimulusValue,
+                  [this](std::uint8_t type, double timestamp, const void *body, std::size_t size) {
+                      if (sendEvent(type, timestamp, body, size)) {
+                          if (type == OpenEphysEvent::spikeType) {
+                              numSpikesSent++;
+                          } else {
+                              numSyncEchoesSent++;
+                          }
+                      }
+                  });
+}
+
+
+bool OpenEphysSimulator::sendEvent(std::uint8_t type, double timestamp, const void *body, std::size_t size) {
+    if (-1 == zmq_send(zmqSocket.get(), &type, sizeof(type), ZMQ_SNDMORE) ||
+        -1 == zmq_send(zmqSocket.get(), &timestamp, sizeof(timestamp), ZMQ_SNDMORE) ||
+        -1 == zmq_send(zmqSocket.get(), body, size, 0))
+    {
+        logZMQError("Unable to send simulated Open Ephys event");
+        return false;
+    }
+    return true;
+}
+
+
+END_NAMESPACE_MW
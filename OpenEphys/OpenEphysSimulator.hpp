@@ -0,0 +1,77 @@
+//
+//  OpenEphysSimulator.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysSimulator_hpp
+#define OpenEphysSimulator_hpp
+
+#include "OpenEphysBase.hpp"
+#include "OpenEphysSimulationModel.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Stands in for the Open Ephys GUI and its Event Broadcaster.  The simulator publishes TTL and spike
+// messages on its own ZeroMQ socket, in the same format as the Event Broadcaster, so an
+// OpenEphysInterface connected to it exercises exactly the same decoding and publication path as it
+// would with real hardware.
+//
+class OpenEphysSimulator : public OpenEphysBase {
+    
+public:
+    static const std::string SYNC;
+    static const std::string SYNC_CHANNELS;
+    static const std::string SYNC_ECHO_LATENCY;
+    static const std::string SYNC_ECHO_JITTER;
+    static const std::string OE_CLOCK_OFFSET;
+    static const std::string OE_CLOCK_DRIFT;
+    static const std::string SAMPLE_RATE;
+    static const std::string NUM_ELECTRODES;
+    static const std::string UNITS_PER_ELECTRODE;
+    static const std::string FIRING_RATE;
+    static const std::string STIMULUS;
+    static const std::string PREFERRED_STIMULUS_RANGE;
+    static const std::string TUNING_WIDTH;
+    static const std::string PEAK_FIRING_RATE;
+    static const std::string UPDATE_INTERVAL;
+    static const std::string SEED;
+    
+    static void describeComponent(ComponentInfo &info);
+    
+    explicit OpenEphysSimulator(const ParameterValueMap &parameters);
+    ~OpenEphysSimulator();
+    
+    bool initialize() override;
+    bool startDeviceIO() override;
+    bool stopDeviceIO() override;
+    
+private:
+    void handleSync(int value, MWTime time);
+    void update();
+    bool sendEvent(std::uint8_t type, double timestamp, const void *body, std::size_t size);
+    
+    const VariablePtr sync;
+    VariablePtr stimulus;
+    const MWTime updateInterval;
+    std::unique_ptr<OpenEphysSimulationModel> model;
+    
+    std::mutex mutex;
+    using scoped_lock = std::lock_guard<decltype(mutex)>;
+    
+    bool running;
+    boost::shared_ptr<ScheduleTask> updateTask;
+    std::size_t numSpikesSent;
+    std::size_t numSyncEchoesSent;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysSimulator_hpp */
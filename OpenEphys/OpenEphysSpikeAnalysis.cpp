@@ -0,0 +1,723 @@
+//
+//  OpenEphysSpikeAnalysis.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysSpikeAnalysis.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+inline MWTime currentTimeUS() {
+    return Clock::instance()->getCurrentTimeUS();
+}
+
+
+inline MWTime secsToUS(double timestamp) {
+    return MWTime(timestamp * 1e6);
+}
+
+
+std::vector<VariablePtr> getVariables(const std::string &names) {
+    std::vector<VariablePtr> variables;
+    std::istringstream stream(names);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        const auto start = name.find_first_not_of(" \t");
+        if (start == std::string::npos) {
+            continue;
+        }
+        name = name.substr(start, name.find_last_not_of(" \t") - start + 1);
+        auto variable = global_variable_registry->getVariable(name);
+        if (!variable) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Unknown variable", name);
+        }
+        variables.push_back(variable);
+    }
+    return variables;
+}
+
+
+std::size_t getHistorySize(const ParameterValue &value) {
+    const long size(value);
+    if (size < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "History size must be at least 1");
+    }
+    return std::size_t(size);
+}
+
+
+std::vector<double> parseVector(const ParameterValue &value, std::size_t size, const std::string &name) {
+    if (value.empty()) {
+        return std::vector<double>(size, 0.0);
+    }
+    std::vector<Datum> values;
+    ParsedExpressionVariable::evaluateExpressionList(value.str(), values);
+    if (values.size() != size) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decoder parameter has the wrong number of values", name);
+    }
+    std::vector<double> result;
+    for (auto &element : values) {
+        if (!element.isNumber()) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decoder parameter must contain only numbers", name);
+        }
+        result.push_back(element.getFloat());
+    }
+    return result;
+}
+
+
+// Matrices are given as a list of rows, each of which is a list of numbers.  Returns the values in
+// row-major order.
+std::vector<double> parseMatrix(const ParameterValue &value,
+                                std::size_t &numRows,
+                                std::size_t &numColumns,
+                                const std::string &name)
+{
+    if (value.empty()) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decoder parameter is required", name);
+    }
+    std::vector<Datum> rows;
+    ParsedExpressionVariable::evaluateExpressionList(value.str(), rows);
+    numRows = rows.size();
+    numColumns = 0;
+    std::vector<double> result;
+    for (auto &row : rows) {
+        if (!row.isList() || row.getNElements() < 1 ||
+            (numColumns > 0 && std::size_t(row.getNElements()) != numColumns))
+        {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                  "Decoder matrix must be a list of rows of equal length",
+                                  name);
+        }
+        numColumns = row.getNElements();
+        for (std::size_t column = 0; column < numColumns; column++) {
+            const Datum element = row.getElement(int(column));
+            if (!element.isNumber()) {
+                throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decoder matrix must contain only numbers", name);
+            }
+            result.push_back(element.getFloat());
+        }
+    }
+    return result;
+}
+
+
+// Noise covariances may also be given as a list of variances, i.e. the diagonal
+std::vector<double> parseCovariance(const ParameterValue &value, std::size_t size, const std::string &name) {
+    if (value.empty()) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decoder parameter is required", name);
+    }
+    std::vector<Datum> values;
+    ParsedExpressionVariable::evaluateExpressionList(value.str(), values);
+    if (!values.empty() && !values.front().isList()) {
+        const auto variances = parseVector(value, size, name);
+        std::vector<double> result(size * size, 0.0);
+        for (std::size_t i = 0; i < size; i++) {
+            result[i * size + i] = variances[i];
+        }
+        return result;
+    }
+    std::size_t numRows = 0, numColumns = 0;
+    auto result = parseMatrix(value, numRows, numColumns, name);
+    if (numRows != size || numColumns != size) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decoder covariance matrix has the wrong size", name);
+    }
+    return result;
+}
+
+
+std::unique_ptr<OpenEphysPopulationDecoder> createDecoder(const ParameterValueMap &parameters, std::size_t numUnits) {
+    std::size_t numRows = 0, numColumns = 0;
+    
+    switch (OpenEphysPopulationDecoder::parseType(parameters[OpenEphysSpikeAnalysis::DECODER].str())) {
+        case OpenEphysPopulationDecoder::Type::Linear: {
+            auto weights = parseMatrix(parameters[OpenEphysSpikeAnalysis::DECODER_WEIGHTS],
+                                       numRows,
+                                       numColumns,
+                                       OpenEphysSpikeAnalysis::DECODER_WEIGHTS);
+            if (numColumns != numUnits) {
+                throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                      "Decoder weights must have one column per unit",
+                                      OpenEphysSpikeAnalysis::DECODER_WEIGHTS);
+            }
+            auto offsets = parseVector(parameters[OpenEphysSpikeAnalysis::DECODER_OFFSETS],
+                                       numRows,
+                                       OpenEphysSpikeAnalysis::DECODER_OFFSETS);
+            return std::unique_ptr<OpenEphysPopulationDecoder>(new OpenEphysLinearDecoder(numUnits,
+                                                                                          numRows,
+                                                                                          std::move(weights),
+                                                                                          std::move(offsets)));
+        }
+            
+        case OpenEphysPopulationDecoder::Type::Kalman: {
+            auto transition = parseMatrix(parameters[OpenEphysSpikeAnalysis::DECODER_TRANSITION],
+                                          numRows,
+                                          numColumns,
+                                          OpenEphysSpikeAnalysis::DECODER_TRANSITION);
+            if (numRows != numColumns) {
+                throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                      "Decoder transition matrix must be square",
+                                      OpenEphysSpikeAnalysis::DECODER_TRANSITION);
+            }
+            const std::size_t numStates = numRows;
+            auto observation = parseMatrix(parameters[OpenEphysSpikeAnalysis::DECODER_OBSERVATION],
+                                           numRows,
+                                           numColumns,
+                                           OpenEphysSpikeAnalysis::DECODER_OBSERVATION);
+            if (numRows != numUnits || numColumns != numStates) {
+                throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                      "Decoder observation matrix must have one row per unit and one column per "
+                                      "state element",
+                                      OpenEphysSpikeAnalysis::DECODER_OBSERVATION);
+            }
+            return std::unique_ptr<OpenEphysPopulationDecoder>(
+                new OpenEphysKalmanDecoder(numUnits,
+                                           numStates,
+                                           std::move(transition),
+                                           parseCovariance(parameters[OpenEphysSpikeAnalysis::DECODER_PROCESS_NOISE],
+                                                           numStates,
+                                                           OpenEphysSpikeAnalysis::DECODER_PROCESS_NOISE),
+                                           std::move(observation),
+                                           parseVector(parameters[OpenEphysSpikeAnalysis::DECODER_BASELINE],
+                                                       numUnits,
+                                                       OpenEphysSpikeAnalysis::DECODER_BASELINE),
+                                           parseCovariance(parameters[OpenEphysSpikeAnalysis::DECODER_OBSERVATION_NOISE],
+                                                           numUnits,
+                                                           OpenEphysSpikeAnalysis::DECODER_OBSERVATION_NOISE)));
+        }
+    }
+    
+    return nullptr;
+}
+
+
+END_NAMESPACE()
+
+
+const std::string OpenEphysSpikeAnalysis::CLOCK_SOURCE("clock_source");
+const std::string OpenEphysSpikeAnalysis::UNITS("units");
+const std::string OpenEphysSpikeAnalysis::STA_VARIABLES("sta_variables");
+const std::string OpenEphysSpikeAnalysis::STA_WINDOW("sta_window");
+const std::string OpenEphysSpikeAnalysis::STA_BIN_WIDTH("sta_bin_width");
+const std::string OpenEphysSpikeAnalysis::STA_HISTORY_SIZE("sta_history_size");
+const std::string OpenEphysSpikeAnalysis::STA_QUERY("sta_query");
+const std::string OpenEphysSpikeAnalysis::STA_RESULT("sta_result");
+const std::string OpenEphysSpikeAnalysis::CCG_WINDOW("ccg_window");
+const std::string OpenEphysSpikeAnalysis::CCG_BIN_WIDTH("ccg_bin_width");
+const std::string OpenEphysSpikeAnalysis::CCG_QUERY("ccg_query");
+const std::string OpenEphysSpikeAnalysis::CCG_RESULT("ccg_result");
+const std::string OpenEphysSpikeAnalysis::DECODER("decoder");
+const std::string OpenEphysSpikeAnalysis::DECODER_BIN_WIDTH("decoder_bin_width");
+const std::string OpenEphysSpikeAnalysis::DECODER_DELAY("decoder_delay");
+const std::string OpenEphysSpikeAnalysis::DECODER_WEIGHTS("decoder_weights");
+const std::string OpenEphysSpikeAnalysis::DECODER_OFFSETS("decoder_offsets");
+const std::string OpenEphysSpikeAnalysis::DECODER_TRANSITION("decoder_transition");
+const std::string OpenEphysSpikeAnalysis::DECODER_PROCESS_NOISE("decoder_process_noise");
+const std::string OpenEphysSpikeAnalysis::DECODER_OBSERVATION("decoder_observation");
+const std::string OpenEphysSpikeAnalysis::DECODER_BASELINE("decoder_baseline");
+const std::string OpenEphysSpikeAnalysis::DECODER_OBSERVATION_NOISE("decoder_observation_noise");
+const std::string OpenEphysSpikeAnalysis::DECODER_OUTPUT("decoder_output");
+const std::string OpenEphysSpikeAnalysis::DECODER_LATENCY("decoder_latency");
+
+
+void OpenEphysSpikeAnalysis::describeComponent(ComponentInfo &info) {
+    OpenEphysBase::describeComponent(info);
+    
+    info.setSignature("iodevice/open_ephys_spike_analysis");
+    
+    info.addParameter(CLOCK_SOURCE);
+    info.addParameter(UNITS);
+    info.addParameter(STA_VARIABLES, false);
+    info.addParameter(STA_WINDOW, "200ms");
+    info.addParameter(STA_BIN_WIDTH, "10ms");
+    info.addParameter(STA_HISTORY_SIZE, "10000");
+    info.addParameter(STA_QUERY, false);
+    info.addParameter(STA_RESULT, false);
+    info.addParameter(CCG_WINDOW, "50ms");
+    info.addParameter(CCG_BIN_WIDTH, "1ms");
+    info.addParameter(CCG_QUERY, false);
+    info.addParameter(CCG_RESULT, false);
+    info.addParameter(DECODER, "linear");
+    info.addParameter(DECODER_BIN_WIDTH, "50ms");
+    info.addParameter(DECODER_DELAY, "10ms");
+    info.addParameter(DECODER_WEIGHTS, false);
+    info.addParameter(DECODER_OFFSETS, false);
+    info.addParameter(DECODER_TRANSITION, false);
+    info.addParameter(DECODER_PROCESS_NOISE, false);
+    info.addParameter(DECODER_OBSERVATION, false);
+    info.addParameter(DECODER_BASELINE, false);
+    info.addParameter(DECODER_OBSERVATION_NOISE, false);
+    info.addParameter(DECODER_OUTPUT, false);
+    info.addParameter(DECODER_LATENCY, false);
+}
+
+
+OpenEphysSpikeAnalysis::OpenEphysSpikeAnalysis(const ParameterValueMap &parameters) :
+    OpenEphysBase(parameters),
+    clockSource(parameters[CLOCK_SOURCE].str()),
+    decoderBinWidth(parameters[DECODER_BIN_WIDTH]),
+    decoderDelay(parameters[DECODER_DELAY]),
+    warnedUnsynchronized(false),
+    numPendingBins(0),
+    firstPendingBin(0),
+    binStartTime(0),
+    decoderStartTime(0),
+    warnedLateSpikes(false),
+    eventReceiver(*this),
+    running(false)
+{
+    std::vector<Datum> unitValues;
+    ParsedExpressionVariable::evaluateExpressionList(parameters[UNITS].str(), unitValues);
+    for (auto &value : unitValues) {
+        if (!value.isList() || value.getNElements() != 2) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                  "Each unit must be a list containing an electrode ID and a sorted ID");
+        }
+        const Unit unit { int(value.getElement(0).getInteger()), int(value.getElement(1).getInteger()) };
+        if (!unitIndexes.emplace(getUnitKey(unit.electrodeID, unit.sortedID), units.size()).second) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Duplicate unit", value.toString());
+        }
+        units.push_back(unit);
+    }
+    if (units.empty()) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "At least one unit is required");
+    }
+    
+    if (!parameters[STA_VARIABLES].empty()) {
+        staVariables = getVariables(parameters[STA_VARIABLES].str());
+        sta.reset(new OpenEphysSpikeTriggeredAverage(staVariables.size(),
+                                                     units.size(),
+                                                     MWTime(parameters[STA_WINDOW]),
+                                                     MWTime(parameters[STA_BIN_WIDTH]),
+                                                     getHistorySize(parameters[STA_HISTORY_SIZE])));
+        if (parameters[STA_QUERY].empty() || parameters[STA_RESULT].empty()) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                  "Spike-triggered average query and result variables are required when "
+                                  "spike-triggered average variables are provided");
+        }
+        staQuery = VariablePtr(parameters[STA_QUERY]);
+        staResult = VariablePtr(parameters[STA_RESULT]);
+    }
+    
+    if (!parameters[CCG_QUERY].empty()) {
+        if (parameters[CCG_RESULT].empty()) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                  "Cross-correlogram result variable is required when cross-correlogram query is "
+                                  "provided");
+        }
+        ccg.reset(new OpenEphysCrossCorrelogram(units.size(),
+                                                MWTime(parameters[CCG_WINDOW]),
+                                                MWTime(parameters[CCG_BIN_WIDTH])));
+        ccgQuery = VariablePtr(parameters[CCG_QUERY]);
+        ccgResult = VariablePtr(parameters[CCG_RESULT]);
+    }
+    
+    if (!parameters[DECODER_OUTPUT].empty()) {
+        if (decoderBinWidth <= 0) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decoder bin width must be greater than zero");
+        }
+        if (decoderDelay < 0) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Decoder delay must be non-negative");
+        }
+        decoder = createDecoder(parameters, units.size());
+        decoderOutput = VariablePtr(parameters[DECODER_OUTPUT]);
+        if (!parameters[DECODER_LATENCY].empty()) {
+            decoderLatency = VariablePtr(parameters[DECODER_LATENCY]);
+        }
+        
+        // Keep counting spikes in later bins while waiting for the delay to pass on earlier ones
+        numPendingBins = std::size_t((decoderDelay + decoderBinWidth - 1) / decoderBinWidth) + 2;
+        binCounts.assign(numPendingBins * units.size(), 0.0);
+        decodedValues.assign(decoder->getNumOutputs(), 0.0);
+    }
+    
+    if (!sta && !ccg && !decoder) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "No spike analysis is configured");
+    }
+}
+
+
+OpenEphysSpikeAnalysis::~OpenEphysSpikeAnalysis() {
+    eventReceiver.stop();
+}
+
+
+bool OpenEphysSpikeAnalysis::initialize() {
+    zmqSocket.reset(zmq_socket(getZMQContext(), ZMQ_SUB));
+    if (!zmqSocket) {
+        logZMQError("Unable to create ZeroMQ socket");
+        return false;
+    }
+    
+    if (!eventReceiver.configure(zmqSocket.get())) {
+        return false;
+    }
+    
+    boost::weak_ptr<OpenEphysSpikeAnalysis> weakThis(component_shared_from_this<OpenEphysSpikeAnalysis>());
+    
+    if (sta) {
+        for (std::size_t index = 0; index < staVariables.size(); index++) {
+            auto valueNotification = [weakThis, index](const Datum &data, MWTime time) {
+                if (auto sharedThis = weakThis.lock()) {
+                    if (data.isNumber()) {
+                        sharedThis->sta->addValue(index, time, data.getFloat());
+                    }
+                }
+            };
+            staVariables[index]->addNotification(boost::make_shared<VariableCallbackNotification>(valueNotification));
+        }
+        
+        auto queryNotification = [weakThis](const Datum &data, MWTime time) {
+            if (auto sharedThis = weakThis.lock()) {
+                sharedThis->handleSTAQuery(data);
+            }
+        };
+        staQuery->addNotification(boost::make_shared<VariableCallbackNotification>(queryNotification));
+    }
+    
+    if (ccg) {
+        auto queryNotification = [weakThis](const Datum &data, MWTime time) {
+            if (auto sharedThis = weakThis.lock()) {
+                sharedThis->handleCCGQuery(data);
+            }
+        };
+        ccgQuery->addNotification(boost::make_shared<VariableCallbackNotification>(queryNotification));
+    }
+    
+    return true;
+}
+
+
+bool OpenEphysSpikeAnalysis::startDeviceIO() {
+    scoped_lock lock(mutex);
+    
+    if (!running) {
+        if (0 != zmq_connect(zmqSocket.get(), endpoint.c_str())) {
+            logZMQError("Unable to connect to Open Ephys GUI");
+            return false;
+        }
+        
+        warnedUnsynchronized = false;
+        
+        if (sta) {
+            // Variables are reported only when they change, so start each history with the current value
+            sta->clear();
+            const MWTime currentTime = currentTimeUS();
+            for (std::size_t index = 0; index < staVariables.size(); index++) {
+                const Datum value = staVariables[index]->getValue();
+                if (value.isNumber()) {
+                    sta->addValue(index, currentTime, value.getFloat());
+                }
+            }
+        }
+        
+        if (ccg) {
+            // Open Ephys timestamps may restart with the new acquisition
+            ccg->clear();
+        }
+        
+        if (decoder) {
+            decoder->reset();
+            std::fill(binCounts.begin(), binCounts.end(), 0.0);
+            firstPendingBin = 0;
+            binStartTime = decoderStartTime = currentTimeUS();
+            warnedLateSpikes = false;
+        }
+        
+        eventReceiver.start();
+        
+        running = true;
+    }
+    
+    return true;
+}
+
+
+bool OpenEphysSpikeAnalysis::stopDeviceIO() {
+    scoped_lock lock(mutex);
+    
+    if (running) {
+        eventReceiver.stop();
+        
+        if (0 != zmq_disconnect(zmqSocket.get(), endpoint.c_str())) {
+            logZMQError("Unable to disconnect from Open Ephys GUI");
+            return false;
+        }
+        
+        running = false;
+    }
+    
+    return true;
+}
+
+
+MWTime OpenEphysSpikeAnalysis::getUpdateInterval() const {
+    if (decoder) {
+        // Wake up often enough to decode each bin as soon as its delay has passed
+        return 1000;
+    }
+    return 500000;
+}
+
+
+void OpenEphysSpikeAnalysis::handleEvent(std::uint8_t type,
+                                         double timestamp,
+                                         const std::uint8_t *body,
+                                         std::size_t size)
+{
+    if (OpenEphysEvent::spikeType == type) {
+        OpenEphysEvent::Spike spike;
+        std::memset(&spike, 0, sizeof(spike));
+        std::memcpy(&spike, body, std::min(sizeof(spike), size));
+        handleSpike(spike, timestamp);
+    }
+}
+
+
+void OpenEphysSpikeAnalysis::update() {
+    if (decoder) {
+        updateDecoder(currentTimeUS());
+    }
+}
+
+
+void OpenEphysSpikeAnalysis::handleSpike(const OpenEphysEvent::Spike &spike, double timestamp) {
+    auto iter = unitIndexes.find(getUnitKey(spike.electrodeID, spike.sortedID));
+    if (iter == unitIndexes.end()) {
+        return;
+    }
+    const std::size_t unitIndex = iter->second;
+    
+    if (ccg) {
+        ccg->addSpike(unitIndex, secsToUS(timestamp));
+    }
+    
+    if (sta || decoder) {
+        MWTime time = 0;
+        if (convertTimestamp(timestamp, time)) {
+            if (sta) {
+                sta->addSpike(unitIndex, time);
+            }
+            if (decoder) {
+                binSpike(unitIndex, time);
+            }
+        }
+    }
+}
+
+
+bool OpenEphysSpikeAnalysis::convertTimestamp(double timestamp, MWTime &time) {
+    if (!clockService) {
+        // The interface providing the clock may not have been initialized when we were
+        clockService = OpenEphysClockService::lookup(clockSource);
+    }
+    if (clockService && clockService->convertSeconds(timestamp, time)) {
+        warnedUnsynchronized = false;
+        return true;
+    }
+    if (!warnedUnsynchronized) {
+        mwarning(M_IODEVICE_MESSAGE_DOMAIN,
+                 "Open Ephys clock from %s is not available; discarding spikes until it is",
+                 clockSource.c_str());
+        warnedUnsynchronized = true;
+    }
+    return false;
+}
+
+
+bool OpenEphysSpikeAnalysis::isClockAvailable() {
+    if (!clockService) {
+        clockService = OpenEphysClockService::lookup(clockSource);
+    }
+    MWTime time = 0;
+    return (clockService && clockService->convertSeconds(0.0, time));
+}
+
+
+void OpenEphysSpikeAnalysis::handleSTAQuery(const Datum &query) {
+    std::vector<std::size_t> selectedUnits;
+    if (query.isDictionary()) {
+        if (query.getElement("reset").getBool()) {
+            sta->clearAverages();
+            staResult->setValue(Datum(M_DICTIONARY, 0));
+            return;
+        }
+        const Datum electrodeID = query.getElement("electrode_id");
+        const Datum sortedID = query.getElement("sorted_id");
+        if (electrodeID.isNumber() && sortedID.isNumber()) {
+            auto iter = unitIndexes.find(getUnitKey(int(electrodeID.getInteger()), int(sortedID.getInteger())));
+            if (iter == unitIndexes.end()) {
+                merror(M_IODEVICE_MESSAGE_DOMAIN, "Spike-triggered average query requests an unknown unit");
+                return;
+            }
+            selectedUnits.push_back(iter->second);
+        }
+    }
+    if (selectedUnits.empty()) {
+        for (std::size_t unitIndex = 0; unitIndex < units.size(); unitIndex++) {
+            selectedUnits.push_back(unitIndex);
+        }
+    }
+    
+    std::vector<double> average;
+    Datum unitResults(M_LIST, int(selectedUnits.size()));
+    for (auto unitIndex : selectedUnits) {
+        std::size_t count = 0;
+        Datum averages(M_DICTIONARY, int(staVariables.size()));
+        for (std::size_t variable = 0; variable < staVariables.size(); variable++) {
+            count = sta->getAverage(unitIndex, variable, average);
+            Datum values(M_LIST, int(average.size()));
+            for (auto value : average) {
+                values.addElement(Datum(value));
+            }
+            averages.addElement(Datum(staVariables[variable]->getVariableName()), values);
+        }
+        
+        Datum unitResult(M_DICTIONARY, 4);
+        unitResult.addElement("electrode_id", long(units[unitIndex].electrodeID));
+        unitResult.addElement("sorted_id", long(units[unitIndex].sortedID));
+        unitResult.addElement("count", (long long)count);
+        unitResult.addElement("averages", averages);
+        unitResults.addElement(unitResult);
+    }
+    
+    Datum result(M_DICTIONARY, 3);
+    result.addElement("window", MWTime(sta->getNumBins()) * sta->getBinWidth());
+    result.addElement("bin_width", sta->getBinWidth());
+    result.addElement("units", unitResults);
+    staResult->setValue(result);
+}
+
+
+void OpenEphysSpikeAnalysis::handleCCGQuery(const Datum &query) {
+    std::vector<std::size_t> referenceUnits;
+    if (query.isDictionary()) {
+        if (query.getElement("reset").getBool()) {
+            ccg->clearCorrelograms();
+            ccgResult->setValue(Datum(M_DICTIONARY, 0));
+            return;
+        }
+        const Datum electrodeID = query.getElement("electrode_id");
+        const Datum sortedID = query.getElement("sorted_id");
+        if (electrodeID.isNumber() && sortedID.isNumber()) {
+            auto iter = unitIndexes.find(getUnitKey(int(electrodeID.getInteger()), int(sortedID.getInteger())));
+            if (iter == unitIndexes.end()) {
+                merror(M_IODEVICE_MESSAGE_DOMAIN, "Cross-correlogram query requests an unknown unit");
+                return;
+            }
+            referenceUnits.push_back(iter->second);
+        }
+    }
+    if (referenceUnits.empty()) {
+        for (std::size_t unitIndex = 0; unitIndex < units.size(); unitIndex++) {
+            referenceUnits.push_back(unitIndex);
+        }
+    }
+    
+    auto getUnitID = [this](std::size_t unitIndex) {
+        Datum unitID(M_LIST, 2);
+        unitID.addElement(Datum(long(units[unitIndex].electrodeID)));
+        unitID.addElement(Datum(long(units[unitIndex].sortedID)));
+        return unitID;
+    };
+    
+    Datum unitResults(M_LIST, int(units.size()));
+    for (std::size_t unitIndex = 0; unitIndex < units.size(); unitIndex++) {
+        Datum unitResult(M_DICTIONARY, 3);
+        unitResult.addElement("electrode_id", long(units[unitIndex].electrodeID));
+        unitResult.addElement("sorted_id", long(units[unitIndex].sortedID));
+        unitResult.addElement("count", (long long)ccg->getSpikeCount(unitIndex));
+        unitResults.addElement(unitResult);
+    }
+    
+    std::vector<std::uint64_t> counts;
+    Datum correlograms(M_LIST, int(referenceUnits.size() * units.size()));
+    for (auto reference : referenceUnits) {
+        for (std::size_t target = 0; target < units.size(); target++) {
+            ccg->getCorrelogram(reference, target, counts);
+            Datum values(M_LIST, int(counts.size()));
+            for (auto count : counts) {
+                values.addElement(Datum((long long)count));
+            }
+            
+            Datum correlogram(M_DICTIONARY, 3);
+            correlogram.addElement("reference", getUnitID(reference));
+            correlogram.addElement("target", getUnitID(target));
+            correlogram.addElement("counts", values);
+            correlograms.addElement(correlogram);
+        }
+    }
+    
+    Datum result(M_DICTIONARY, 4);
+    result.addElement("window", ccg->getWindow());
+    result.addElement("bin_width", ccg->getBinWidth());
+    result.addElement("units", unitResults);
+    result.addElement("correlograms", correlograms);
+    ccgResult->setValue(result);
+}
+
+
+void OpenEphysSpikeAnalysis::binSpike(std::size_t unitIndex, MWTime time) {
+    if (time < binStartTime) {
+        // Spikes from before the start of IO are expected, but later ones mean the delay is too short
+        if (time >= decoderStartTime && !warnedLateSpikes) {
+            mwarning(M_IODEVICE_MESSAGE_DOMAIN,
+                     "Open Ephys spikes are arriving after their decoder bins have been decoded; consider "
+                     "increasing %s",
+                     DECODER_DELAY.c_str());
+            warnedLateSpikes = true;
+        }
+        return;
+    }
+    
+    const std::size_t bin = std::size_t((time - binStartTime) / decoderBinWidth);
+    if (bin >= numPendingBins) {
+        // The spike is ahead of the current time (e.g. because the clock model just changed), so it
+        // belongs to a bin that isn't being counted yet
+        return;
+    }
+    binCounts[((firstPendingBin + bin) % numPendingBins) * units.size() + unitIndex] += 1.0;
+}
+
+
+void OpenEphysSpikeAnalysis::updateDecoder(MWTime currentTime) {
+    while (currentTime - binStartTime >= decoderBinWidth + decoderDelay) {
+        decodeBin();
+    }
+}
+
+
+void OpenEphysSpikeAnalysis::decodeBin() {
+    double *counts = binCounts.data() + firstPendingBin * units.size();
+    const MWTime binEndTime = binStartTime + decoderBinWidth;
+    
+    // Without the clock, spikes can't be binned, so an empty bin doesn't mean that no spikes occurred
+    if (isClockAvailable()) {
+        decoder->decode(counts, decodedValues.data());
+        
+        Datum values(M_LIST, int(decodedValues.size()));
+        for (auto value : decodedValues) {
+            values.addElement(Datum(value));
+        }
+        
+        const MWTime currentTime = currentTimeUS();
+        decoderOutput->setValue(values, currentTime);
+        if (decoderLatency) {
+            decoderLatency->setValue(Datum(currentTime - binEndTime), currentTime);
+        }
+    }
+    
+    std::fill(counts, counts + units.size(), 0.0);
+    firstPendingBin = (firstPendingBin + 1) % numPendingBins;
+    binStartTime = binEndTime;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,137 @@
+//
+//  OpenEphysSpikeAnalysis.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysSpikeAnalysis_hpp
+#define OpenEphysSpikeAnalysis_hpp
+
+#include "OpenEphysBase.hpp"
+#include "OpenEphysClockService.hpp"
+#include "OpenEphysCrossCorrelogram.hpp"
+#include "OpenEphysEventReceiver.hpp"
+#include "OpenEphysPopulationDecoder.hpp"
+#include "OpenEphysSpikeTriggeredAverage.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Online analysis of the spikes of selected units.  Receives spikes directly from the Open Ephys Event
+// Broadcaster, via an event receiver of its own.  Spike-triggered averages relate spikes to MWorks variables, so they use spike times
+// converted to the MWorks clock via the clock service of an Open Ephys Interface.  Cross-correlograms
+// depend only on the intervals between spikes, so they use the Open Ephys clock directly.  The
+// population decoder bins spikes on the MWorks clock, and decodes each bin once its spikes have had
+// time to arrive.
+//
+class OpenEphysSpikeAnalysis : public OpenEphysBase, OpenEphysEventHandler {
+    
+public:
+    static const std::string CLOCK_SOURCE;
+    static const std::string UNITS;
+    static const std::string STA_VARIABLES;
+    static const std::string STA_WINDOW;
+    static const std::string STA_BIN_WIDTH;
+    static const std::string STA_HISTORY_SIZE;
+    static const std::string STA_QUERY;
+    static const std::string STA_RESULT;
+    static const std::string CCG_WINDOW;
+    static const std::string CCG_BIN_WIDTH;
+    static const std::string CCG_QUERY;
+    static const std::string CCG_RESULT;
+    static const std::string DECODER;
+    static const std::string DECODER_BIN_WIDTH;
+    static const std::string DECODER_DELAY;
+    static const std::string DECODER_WEIGHTS;
+    static const std::string DECODER_OFFSETS;
+    static const std::string DECODER_TRANSITION;
+    static const std::string DECODER_PROCESS_NOISE;
+    static const std::string DECODER_OBSERVATION;
+    static const std::string DECODER_BASELINE;
+    static const std::string DECODER_OBSERVATION_NOISE;
+    static const std::string DECODER_OUTPUT;
+    static const std::string DECODER_LATENCY;
+    
+    static void describeComponent(ComponentInfo &info);
+    
+    explicit OpenEphysSpikeAnalysis(const ParameterValueMap &parameters);
+    ~OpenEphysSpikeAnalysis();
+    
+    bool initialize() override;
+    bool startDeviceIO() override;
+    bool stopDeviceIO() override;
+    
+private:
+    struct Unit {
+        int electrodeID;
+        int sortedID;
+    };
+    
+    static std::uint32_t getUnitKey(int electrodeID, int sortedID) {
+        return (std::uint32_t(electrodeID & 0xFFFF) << 16) | std::uint32_t(sortedID & 0xFFFF);
+    }
+    
+    bool needsSyncWords() const override { return false; }
+    bool needsSpikes() const override { return true; }
+    MWTime getUpdateInterval() const override;
+    std::size_t getMaxEventSize() const override { return sizeof(OpenEphysEvent::Spike); }
+    void begin() override { }
+    void handleEvent(std::uint8_t type, double timestamp, const std::uint8_t *body, std::size_t size) override;
+    void update() override;
+    void end() override { }
+    
+    void handleSpike(const OpenEphysEvent::Spike &spike, double timestamp);
+    bool convertTimestamp(double timestamp, MWTime &time);
+    bool isClockAvailable();
+    void handleSTAQuery(const Datum &query);
+    void handleCCGQuery(const Datum &query);
+    void binSpike(std::size_t unitIndex, MWTime time);
+    void updateDecoder(MWTime currentTime);
+    void decodeBin();
+    
+    const std::string clockSource;
+    std::vector<Unit> units;
+    std::unordered_map<std::uint32_t, std::size_t> unitIndexes;
+    
+    std::vector<VariablePtr> staVariables;
+    std::unique_ptr<OpenEphysSpikeTriggeredAverage> sta;
+    VariablePtr staQuery;
+    VariablePtr staResult;
+    
+    std::unique_ptr<OpenEphysCrossCorrelogram> ccg;
+    VariablePtr ccgQuery;
+    VariablePtr ccgResult;
+    
+    std::unique_ptr<OpenEphysPopulationDecoder> decoder;
+    MWTime decoderBinWidth;
+    MWTime decoderDelay;
+    VariablePtr decoderOutput;
+    VariablePtr decoderLatency;
+    
+    // Used only by the event receiver thread
+    boost::shared_ptr<OpenEphysClockService> clockService;
+    bool warnedUnsynchronized;
+    std::size_t numPendingBins;
+    std::vector<double> binCounts;  // Ring of pending bins, each with one count per unit
+    std::size_t firstPendingBin;
+    MWTime binStartTime;  // Of the first pending bin
+    MWTime decoderStartTime;
+    std::vector<double> decodedValues;
+    bool warnedLateSpikes;
+    
+    OpenEphysEventReceiver eventReceiver;
+    std::mutex mutex;
+    using scoped_lock = std::lock_guard<decltype(mutex)>;
+    
+    bool running;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysSpikeAnalysis_hpp */
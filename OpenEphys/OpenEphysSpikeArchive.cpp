@@ -0,0 +1,323 @@
+//
+//  OpenEphysSpikeArchive.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysSpikeArchive.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+constexpr std::size_t minColumnCapacity = 65536;  // rows
+constexpr auto writerInterval = std::chrono::milliseconds(10);
+
+const std::string metadataFilename("archive.txt");
+
+
+void logSystemError(const std::string &message, const std::string &path) {
+    merror(M_IODEVICE_MESSAGE_DOMAIN, "%s (%s): %s", message.c_str(), path.c_str(), std::strerror(errno));
+}
+
+
+END_NAMESPACE()
+
+
+OpenEphysSpikeArchive::Column::Column(const std::string &path, std::size_t elementSize) :
+    path(path),
+    elementSize(elementSize),
+    fd(-1),
+    data(nullptr),
+    capacity(0)
+{ }
+
+
+OpenEphysSpikeArchive::Column::~Column() {
+    if (data) {
+        munmap(data, capacity * elementSize);
+    }
+    if (-1 != fd) {
+        ::close(fd);
+    }
+}
+
+
+bool OpenEphysSpikeArchive::Column::open(std::size_t existingRows) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (-1 == fd) {
+        logSystemError("Unable to open spike archive column", path);
+        return false;
+    }
+    return reserve(std::max(existingRows, minColumnCapacity));
+}
+
+
+bool OpenEphysSpikeArchive::Column::reserve(std::size_t rows) {
+    if (rows <= capacity) {
+        return true;
+    }
+    
+    const std::size_t newCapacity = std::max({ rows, 2 * capacity, minColumnCapacity });
+    if (data) {
+        munmap(data, capacity * elementSize);
+        data = nullptr;
+        capacity = 0;
+    }
+    
+    if (0 != ftruncate(fd, off_t(newCapacity * elementSize))) {
+        logSystemError("Unable to extend spike archive column", path);
+        return false;
+    }
+    
+    void *newData = mmap(nullptr, newCapacity * elementSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == newData) {
+        logSystemError("Unable to map spike archive column", path);
+        return false;
+    }
+    
+    data = newData;
+    capacity = newCapacity;
+    return true;
+}
+
+
+bool OpenEphysSpikeArchive::Column::sync(std::size_t rows) {
+    if (data && rows > 0 && 0 != msync(data, rows * elementSize, MS_ASYNC)) {
+        logSystemError("Unable to sync spike archive column", path);
+        return false;
+    }
+    return true;
+}
+
+
+void OpenEphysSpikeArchive::Column::close(std::size_t rows) {
+    if (data) {
+        munmap(data, capacity * elementSize);
+        data = nullptr;
+        capacity = 0;
+    }
+    if (-1 != fd) {
+        // Trim unused preallocated space
+        if (0 != ftruncate(fd, off_t(rows * elementSize))) {
+            logSystemError("Unable to trim spike archive column", path);
+        }
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+
+OpenEphysSpikeArchive::OpenEphysSpikeArchive(const std::string &directory, std::size_t queueCapacity) :
+    directory(directory),
+    queue(queueCapacity),
+    queueHead(0),
+    queueTail(0),
+    droppedCount(0),
+    numRows(0),
+    writerRunning(false)
+{ }
+
+
+OpenEphysSpikeArchive::~OpenEphysSpikeArchive() {
+    close();
+}
+
+
+bool OpenEphysSpikeArchive::open() {
+    if (writerThread.joinable()) {
+        return true;
+    }
+    
+    if (0 != mkdir(directory.c_str(), 0755) && EEXIST != errno) {
+        logSystemError("Unable to create spike archive directory", directory);
+        return false;
+    }
+    
+    // Append to an existing archive, if there is one
+    numRows = readExistingRows();
+    
+    timeColumn.reset(new Column(directory + "/time.i64", sizeof(std::int64_t)));
+    sampleColumn.reset(new Column(directory + "/sample.i64", sizeof(std::int64_t)));
+    electrodeColumn.reset(new Column(directory + "/electrode.u16", sizeof(std::uint16_t)));
+    unitColumn.reset(new Column(directory + "/unit.u16", sizeof(std::uint16_t)));
+    channelColumn.reset(new Column(directory + "/channel.u16", sizeof(std::uint16_t)));
+    indexColumn.reset(new Column(directory + "/index.i64", 2 * sizeof(std::int64_t)));
+    
+    const std::size_t numIndexRows = (numRows + indexInterval - 1) / indexInterval;
+    if (!timeColumn->open(numRows) ||
+        !sampleColumn->open(numRows) ||
+        !electrodeColumn->open(numRows) ||
+        !unitColumn->open(numRows) ||
+        !channelColumn->open(numRows) ||
+        !indexColumn->open(numIndexRows) ||
+        !writeMetadata())
+    {
+        return false;
+    }
+    
+    queueHead = 0;
+    queueTail = 0;
+    droppedCount = 0;
+    
+    writerRunning = true;
+    writerThread = std::thread([this]() {
+        runWriter();
+    });
+    
+    return true;
+}
+
+
+void OpenEphysSpikeArchive::close() {
+    if (!writerThread.joinable()) {
+        return;
+    }
+    
+    writerRunning = false;
+    writerThread.join();
+    
+    const std::size_t numIndexRows = (numRows + indexInterval - 1) / indexInterval;
+    timeColumn->close(numRows);
+    sampleColumn->close(numRows);
+    electrodeColumn->close(numRows);
+    unitColumn->close(numRows);
+    channelColumn->close(numRows);
+    indexColumn->close(numIndexRows);
+    
+    if (droppedCount > 0) {
+        mwarning(M_IODEVICE_MESSAGE_DOMAIN,
+                 "Spike archive writer fell behind; %lu spikes were not archived",
+                 (unsigned long)droppedCount.load());
+    }
+}
+
+
+bool OpenEphysSpikeArchive::append(const Record &record) {
+    const std::size_t head = queueHead.load(std::memory_order_relaxed);
+    if (head - queueTail.load(std::memory_order_acquire) >= queue.size()) {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    queue[head % queue.size()] = record;
+    queueHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+
+void OpenEphysSpikeArchive::runWriter() {
+    bool running = true;
+    while (running) {
+        // Read the flag before draining, so that we drain once more after being stopped
+        running = writerRunning;
+        if (drainQueue() > 0) {
+            writeMetadata();
+        } else if (running) {
+            std::this_thread::sleep_for(writerInterval);
+        }
+    }
+}
+
+
+std::size_t OpenEphysSpikeArchive::drainQueue() {
+    const std::size_t head = queueHead.load(std::memory_order_acquire);
+    std::size_t tail = queueTail.load(std::memory_order_relaxed);
+    const std::size_t numRecords = head - tail;
+    if (numRecords == 0) {
+        return 0;
+    }
+    
+    const std::size_t newNumRows = numRows + numRecords;
+    if (!timeColumn->reserve(newNumRows) ||
+        !sampleColumn->reserve(newNumRows) ||
+        !electrodeColumn->reserve(newNumRows) ||
+        !unitColumn->reserve(newNumRows) ||
+        !channelColumn->reserve(newNumRows) ||
+        !indexColumn->reserve(newNumRows / indexInterval + 1))
+    {
+        // Discard the records, so that the producer doesn't stall
+        droppedCount.fetch_add(numRecords, std::memory_order_relaxed);
+        queueTail.store(head, std::memory_order_release);
+        return 0;
+    }
+    
+    for (; tail != head; tail++) {
+        const auto &record = queue[tail % queue.size()];
+        const std::int64_t time = record.time;
+        std::memcpy(timeColumn->at(numRows), &time, sizeof(time));
+        std::memcpy(sampleColumn->at(numRows), &record.sampleNumber, sizeof(record.sampleNumber));
+        std::memcpy(electrodeColumn->at(numRows), &record.electrodeID, sizeof(record.electrodeID));
+        std::memcpy(unitColumn->at(numRows), &record.sortedID, sizeof(record.sortedID));
+        std::memcpy(channelColumn->at(numRows), &record.channel, sizeof(record.channel));
+        if (numRows % indexInterval == 0) {
+            const std::int64_t entry[2] = { time, std::int64_t(numRows) };
+            std::memcpy(indexColumn->at(numRows / indexInterval), entry, sizeof(entry));
+        }
+        numRows++;
+    }
+    queueTail.store(tail, std::memory_order_release);
+    
+    timeColumn->sync(numRows);
+    sampleColumn->sync(numRows);
+    electrodeColumn->sync(numRows);
+    unitColumn->sync(numRows);
+    channelColumn->sync(numRows);
+    indexColumn->sync((numRows + indexInterval - 1) / indexInterval);
+    
+    return numRecords;
+}
+
+
+bool OpenEphysSpikeArchive::writeMetadata() const {
+    const std::string path = directory + "/" + metadataFilename;
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream output(tempPath, std::ios::trunc);
+        output << "format open_ephys_spike_archive\n"
+               << "version 1\n"
+               << "rows " << numRows << '\n'
+               << "index_interval " << indexInterval << '\n'
+               << "column time int64\n"
+               << "column sample int64\n"
+               << "column electrode uint16\n"
+               << "column unit uint16\n"
+               << "column channel uint16\n"
+               << "index index int64x2\n";
+        if (!output) {
+            logSystemError("Unable to write spike archive metadata", tempPath);
+            return false;
+        }
+    }
+    if (0 != std::rename(tempPath.c_str(), path.c_str())) {
+        logSystemError("Unable to write spike archive metadata", path);
+        return false;
+    }
+    return true;
+}
+
+
+std::size_t OpenEphysSpikeArchive::readExistingRows() const {
+    std::ifstream input(directory + "/" + metadataFilename);
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream fields(line);
+        std::string name;
+        std::size_t rows = 0;
+        if ((fields >> name) && name == "rows" && (fields >> rows)) {
+            return rows;
+        }
+    }
+    return 0;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,98 @@
+//
+//  OpenEphysSpikeArchive.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysSpikeArchive_hpp
+#define OpenEphysSpikeArchive_hpp
+
+#include "OpenEphysSpikeRecord.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Appends decoded spikes to a directory of fixed-width, memory-mapped column files, which analysis
+// code can map directly.  The directory contains:
+//
+//   time.i64       MWorks time (us), native-endian int64
+//   sample.i64     Open Ephys sample number, int64
+//   electrode.u16  Electrode ID, uint16
+//   unit.u16       Sorted unit ID, uint16
+//   channel.u16    Channel, uint16
+//   index.i64      (time, row) int64 pairs for every indexInterval-th row
+//   archive.txt    Format description and the number of valid rows
+//
+// Column files may be longer than the number of valid rows while the archive is open.  Spikes are
+// handed to a background writer thread through a bounded lock-free queue; if the writer falls
+// behind and the queue fills, new spikes are dropped (and counted) rather than blocking the caller.
+//
+class OpenEphysSpikeArchive : boost::noncopyable {
+    
+public:
+    static constexpr std::size_t indexInterval = 1024;
+    
+    using Record = OpenEphysSpikeRecord;
+    
+    explicit OpenEphysSpikeArchive(const std::string &directory, std::size_t queueCapacity = 65536);
+    ~OpenEphysSpikeArchive();
+    
+    bool open();
+    void close();
+    
+    // Called by a single producer thread
+    bool append(const Record &record);
+    
+private:
+    class Column : boost::noncopyable {
+    public:
+        Column(const std::string &path, std::size_t elementSize);
+        ~Column();
+        
+        bool open(std::size_t existingRows);
+        bool reserve(std::size_t rows);
+        void * at(std::size_t row) const { return static_cast<char *>(data) + row * elementSize; }
+        bool sync(std::size_t rows);
+        void close(std::size_t rows);
+        
+    private:
+        const std::string path;
+        const std::size_t elementSize;
+        int fd;
+        void *data;
+        std::size_t capacity;
+    };
+    
+    void runWriter();
+    std::size_t drainQueue();
+    bool writeMetadata() const;
+    std::size_t readExistingRows() const;
+    
+    const std::string directory;
+    
+    std::vector<Record> queue;
+    std::atomic<std::size_t> queueHead;  // Next slot to write (producer)
+    std::atomic<std::size_t> queueTail;  // Next slot to read (writer)
+    std::atomic<std::size_t> droppedCount;
+    
+    std::unique_ptr<Column> timeColumn;
+    std::unique_ptr<Column> sampleColumn;
+    std::unique_ptr<Column> electrodeColumn;
+    std::unique_ptr<Column> unitColumn;
+    std::unique_ptr<Column> channelColumn;
+    std::unique_ptr<Column> indexColumn;
+    std::size_t numRows;
+    
+    std::thread writerThread;
+    std::atomic_bool writerRunning;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysSpikeArchive_hpp */
@@ -0,0 +1,181 @@
+//
+//  OpenEphysSpikeClassifier.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysSpikeClassifier.hpp"
+
+#include "OpenEphysEvent.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+// Dot product with independent partial sums, since the compiler won't reorder a single floating-point
+// accumulation to vectorize it
+inline float dot(const float *x, const float *y, std::size_t n) {
+    constexpr std::size_t numLanes = 8;
+    float partial[numLanes] = {};
+    std::size_t i = 0;
+    for (; i + numLanes <= n; i += numLanes) {
+        for (std::size_t lane = 0; lane < numLanes; lane++) {
+            partial[lane] += x[i + lane] * y[i + lane];
+        }
+    }
+    float total = 0.0f;
+    for (; i < n; i++) {
+        total += x[i] * y[i];
+    }
+    for (std::size_t lane = 0; lane < numLanes; lane++) {
+        total += partial[lane];
+    }
+    return total;
+}
+
+
+END_NAMESPACE()
+
+
+constexpr std::uint16_t OpenEphysSpikeClassifier::unclassifiedID;
+
+
+OpenEphysSpikeClassifier::OpenEphysSpikeClassifier(double maxRMSDistance) :
+    maxRMSDistance(maxRMSDistance),
+    maxWaveformBytes(0)
+{
+    if (maxRMSDistance < 0.0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Spike template distance limit must be non-negative");
+    }
+}
+
+
+void OpenEphysSpikeClassifier::loadTemplates(const std::string &path) {
+    std::ifstream input(path);
+    if (!input) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Unable to open spike template file", path);
+    }
+    
+    std::string line;
+    while (std::getline(input, line)) {
+        const auto start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#') {
+            continue;
+        }
+        
+        std::istringstream fields(line);
+        long electrodeID = 0, unitID = 0;
+        if (!(fields >> electrodeID >> unitID) ||
+            electrodeID < 0 || electrodeID > std::numeric_limits<std::uint16_t>::max() ||
+            unitID < 1 || unitID > std::numeric_limits<std::uint16_t>::max())
+        {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                                  "Spike template must start with an electrode ID and a nonzero unit ID",
+                                  line);
+        }
+        std::vector<float> samples;
+        float sample = 0.0f;
+        while (fields >> sample) {
+            samples.push_back(sample);
+        }
+        if (!fields.eof()) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Spike template contains an invalid sample", line);
+        }
+        
+        addTemplate(std::uint16_t(electrodeID), std::uint16_t(unitID), samples);
+    }
+}
+
+
+void OpenEphysSpikeClassifier::addTemplate(std::uint16_t electrodeID,
+                                           std::uint16_t unitID,
+                                           const std::vector<float> &templateSamples)
+{
+    if (templateSamples.empty()) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Spike template must contain at least one sample");
+    }
+    
+    if (electrodeID >= templateSetIndexes.size()) {
+        templateSetIndexes.resize(std::size_t(electrodeID) + 1, -1);
+    }
+    if (templateSetIndexes[electrodeID] < 0) {
+        templateSetIndexes[electrodeID] = templateSets.size();
+        templateSets.emplace_back();
+        templateSets.back().numSamples = templateSamples.size();
+    }
+    
+    auto &templateSet = templateSets[templateSetIndexes[electrodeID]];
+    if (templateSamples.size() != templateSet.numSamples) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                              "All spike templates for an electrode must have the same number of samples");
+    }
+    templateSet.samples.insert(templateSet.samples.end(), templateSamples.begin(), templateSamples.end());
+    templateSet.squaredNorms.push_back(dot(templateSamples.data(), templateSamples.data(), templateSamples.size()));
+    templateSet.unitIDs.push_back(unitID);
+    
+    // Allow for the thresholds of the largest electrode
+    maxWaveformBytes = std::max(maxWaveformBytes,
+                                (OpenEphysEvent::maxSpikeChannels + templateSamples.size()) * sizeof(float));
+    samples.resize(std::max(samples.size(), templateSamples.size()));
+}
+
+
+std::size_t OpenEphysSpikeClassifier::getNumTemplates() const {
+    std::size_t numTemplates = 0;
+    for (auto &templateSet : templateSets) {
+        numTemplates += templateSet.unitIDs.size();
+    }
+    return numTemplates;
+}
+
+
+std::uint16_t OpenEphysSpikeClassifier::classify(std::uint16_t electrodeID,
+                                                 std::size_t numChannels,
+                                                 const std::uint8_t *payload,
+                                                 std::size_t numBytes)
+{
+    if (electrodeID >= templateSetIndexes.size() || templateSetIndexes[electrodeID] < 0) {
+        return unclassifiedID;
+    }
+    const auto &templateSet = templateSets[templateSetIndexes[electrodeID]];
+    const std::size_t numSamples = templateSet.numSamples;
+    if (numChannels < 1 ||
+        numChannels > OpenEphysEvent::maxSpikeChannels ||
+        numSamples % numChannels != 0 ||
+        numBytes < (numChannels + numSamples) * sizeof(float))
+    {
+        return unclassifiedID;
+    }
+    
+    // The payload follows an 18-byte header, so it may not be aligned for float
+    std::memcpy(samples.data(), payload + numChannels * sizeof(float), numSamples * sizeof(float));
+    
+    // Minimize |t|^2 - 2 w.t, which differs from the squared distance by the constant |w|^2
+    const std::size_t numTemplates = templateSet.unitIDs.size();
+    std::size_t nearest = 0;
+    float nearestScore = std::numeric_limits<float>::infinity();
+    for (std::size_t index = 0; index < numTemplates; index++) {
+        const float score = (templateSet.squaredNorms[index] -
+                             2.0f * dot(samples.data(), &templateSet.samples[index * numSamples], numSamples));
+        if (score < nearestScore) {
+            nearestScore = score;
+            nearest = index;
+        }
+    }
+    
+    if (maxRMSDistance > 0.0) {
+        const double squaredDistance = double(dot(samples.data(), samples.data(), numSamples)) + double(nearestScore);
+        if (squaredDistance > maxRMSDistance * maxRMSDistance * double(numSamples)) {
+            return unclassifiedID;
+        }
+    }
+    
+    return templateSet.unitIDs[nearest];
+}
+
+
+END_NAMESPACE_MW
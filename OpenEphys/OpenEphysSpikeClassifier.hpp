@@ -0,0 +1,74 @@
+//
+//  OpenEphysSpikeClassifier.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysSpikeClassifier_hpp
+#define OpenEphysSpikeClassifier_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Classifies spike waveforms by matching them against per-electrode templates.  A waveform is
+// assigned the unit ID of the template nearest to it (in Euclidean distance), provided that the RMS
+// difference per sample doesn't exceed a limit.  Distances are computed as
+// |w - t|^2 = |w|^2 - 2 w.t + |t|^2, with |t|^2 precomputed, so each template costs one dot product.
+//
+// Waveforms are read from the payload that follows the header of a SpikeEvent: one float threshold
+// per channel (skipped), then float samples with the samples of each channel contiguous, then
+// metadata (ignored).  A template holds the samples of all of its electrode's channels, in the same
+// order and units (microvolts).  Not thread safe.
+//
+class OpenEphysSpikeClassifier : boost::noncopyable {
+    
+public:
+    // Unit ID assigned to waveforms that match no template
+    static constexpr std::uint16_t unclassifiedID = 0;
+    
+    // A limit of zero accepts the nearest template regardless of distance
+    explicit OpenEphysSpikeClassifier(double maxRMSDistance);
+    
+    // Reads templates from a text file with one template per line: an electrode ID, a unit ID, and
+    // the template's samples, separated by whitespace.  Blank lines and lines starting with '#' are
+    // ignored.
+    void loadTemplates(const std::string &path);
+    void addTemplate(std::uint16_t electrodeID, std::uint16_t unitID, const std::vector<float> &samples);
+    
+    std::size_t getNumTemplates() const;
+    // Length, in bytes, of the longest payload prefix (thresholds and waveform) that any template uses
+    std::size_t getMaxWaveformBytes() const { return maxWaveformBytes; }
+    
+    // numChannels is the number of channels of the spike's electrode, and numBytes the full size of the
+    // payload (which must hold at least the thresholds and the template's samples)
+    std::uint16_t classify(std::uint16_t electrodeID,
+                           std::size_t numChannels,
+                           const std::uint8_t *payload,
+                           std::size_t numBytes);
+    
+private:
+    struct TemplateSet {
+        std::size_t numSamples;
+        std::vector<float> samples;  // Indexed by template, then sample
+        std::vector<float> squaredNorms;
+        std::vector<std::uint16_t> unitIDs;
+    };
+    
+    const double maxRMSDistance;
+    std::vector<std::ptrdiff_t> templateSetIndexes;  // Indexed by electrode ID, or -1 if none
+    std::vector<TemplateSet> templateSets;
+    std::size_t maxWaveformBytes;
+    std::vector<float> samples;  // Decoded waveform
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysSpikeClassifier_hpp */
@@ -0,0 +1,138 @@
+//
+//  OpenEphysSpikeCodec.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysSpikeCodec.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+const char batchMagic[4] = { 'O', 'E', 'S', 'B' };
+constexpr std::uint8_t batchVersion = 2;
+
+
+inline void putVarint(std::string &output, std::uint64_t value) {
+    while (value >= 0x80) {
+        output.push_back(char(std::uint8_t(value) | 0x80));
+        value >>= 7;
+    }
+    output.push_back(char(value));
+}
+
+
+inline void putSignedVarint(std::string &output, std::int64_t value) {
+    // Zigzag encoding maps small magnitudes of either sign to small unsigned values
+    putVarint(output, (std::uint64_t(value) << 1) ^ std::uint64_t(value >> 63));
+}
+
+
+inline bool getVarint(const std::string &input, std::size_t &position, std::uint64_t &value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && position < input.size(); shift += 7) {
+        const std::uint8_t byte = input[position++];
+        value |= std::uint64_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+inline bool getSignedVarint(const std::string &input, std::size_t &position, std::int64_t &value) {
+    std::uint64_t encoded;
+    if (!getVarint(input, position, encoded)) {
+        return false;
+    }
+    value = std::int64_t(encoded >> 1) ^ -std::int64_t(encoded & 1);
+    return true;
+}
+
+
+END_NAMESPACE()
+
+
+void OpenEphysSpikeBatchEncoder::reset() {
+    body.clear();
+    count = 0;
+    firstSpikeTime = 0;
+    previousTime = 0;
+    previousSampleNumber = 0;
+}
+
+
+void OpenEphysSpikeBatchEncoder::add(const OpenEphysSpikeRecord &spike) {
+    if (count == 0) {
+        firstSpikeTime = spike.time;
+    }
+    putSignedVarint(body, spike.time - previousTime);
+    putSignedVarint(body, spike.sampleNumber - previousSampleNumber);
+    putVarint(body, spike.electrodeID);
+    putVarint(body, spike.sortedID);
+    putVarint(body, spike.channel);
+    putVarint(body, spike.classifiedID);
+    previousTime = spike.time;
+    previousSampleNumber = spike.sampleNumber;
+    count++;
+}
+
+
+std::string OpenEphysSpikeBatchEncoder::finish() {
+    std::string batch(batchMagic, sizeof(batchMagic));
+    batch.push_back(char(batchVersion));
+    putVarint(batch, count);
+    batch.append(body);
+    reset();
+    return batch;
+}
+
+
+bool decodeSpikeBatch(const std::string &data, std::vector<OpenEphysSpikeRecord> &spikes) {
+    if (data.size() < sizeof(batchMagic) + 1 ||
+        0 != data.compare(0, sizeof(batchMagic), batchMagic, sizeof(batchMagic)) ||
+        std::uint8_t(data[sizeof(batchMagic)]) != batchVersion)
+    {
+        return false;
+    }
+    
+    std::size_t position = sizeof(batchMagic) + 1;
+    std::uint64_t count;
+    if (!getVarint(data, position, count)) {
+        return false;
+    }
+    
+    std::int64_t time = 0, sampleNumber = 0;
+    for (std::uint64_t i = 0; i < count; i++) {
+        std::int64_t timeDelta, sampleDelta;
+        std::uint64_t electrodeID, sortedID, channel, classifiedID;
+        if (!getSignedVarint(data, position, timeDelta) ||
+            !getSignedVarint(data, position, sampleDelta) ||
+            !getVarint(data, position, electrodeID) ||
+            !getVarint(data, position, sortedID) ||
+            !getVarint(data, position, channel) ||
+            !getVarint(data, position, classifiedID))
+        {
+            return false;
+        }
+        time += timeDelta;
+        sampleNumber += sampleDelta;
+        spikes.push_back({ MWTime(time),
+                           sampleNumber,
+                           std::uint16_t(electrodeID),
+                           std::uint16_t(sortedID),
+                           std::uint16_t(channel),
+                           std::uint16_t(classifiedID) });
+    }
+    
+    return (position == data.size());
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,66 @@
+//
+//  OpenEphysSpikeCodec.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysSpikeCodec_hpp
+#define OpenEphysSpikeCodec_hpp
+
+#include "OpenEphysSpikeRecord.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Compact binary encoding of spike batches:
+//
+//   magic    4 bytes, "OESB"
+//   version  1 byte (currently 2)
+//   count    varint
+//   spikes   count x {
+//                time delta     zigzag varint (us, relative to previous spike; first relative to 0)
+//                sample delta   zigzag varint (relative to previous spike; first relative to 0)
+//                electrode ID   varint
+//                sorted ID      varint
+//                channel        varint
+//                classified ID  varint (0 if unclassified)
+//            }
+//
+// Varints are little-endian base-128, with the high bit of each byte set on all but the last byte.
+//
+class OpenEphysSpikeBatchEncoder {
+    
+public:
+    OpenEphysSpikeBatchEncoder() { reset(); }
+    
+    void reset();
+    void add(const OpenEphysSpikeRecord &spike);
+    
+    bool empty() const { return (count == 0); }
+    std::size_t size() const { return count; }
+    MWTime getFirstSpikeTime() const { return firstSpikeTime; }
+    
+    // Returns the encoded batch and resets the encoder
+    std::string finish();
+    
+private:
+    std::string body;
+    std::size_t count;
+    MWTime firstSpikeTime;
+    MWTime previousTime;
+    std::int64_t previousSampleNumber;
+    
+};
+
+
+// Returns false if the data are not a valid batch
+bool decodeSpikeBatch(const std::string &data, std::vector<OpenEphysSpikeRecord> &spikes);
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysSpikeCodec_hpp */
@@ -0,0 +1,118 @@
+//
+//  OpenEphysSpikeDatumBuilder.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysSpikeDatumBuilder.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+auto OpenEphysSpikeDatumBuilder::parseField(const std::string &name) -> Field {
+    for (auto field : { Field::OETimestamp,
+                        Field::SortedID,
+                        Field::ElectrodeID,
+                        Field::Channel,
+                        Field::ClassifiedID })
+    {
+        if (name == getFieldName(field)) {
+            return field;
+        }
+    }
+    throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid spike field", name);
+}
+
+
+auto OpenEphysSpikeDatumBuilder::parseFields(const std::string &names) -> std::vector<Field> {
+    std::vector<Field> fields;
+    std::istringstream input(names);
+    std::string name;
+    while (std::getline(input, name, ',')) {
+        // Allow whitespace and quotes around each name
+        const auto first = name.find_first_not_of(" \t\n'\"");
+        const auto last = name.find_last_not_of(" \t\n'\"");
+        if (first != std::string::npos) {
+            fields.push_back(parseField(name.substr(first, last - first + 1)));
+        }
+    }
+    return fields;
+}
+
+
+const char * OpenEphysSpikeDatumBuilder::getFieldName(Field field) {
+    switch (field) {
+        case Field::OETimestamp:
+            return "oe_timestamp";
+        case Field::SortedID:
+            return "sorted_id";
+        case Field::ElectrodeID:
+            return "electrode_id";
+        case Field::Channel:
+            return "channel";
+        case Field::ClassifiedID:
+            return "classified_id";
+    }
+    return "";
+}
+
+
+std::int64_t OpenEphysSpikeDatumBuilder::getFieldValue(const OpenEphysSpikeRecord &spike, Field field) {
+    switch (field) {
+        case Field::OETimestamp:
+            return spike.sampleNumber;
+        case Field::SortedID:
+            return spike.sortedID;
+        case Field::ElectrodeID:
+            return spike.electrodeID;
+        case Field::Channel:
+            return spike.channel;
+        case Field::ClassifiedID:
+            return spike.classifiedID;
+    }
+    return 0;
+}
+
+
+OpenEphysSpikeDatumBuilder::OpenEphysSpikeDatumBuilder(const std::vector<Field> &fields, bool scalar) :
+    fields(fields),
+    scalar(scalar)
+{
+    if (fields.empty()) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "At least one spike field is required");
+    }
+    if (scalar) {
+        if (fields.size() != 1) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Scalar spike encoding requires exactly one spike field");
+        }
+        return;
+    }
+    
+    value = Datum(M_DICTIONARY, int(fields.size()));
+    for (auto field : fields) {
+        keys.emplace_back(getFieldName(field));
+        value.addElement(keys.back(), Datum(0LL));
+    }
+}
+
+
+bool OpenEphysSpikeDatumBuilder::hasField(Field field) const {
+    return (std::find(fields.begin(), fields.end(), field) != fields.end());
+}
+
+
+const Datum & OpenEphysSpikeDatumBuilder::build(const OpenEphysSpikeRecord &spike) {
+    if (scalar) {
+        value = Datum((long long)getFieldValue(spike, fields.front()));
+    } else {
+        for (std::size_t i = 0; i < fields.size(); i++) {
+            value.addElement(keys[i], Datum((long long)getFieldValue(spike, fields[i])));
+        }
+    }
+    return value;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,53 @@
+//
+//  OpenEphysSpikeDatumBuilder.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysSpikeDatumBuilder_hpp
+#define OpenEphysSpikeDatumBuilder_hpp
+
+#include "OpenEphysSpikeRecord.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Builds the values with which individual spikes are published: a dictionary of the selected fields,
+// or the value of a single field.  The dictionary keys, and the dictionary itself, are created once,
+// so that building a value only overwrites the dictionary's existing values.  Not thread safe.
+//
+class OpenEphysSpikeDatumBuilder : boost::noncopyable {
+    
+public:
+    enum class Field { OETimestamp, SortedID, ElectrodeID, Channel, ClassifiedID };
+    
+    static Field parseField(const std::string &name);
+    // Parses a comma-separated list of field names, each of which may be quoted
+    static std::vector<Field> parseFields(const std::string &names);
+    static const char * getFieldName(Field field);
+    static std::int64_t getFieldValue(const OpenEphysSpikeRecord &spike, Field field);
+    
+    // A scalar builder requires exactly one field
+    OpenEphysSpikeDatumBuilder(const std::vector<Field> &fields, bool scalar);
+    
+    bool hasField(Field field) const;
+    
+    // The value remains valid until the next call
+    const Datum & build(const OpenEphysSpikeRecord &spike);
+    
+private:
+    const std::vector<Field> fields;
+    const bool scalar;
+    std::vector<Datum> keys;
+    Datum value;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysSpikeDatumBuilder_hpp */
@@ -0,0 +1,31 @@
+//
+//  OpenEphysSpikeRecord.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysSpikeRecord_hpp
+#define OpenEphysSpikeRecord_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+// A decoded spike, with its time converted to the MWorks clock
+struct OpenEphysSpikeRecord {
+    MWTime time;
+    std::int64_t sampleNumber;
+    std::uint16_t electrodeID;
+    std::uint16_t sortedID;
+    std::uint16_t channel;
+    std::uint16_t classifiedID;  // From template matching, or 0 if unclassified
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysSpikeRecord_hpp */
@@ -0,0 +1,115 @@
+//
+//  OpenEphysSpikeStore.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysSpikeStore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+void OpenEphysSpikeStore::UnitHistory::add(MWTime time) {
+    const std::size_t capacity = times.size();
+    
+    // Spikes almost always arrive in time order, so optimize for appending
+    std::size_t index = size;
+    if (size > 0 && time < at(size - 1)) {
+        index = lowerBound(time);
+        if (index == 0 && size == capacity) {
+            // Older than everything we're keeping
+            return;
+        }
+    }
+    
+    if (size == capacity) {
+        // Discard the oldest spike
+        first = (first + 1) % capacity;
+        size--;
+        index--;
+    }
+    
+    // Shift later spikes up by one to make room
+    for (std::size_t i = size; i > index; i--) {
+        times[(first + i) % capacity] = times[(first + i - 1) % capacity];
+    }
+    times[(first + index) % capacity] = time;
+    size++;
+}
+
+
+std::size_t OpenEphysSpikeStore::UnitHistory::lowerBound(MWTime time) const {
+    std::size_t low = 0, high = size;
+    while (low < high) {
+        const std::size_t middle = low + (high - low) / 2;
+        if (at(middle) < time) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+
+OpenEphysSpikeStore::OpenEphysSpikeStore(std::size_t capacityPerUnit) :
+    capacityPerUnit(capacityPerUnit)
+{
+    if (capacityPerUnit < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Spike history size must be at least 1");
+    }
+}
+
+
+void OpenEphysSpikeStore::clear() {
+    scoped_lock lock(mutex);
+    units.clear();
+}
+
+
+void OpenEphysSpikeStore::addSpike(int electrodeID, int sortedID, MWTime time) {
+    scoped_lock lock(mutex);
+    auto iter = units.find(getUnitKey(electrodeID, sortedID));
+    if (iter == units.end()) {
+        iter = units.emplace(getUnitKey(electrodeID, sortedID), UnitHistory(capacityPerUnit)).first;
+    }
+    iter->second.add(time);
+}
+
+
+std::size_t OpenEphysSpikeStore::count(int electrodeID, int sortedID, MWTime start, MWTime end) const {
+    scoped_lock lock(mutex);
+    auto history = getUnitHistory(electrodeID, sortedID);
+    if (!history || end <= start) {
+        return 0;
+    }
+    return history->lowerBound(end) - history->lowerBound(start);
+}
+
+
+std::vector<MWTime> OpenEphysSpikeStore::fetch(int electrodeID, int sortedID, MWTime start, MWTime end) const {
+    std::vector<MWTime> result;
+    scoped_lock lock(mutex);
+    auto history = getUnitHistory(electrodeID, sortedID);
+    if (history && end > start) {
+        const std::size_t last = history->lowerBound(end);
+        for (std::size_t i = history->lowerBound(start); i < last; i++) {
+            result.push_back(history->at(i));
+        }
+    }
+    return result;
+}
+
+
+auto OpenEphysSpikeStore::getUnitHistory(int electrodeID, int sortedID) const -> const UnitHistory * {
+    auto iter = units.find(getUnitKey(electrodeID, sortedID));
+    if (iter == units.end()) {
+        return nullptr;
+    }
+    return &(iter->second);
+}
+
+
+END_NAMESPACE_MW
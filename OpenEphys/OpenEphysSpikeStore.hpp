@@ -0,0 +1,66 @@
+//
+//  OpenEphysSpikeStore.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysSpikeStore_hpp
+#define OpenEphysSpikeStore_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Bounded history of recent spike times (on the MWorks clock) for each unit, kept in sorted order
+// so that range queries take O(log n) time.  Safe to use from multiple threads.
+//
+class OpenEphysSpikeStore : boost::noncopyable {
+    
+public:
+    explicit OpenEphysSpikeStore(std::size_t capacityPerUnit);
+    
+    void clear();
+    void addSpike(int electrodeID, int sortedID, MWTime time);
+    
+    // Both queries cover the half-open interval [start, end)
+    std::size_t count(int electrodeID, int sortedID, MWTime start, MWTime end) const;
+    std::vector<MWTime> fetch(int electrodeID, int sortedID, MWTime start, MWTime end) const;
+    
+private:
+    class UnitHistory {
+    public:
+        explicit UnitHistory(std::size_t capacity) : times(capacity), first(0), size(0) { }
+        
+        void add(MWTime time);
+        std::size_t lowerBound(MWTime time) const;
+        MWTime at(std::size_t index) const { return times[(first + index) % times.size()]; }
+        
+    private:
+        std::vector<MWTime> times;
+        std::size_t first;
+        std::size_t size;
+    };
+    
+    static std::uint32_t getUnitKey(int electrodeID, int sortedID) {
+        return (std::uint32_t(electrodeID & 0xFFFF) << 16) | std::uint32_t(sortedID & 0xFFFF);
+    }
+    
+    const UnitHistory * getUnitHistory(int electrodeID, int sortedID) const;
+    
+    const std::size_t capacityPerUnit;
+    std::unordered_map<std::uint32_t, UnitHistory> units;
+    
+    mutable std::mutex mutex;
+    using scoped_lock = std::lock_guard<decltype(mutex)>;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysSpikeStore_hpp */
@@ -0,0 +1,185 @@
+//
+//  OpenEphysSpikeTriggeredAverage.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysSpikeTriggeredAverage.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+void OpenEphysSpikeTriggeredAverage::VariableHistory::add(MWTime time, double value) {
+    const std::size_t capacity = times.size();
+    
+    // Assignments are reported in time order, except for small races between threads.  Treat a late
+    // report as occurring at the time of the most recent one, so that the history stays sorted.
+    if (size > 0) {
+        time = std::max(time, timeAt(size - 1));
+    }
+    
+    if (size == capacity) {
+        // Discard the oldest value
+        first = (first + 1) % capacity;
+        size--;
+    }
+    
+    const std::size_t index = (first + size) % capacity;
+    times[index] = time;
+    values[index] = value;
+    size++;
+}
+
+
+std::ptrdiff_t OpenEphysSpikeTriggeredAverage::VariableHistory::find(MWTime time) const {
+    // Find the first value assigned after time
+    std::size_t low = 0, high = size;
+    while (low < high) {
+        const std::size_t middle = low + (high - low) / 2;
+        if (timeAt(middle) <= time) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return std::ptrdiff_t(low) - 1;
+}
+
+
+void OpenEphysSpikeTriggeredAverage::VariableHistory::accumulate(std::size_t index,
+                                                                MWTime start,
+                                                                MWTime binWidth,
+                                                                std::size_t numBins,
+                                                                double *binSums) const
+{
+    // Walk the storage directly, rather than via timeAt, to avoid a division per step
+    const std::size_t capacity = times.size();
+    std::size_t position = (first + index) % capacity;
+    std::size_t remaining = size - index - 1;  // Values after the current one
+    
+    MWTime binStart = start;
+    for (std::size_t bin = 0; bin < numBins; bin++, binStart += binWidth) {
+        while (remaining > 0) {
+            const std::size_t next = (position + 1 == capacity ? 0 : position + 1);
+            if (times[next] > binStart) {
+                break;
+            }
+            position = next;
+            remaining--;
+        }
+        binSums[bin] += values[position];
+    }
+}
+
+
+OpenEphysSpikeTriggeredAverage::OpenEphysSpikeTriggeredAverage(std::size_t numVariables,
+                                                               std::size_t numUnits,
+                                                               MWTime window,
+                                                               MWTime binWidth,
+                                                               std::size_t historySize) :
+    numVariables(numVariables),
+    numUnits(numUnits),
+    window(window),
+    binWidth(binWidth),
+    numBins(binWidth > 0 ? std::size_t((window + binWidth - 1) / binWidth) : 0),
+    histories(numVariables, VariableHistory(historySize)),
+    sums(numUnits * numVariables * numBins, 0.0),
+    spikeCounts(numUnits, 0),
+    startIndexes(numVariables, 0)
+{
+    if (numVariables < 1 || numUnits < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                              "Spike-triggered average requires at least one variable and one unit");
+    }
+    if (window <= 0 || binWidth <= 0) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN,
+                              "Spike-triggered average window and bin width must be greater than zero");
+    }
+    if (historySize < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Spike-triggered average history size must be at least 1");
+    }
+}
+
+
+void OpenEphysSpikeTriggeredAverage::clear() {
+    scoped_lock lock(mutex);
+    for (auto &history : histories) {
+        history.clear();
+    }
+    std::fill(sums.begin(), sums.end(), 0.0);
+    std::fill(spikeCounts.begin(), spikeCounts.end(), 0);
+}
+
+
+void OpenEphysSpikeTriggeredAverage::clearAverages() {
+    scoped_lock lock(mutex);
+    std::fill(sums.begin(), sums.end(), 0.0);
+    std::fill(spikeCounts.begin(), spikeCounts.end(), 0);
+}
+
+
+void OpenEphysSpikeTriggeredAverage::addValue(std::size_t variable, MWTime time, double value) {
+    scoped_lock lock(mutex);
+    histories.at(variable).add(time, value);
+}
+
+
+bool OpenEphysSpikeTriggeredAverage::addSpike(std::size_t unit, MWTime time) {
+    scoped_lock lock(mutex);
+    
+    if (unit >= numUnits) {
+        return false;
+    }
+    
+    const MWTime windowStart = time - MWTime(numBins) * binWidth;
+    
+    // Check every variable before changing any sums
+    for (std::size_t variable = 0; variable < numVariables; variable++) {
+        startIndexes[variable] = histories[variable].find(windowStart);
+        if (startIndexes[variable] < 0) {
+            return false;
+        }
+    }
+    
+    for (std::size_t variable = 0; variable < numVariables; variable++) {
+        histories[variable].accumulate(std::size_t(startIndexes[variable]),
+                                       windowStart,
+                                       binWidth,
+                                       numBins,
+                                       sums.data() + (unit * numVariables + variable) * numBins);
+    }
+    
+    spikeCounts[unit]++;
+    return true;
+}
+
+
+std::size_t OpenEphysSpikeTriggeredAverage::getSpikeCount(std::size_t unit) const {
+    scoped_lock lock(mutex);
+    return spikeCounts.at(unit);
+}
+
+
+std::size_t OpenEphysSpikeTriggeredAverage::getAverage(std::size_t unit,
+                                                       std::size_t variable,
+                                                       std::vector<double> &average) const
+{
+    scoped_lock lock(mutex);
+    
+    average.assign(numBins, 0.0);
+    const std::size_t count = spikeCounts.at(unit);
+    if (count == 0 || variable >= numVariables) {
+        return count;
+    }
+    
+    const double *binSums = sums.data() + (unit * numVariables + variable) * numBins;
+    for (std::size_t bin = 0; bin < numBins; bin++) {
+        average[bin] = binSums[bin] / double(count);
+    }
+    return count;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,105 @@
+//
+//  OpenEphysSpikeTriggeredAverage.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysSpikeTriggeredAverage_hpp
+#define OpenEphysSpikeTriggeredAverage_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Spike-triggered averages of one or more variables for a fixed set of units.  The recent values of
+// each variable are kept in a bounded, time-ordered history.  For each spike, the window preceding the
+// spike is divided into bins, and the value of each variable at the start of each bin (i.e. the most
+// recent value assigned at or before that time) is added to the unit's running sums.  The history is
+// located with a binary search on the window start, after which the bins are filled in a single
+// forward pass.
+//
+// All storage is allocated up front.  Times are on the MWorks clock, in microseconds.  Safe to use from
+// multiple threads.
+//
+class OpenEphysSpikeTriggeredAverage : boost::noncopyable {
+    
+public:
+    OpenEphysSpikeTriggeredAverage(std::size_t numVariables,
+                                   std::size_t numUnits,
+                                   MWTime window,
+                                   MWTime binWidth,
+                                   std::size_t historySize);
+    
+    std::size_t getNumVariables() const { return numVariables; }
+    std::size_t getNumUnits() const { return numUnits; }
+    // The window is rounded up to a whole number of bins
+    std::size_t getNumBins() const { return numBins; }
+    MWTime getWindow() const { return window; }
+    MWTime getBinWidth() const { return binWidth; }
+    
+    // Discards the variable histories and the running sums
+    void clear();
+    
+    // Discards the running sums only
+    void clearAverages();
+    
+    void addValue(std::size_t variable, MWTime time, double value);
+    
+    // Returns false (and ignores the spike) if any variable's history doesn't cover the window
+    bool addSpike(std::size_t unit, MWTime time);
+    
+    std::size_t getSpikeCount(std::size_t unit) const;
+    
+    // Bin i of the average holds the mean value at (spike time - (getNumBins() - i) * bin width).
+    // Returns the number of spikes averaged.
+    std::size_t getAverage(std::size_t unit, std::size_t variable, std::vector<double> &average) const;
+    
+private:
+    class VariableHistory {
+    public:
+        explicit VariableHistory(std::size_t capacity) : times(capacity), values(capacity), first(0), size(0) { }
+        
+        void clear() { first = size = 0; }
+        void add(MWTime time, double value);
+        
+        // Index of the most recent value assigned at or before time, or -1 if there is none
+        std::ptrdiff_t find(MWTime time) const;
+        
+        // Adds the value at the start of each bin to binSums, starting from the value at index
+        void accumulate(std::size_t index, MWTime start, MWTime binWidth, std::size_t numBins, double *binSums) const;
+        
+        std::size_t getSize() const { return size; }
+        MWTime timeAt(std::size_t index) const { return times[(first + index) % times.size()]; }
+        
+    private:
+        std::vector<MWTime> times;
+        std::vector<double> values;
+        std::size_t first;
+        std::size_t size;
+    };
+    
+    const std::size_t numVariables;
+    const std::size_t numUnits;
+    const MWTime window;
+    const MWTime binWidth;
+    const std::size_t numBins;
+    
+    std::vector<VariableHistory> histories;
+    std::vector<double> sums;  // Indexed by unit, then variable, then bin
+    std::vector<std::size_t> spikeCounts;
+    std::vector<std::ptrdiff_t> startIndexes;  // Per variable, for the current spike
+    
+    mutable std::mutex mutex;
+    using scoped_lock = std::lock_guard<decltype(mutex)>;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysSpikeTriggeredAverage_hpp */
@@ -0,0 +1,59 @@
+//
+//  OpenEphysSyncLatencyEstimator.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysSyncLatencyEstimator.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+constexpr std::size_t maxSamples = 256;
+constexpr double madToStandardDeviation = 1.4826;
+
+
+double median(std::vector<double> &values) {
+    const auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    if (values.size() % 2) {
+        return *middle;
+    }
+    return (*middle + *std::max_element(values.begin(), middle)) / 2.0;
+}
+
+
+END_NAMESPACE()
+
+
+void OpenEphysSyncLatencyEstimator::addSample(MWTime latency) {
+    samples.push_back(latency);
+    while (samples.size() > maxSamples) {
+        samples.pop_front();
+    }
+}
+
+
+bool OpenEphysSyncLatencyEstimator::getEstimate(double &latency, double &jitter) const {
+    if (samples.empty()) {
+        return false;
+    }
+    
+    std::vector<double> values(samples.begin(), samples.end());
+    latency = median(values);
+    
+    for (auto &value : values) {
+        value = std::fabs(value - latency);
+    }
+    jitter = madToStandardDeviation * median(values);
+    
+    return true;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,40 @@
+//
+//  OpenEphysSyncLatencyEstimator.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysSyncLatencyEstimator_hpp
+#define OpenEphysSyncLatencyEstimator_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Robust estimate of the latency between assigning a sync word and the corresponding change on the
+// digital output lines.  The fixed component is the median of recent samples, and the residual
+// jitter is their median absolute deviation, scaled to be comparable to a standard deviation.
+//
+class OpenEphysSyncLatencyEstimator {
+    
+public:
+    void reset() { samples.clear(); }
+    void addSample(MWTime latency);
+    
+    std::size_t getNumSamples() const { return samples.size(); }
+    bool getEstimate(double &latency, double &jitter) const;
+    
+private:
+    std::deque<MWTime> samples;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysSyncLatencyEstimator_hpp */
@@ -0,0 +1,122 @@
+//
+//  OpenEphysSyncMatcher.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysSyncMatcher.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+constexpr std::size_t OpenEphysSyncWordDecoder::maxChannels;
+
+
+OpenEphysSyncWordDecoder::OpenEphysSyncWordDecoder(const std::vector<std::uint8_t> &channels) :
+    channels(channels)
+{
+    if (channels.size() > maxChannels) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Too many sync channels");
+    }
+    for (auto channel : channels) {
+        if (channel >= 64) {
+            throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid sync channel number");
+        }
+    }
+}
+
+
+std::uint64_t OpenEphysSyncWordDecoder::decode(std::uint64_t ttlWord) const {
+    std::uint64_t syncWord = 0;
+    for (std::size_t i = 0; i < channels.size(); i++) {
+        syncWord |= ((ttlWord >> channels[i]) & 1) << i;
+    }
+    return syncWord;
+}
+
+
+std::uint64_t OpenEphysSyncWordDecoder::encode(std::uint64_t syncWord) const {
+    std::uint64_t ttlWord = 0;
+    for (std::size_t i = 0; i < channels.size(); i++) {
+        ttlWord |= std::uint64_t((syncWord >> i) & 1) << channels[i];
+    }
+    return ttlWord;
+}
+
+
+OpenEphysSyncMatcher::OpenEphysSyncMatcher(std::size_t windowSize) :
+    windowSize(windowSize),
+    lastReceivedValue(-1)
+{
+    if (windowSize < 1) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Sync match window must contain at least one word");
+    }
+}
+
+
+void OpenEphysSyncMatcher::clear() {
+    history.clear();
+    lastReceivedValue = -1;
+}
+
+
+void OpenEphysSyncMatcher::addSentValue(int value, MWTime sendTime) {
+    history.push_back({ value, sendTime, false });
+    while (history.size() > windowSize) {
+        history.pop_front();
+    }
+}
+
+
+auto OpenEphysSyncMatcher::matchReceivedValue(int value, MWTime &sendTime) -> Result {
+    const int previousValue = lastReceivedValue;
+    lastReceivedValue = value;
+    
+    // Transmissions that haven't been matched yet, oldest first
+    auto first = history.end();
+    while (first != history.begin() && !std::prev(first)->matched) {
+        --first;
+    }
+    if (first == history.end()) {
+        return Result::Unmatched;
+    }
+    
+    auto match = history.end();
+    if (first->value == value) {
+        match = first;
+    } else if (previousValue >= 0 && 0 == ((value ^ previousValue) & ~(first->value ^ previousValue))) {
+        // Partway from the previous word to the next expected one
+        return Result::Transition;
+    } else {
+        // The expected word may have been missed, so accept any later transmission
+        match = std::find_if(std::next(first), history.end(), [value](const SentValue &sent) {
+            return sent.value == value;
+        });
+        if (match == history.end()) {
+            return Result::Unmatched;
+        }
+    }
+    
+    sendTime = match->sendTime;
+    for (auto iter = history.begin(); iter != std::next(match); iter++) {
+        iter->matched = true;
+    }
+    return Result::Matched;
+}
+
+
+bool OpenEphysSyncMatcher::getSendTime(int value, MWTime &sendTime) const {
+    // Search from most to least recent, so that a repeated value matches its latest transmission
+    for (auto iter = history.rbegin(); iter != history.rend(); iter++) {
+        if (iter->value == value) {
+            sendTime = iter->sendTime;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,90 @@
+//
+//  OpenEphysSyncMatcher.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysSyncMatcher_hpp
+#define OpenEphysSyncMatcher_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Converts between sync words and the TTL word reported by Open Ephys, given the (zero-based) TTL
+// channels that carry the sync bits, least significant first.
+//
+class OpenEphysSyncWordDecoder {
+    
+public:
+    // Sync words are assigned to (and looped back through) int variables
+    static constexpr std::size_t maxChannels = 31;
+    
+    explicit OpenEphysSyncWordDecoder(const std::vector<std::uint8_t> &channels);
+    
+    std::size_t getNumChannels() const { return channels.size(); }
+    
+    std::uint64_t decode(std::uint64_t ttlWord) const;
+    std::uint64_t encode(std::uint64_t syncWord) const;
+    
+private:
+    const std::vector<std::uint8_t> channels;
+    
+};
+
+
+//
+// Remembers the MWorks send times of the most recent sync words, so that a word received from Open
+// Ephys can be matched to its transmission.
+//
+// Open Ephys reports each TTL channel's edges separately, so while a multi-bit sync word is changing,
+// it reports partial words that are often valid sync words themselves.  To avoid matching those to
+// old transmissions, a received word is compared only with the transmissions that followed the last
+// match, and only the most recent few of those (the window).  A word that lies between the previous
+// received word and the next expected one (i.e. it differs from the previous word only in bits that
+// the transition changes) is recognized as a transition, rather than matched or reported as
+// unexpected.
+//
+class OpenEphysSyncMatcher : boost::noncopyable {
+    
+public:
+    enum class Result { Matched, Transition, Unmatched };
+    
+    explicit OpenEphysSyncMatcher(std::size_t windowSize);
+    
+    void clear();
+    bool empty() const { return history.empty(); }
+    int getLastSentValue() const { return history.back().value; }
+    
+    void addSentValue(int value, MWTime sendTime);
+    
+    // Matches the next word received from Open Ephys.  Repeats of the previous word should be
+    // filtered out by the caller.
+    Result matchReceivedValue(int value, MWTime &sendTime);
+    
+    // Finds the most recent transmission of value within the window, without affecting matching (e.g.
+    // for loopback measurements)
+    bool getSendTime(int value, MWTime &sendTime) const;
+    
+private:
+    struct SentValue {
+        int value;
+        MWTime sendTime;
+        bool matched;  // This or a later transmission has been matched
+    };
+    
+    const std::size_t windowSize;
+    std::deque<SentValue> history;  // Most recent last
+    int lastReceivedValue;  // -1 if none
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysSyncMatcher_hpp */
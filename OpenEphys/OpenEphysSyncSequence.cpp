@@ -0,0 +1,60 @@
+//
+//  OpenEphysSyncSequence.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysSyncSequence.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+// Feedback taps of primitive polynomials, indexed by register width
+constexpr std::uint32_t lfsrTaps[OpenEphysSyncSequence::maxBits + 1] = {
+    0x00,
+    0x01,  // Degenerate case: alternates between 1 and 0
+    0x03,  // x^2 + x + 1
+    0x06,  // x^3 + x^2 + 1
+    0x0C,  // x^4 + x^3 + 1
+    0x14,  // x^5 + x^3 + 1
+    0x30,  // x^6 + x^5 + 1
+    0x60,  // x^7 + x^6 + 1
+    0xB8   // x^8 + x^6 + x^5 + x^4 + 1
+};
+
+
+END_NAMESPACE()
+
+
+OpenEphysSyncSequence::OpenEphysSyncSequence(std::size_t numBits) :
+    state(1)
+{
+    if (numBits < 1 || numBits > maxBits) {
+        throw SimpleException(M_IODEVICE_MESSAGE_DOMAIN, "Invalid number of bits for sync sequence");
+    }
+    taps = lfsrTaps[numBits];
+    period = (numBits == 1 ? 2 : (std::size_t(1) << numBits) - 1);
+}
+
+
+int OpenEphysSyncSequence::next() {
+    const int word = state;
+    if (period == 2) {
+        state ^= 1;
+    } else {
+        const bool lsb = state & 1;
+        state >>= 1;
+        if (lsb) {
+            state ^= taps;
+        }
+    }
+    return word;
+}
+
+
+END_NAMESPACE_MW
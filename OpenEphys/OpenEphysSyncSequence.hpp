@@ -0,0 +1,43 @@
+//
+//  OpenEphysSyncSequence.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysSyncSequence_hpp
+#define OpenEphysSyncSequence_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Generates a maximal-length pseudo-random sequence of sync words using a Galois LFSR.  Every
+// nonzero word of the given width appears exactly once per period (2^numBits - 1), so a single
+// received word identifies its position in the sequence, even if preceding words were missed.
+//
+class OpenEphysSyncSequence {
+    
+public:
+    static constexpr std::size_t maxBits = 8;
+    
+    explicit OpenEphysSyncSequence(std::size_t numBits);
+    
+    std::size_t getPeriod() const { return period; }
+    int next();
+    
+private:
+    std::uint32_t taps;
+    std::size_t period;
+    std::uint32_t state;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysSyncSequence_hpp */
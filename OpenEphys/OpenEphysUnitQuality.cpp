@@ -0,0 +1,194 @@
+//
+//  OpenEphysUnitQuality.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include "OpenEphysUnitQuality.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+constexpr double minBinnedISI = 100.0;  // 0.1 ms
+constexpr std::size_t numDecades = 5;
+constexpr std::size_t binsPerDecade = 10;
+
+// Bounds the storage (a few hundred bytes per unit) if Open Ephys reports very large IDs
+constexpr std::size_t maxUnits = 1 << 18;
+
+
+END_NAMESPACE()
+
+
+OpenEphysUnitQuality::OpenEphysUnitQuality(MWTime refractoryPeriod, MWTime maxBurstISI, std::size_t minBurstSpikes) :
+    refractoryPeriod(refractoryPeriod),
+    maxBurstISI(maxBurstISI),
+    minBurstSpikes(minBurstSpikes),
+    numElectrodes(0),
+    numSortedIDs(0)
+{
+    const std::size_t numBins = numDecades * binsPerDecade;
+    for (std::size_t i = 0; i <= numBins; i++) {
+        binEdges.push_back(MWTime(std::llround(minBinnedISI * std::pow(10.0, double(i) / double(binsPerDecade)))));
+    }
+}
+
+
+void OpenEphysUnitQuality::reset() {
+    std::fill(lastSpikeTimes.begin(), lastSpikeTimes.end(), -1);
+    std::fill(runLengths.begin(), runLengths.end(), 0);
+    std::fill(runSpikeCounts.begin(), runSpikeCounts.end(), 0);
+    takeStats();
+}
+
+
+bool OpenEphysUnitQuality::addSpike(std::uint16_t electrodeID, std::uint16_t sortedID, MWTime time) {
+    if ((electrodeID >= numElectrodes || sortedID >= numSortedIDs) &&
+        !reserve(std::size_t(electrodeID) + 1, std::size_t(sortedID) + 1))
+    {
+        return false;
+    }
+    
+    const std::size_t unit = std::size_t(electrodeID) * numSortedIDs + sortedID;
+    if (0 == spikeCounts[unit]++) {
+        activeUnits.push_back(unit);
+    }
+    
+    const MWTime lastSpikeTime = lastSpikeTimes[unit];
+    lastSpikeTimes[unit] = time;
+    
+    // A time earlier than the previous spike's means that acquisition restarted
+    if (lastSpikeTime < 0 || time < lastSpikeTime) {
+        runLengths[unit] = 1;
+        runSpikeCounts[unit] = 1;
+        return true;
+    }
+    
+    const MWTime isi = time - lastSpikeTime;
+    isiCounts[unit]++;
+    histograms[unit * getNumBins() + getBin(isi)]++;
+    
+    if (isi < refractoryPeriod) {
+        refractoryViolations[unit]++;
+    }
+    
+    if (isi <= maxBurstISI) {
+        const std::uint32_t runLength = ++runLengths[unit];
+        runSpikeCounts[unit]++;
+        if (runLength == minBurstSpikes) {
+            burstCounts[unit]++;
+            // Spikes of the run that fell in earlier intervals were counted there, as non-burst spikes
+            burstSpikeCounts[unit] += runSpikeCounts[unit];
+        } else if (runLength > minBurstSpikes) {
+            burstSpikeCounts[unit]++;
+        }
+    } else {
+        runLengths[unit] = 1;
+        runSpikeCounts[unit] = 1;
+    }
+    
+    return true;
+}
+
+
+auto OpenEphysUnitQuality::takeStats() -> std::vector<UnitStats> {
+    const std::size_t numBins = getNumBins();
+    
+    // Report units in ID order, which is index order
+    std::sort(activeUnits.begin(), activeUnits.end());
+    
+    std::vector<UnitStats> result;
+    result.reserve(activeUnits.size());
+    for (auto unit : activeUnits) {
+        const auto histogram = histograms.begin() + unit * numBins;
+        result.push_back({
+            std::uint16_t(unit / numSortedIDs),
+            std::uint16_t(unit % numSortedIDs),
+            spikeCounts[unit],
+            isiCounts[unit],
+            refractoryViolations[unit],
+            burstCounts[unit],
+            burstSpikeCounts[unit],
+            std::vector<std::uint32_t>(histogram, histogram + numBins)
+        });
+        
+        runSpikeCounts[unit] = 0;
+        spikeCounts[unit] = 0;
+        isiCounts[unit] = 0;
+        refractoryViolations[unit] = 0;
+        burstCounts[unit] = 0;
+        burstSpikeCounts[unit] = 0;
+        std::fill(histogram, histogram + numBins, 0);
+    }
+    activeUnits.clear();
+    
+    return result;
+}
+
+
+bool OpenEphysUnitQuality::reserve(std::size_t minElectrodes, std::size_t minSortedIDs) {
+    // Grow geometrically, so that IDs appearing one at a time don't each trigger a copy
+    std::size_t newNumElectrodes = std::max(numElectrodes, minElectrodes);
+    std::size_t newNumSortedIDs = std::max(numSortedIDs, minSortedIDs);
+    if (newNumElectrodes > numElectrodes) {
+        newNumElectrodes = std::max(newNumElectrodes, 2 * numElectrodes);
+    }
+    if (newNumSortedIDs > numSortedIDs) {
+        newNumSortedIDs = std::max(newNumSortedIDs, 2 * numSortedIDs);
+    }
+    if (newNumElectrodes * newNumSortedIDs > maxUnits) {
+        newNumElectrodes = std::max(numElectrodes, minElectrodes);
+        newNumSortedIDs = std::max(numSortedIDs, minSortedIDs);
+        if (newNumElectrodes * newNumSortedIDs > maxUnits) {
+            return false;
+        }
+    }
+    
+    const std::size_t numUnits = newNumElectrodes * newNumSortedIDs;
+    const std::size_t numBins = getNumBins();
+    
+    auto remap = [&](std::size_t unit) {
+        return (unit / numSortedIDs) * newNumSortedIDs + unit % numSortedIDs;
+    };
+    
+    auto grow = [&](auto &values, std::size_t stride, auto initialValue) {
+        std::remove_reference_t<decltype(values)> newValues(numUnits * stride, initialValue);
+        for (std::size_t unit = 0; unit < numElectrodes * numSortedIDs; unit++) {
+            std::copy_n(values.begin() + unit * stride, stride, newValues.begin() + remap(unit) * stride);
+        }
+        values.swap(newValues);
+    };
+    
+    grow(lastSpikeTimes, 1, MWTime(-1));
+    grow(runLengths, 1, std::uint32_t(0));
+    grow(runSpikeCounts, 1, std::uint32_t(0));
+    grow(spikeCounts, 1, std::uint32_t(0));
+    grow(isiCounts, 1, std::uint32_t(0));
+    grow(refractoryViolations, 1, std::uint32_t(0));
+    grow(burstCounts, 1, std::uint32_t(0));
+    grow(burstSpikeCounts, 1, std::uint32_t(0));
+    grow(histograms, numBins, std::uint32_t(0));
+    
+    for (auto &unit : activeUnits) {
+        unit = remap(unit);
+    }
+    
+    numElectrodes = newNumElectrodes;
+    numSortedIDs = newNumSortedIDs;
+    
+    return true;
+}
+
+
+std::size_t OpenEphysUnitQuality::getBin(MWTime isi) const {
+    const auto edge = std::upper_bound(binEdges.begin() + 1, binEdges.end() - 1, isi);
+    return std::size_t(edge - (binEdges.begin() + 1));
+}
+
+
+END_NAMESPACE_MW
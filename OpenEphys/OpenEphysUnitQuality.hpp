@@ -0,0 +1,91 @@
+//
+//  OpenEphysUnitQuality.hpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#ifndef OpenEphysUnitQuality_hpp
+#define OpenEphysUnitQuality_hpp
+
+#include "OpenEphysCore.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+//
+// Per-unit inter-spike interval (ISI) statistics, for monitoring sort quality during a session.  For
+// each unit, the tracker maintains a histogram of ISIs in fixed, logarithmically spaced bins, the number
+// of ISIs shorter than the refractory period, and the number of bursts (runs of at least a minimum
+// number of spikes separated by no more than a maximum ISI).
+//
+// State is kept in flat arrays indexed by electrode ID and sorted ID, which grow as new IDs appear.
+// The statistics cover the interval since the last call to takeStats, while each unit's previous spike
+// time and burst state carry over between intervals.  Times are on the Open Ephys clock (so that sync
+// updates don't distort ISIs), in microseconds.  Not thread safe.
+//
+class OpenEphysUnitQuality : boost::noncopyable {
+    
+public:
+    struct UnitStats {
+        std::uint16_t electrodeID;
+        std::uint16_t sortedID;
+        std::size_t spikeCount;
+        std::size_t isiCount;
+        std::size_t refractoryViolations;
+        std::size_t burstCount;
+        std::size_t burstSpikeCount;
+        std::vector<std::uint32_t> histogram;
+    };
+    
+    OpenEphysUnitQuality(MWTime refractoryPeriod, MWTime maxBurstISI, std::size_t minBurstSpikes);
+    
+    // Ten bins per decade, from 0.1 ms to 10 s.  Bin i covers [edges[i], edges[i + 1]).  ISIs outside
+    // that range are counted in the first or last bin.
+    std::size_t getNumBins() const { return binEdges.size() - 1; }
+    const std::vector<MWTime> & getBinEdges() const { return binEdges; }
+    
+    // Discards all state, including previous spike times
+    void reset();
+    
+    // Returns false (and ignores the spike) if tracking the unit would require too much storage
+    bool addSpike(std::uint16_t electrodeID, std::uint16_t sortedID, MWTime time);
+    
+    bool hasStats() const { return !activeUnits.empty(); }
+    // Returns the statistics of every unit that spiked since the last call, and clears them
+    std::vector<UnitStats> takeStats();
+    
+private:
+    bool reserve(std::size_t numElectrodes, std::size_t numSortedIDs);
+    std::size_t getBin(MWTime isi) const;
+    
+    const MWTime refractoryPeriod;
+    const MWTime maxBurstISI;
+    const std::size_t minBurstSpikes;
+    std::vector<MWTime> binEdges;
+    
+    std::size_t numElectrodes;
+    std::size_t numSortedIDs;  // Row stride of the flat arrays
+    
+    // Carried over between intervals
+    std::vector<MWTime> lastSpikeTimes;  // -1 if none
+    std::vector<std::uint32_t> runLengths;
+    
+    // Cleared by takeStats
+    std::vector<std::uint32_t> runSpikeCounts;  // Spikes of the current run that fell in this interval
+    std::vector<std::uint32_t> spikeCounts;
+    std::vector<std::uint32_t> isiCounts;
+    std::vector<std::uint32_t> refractoryViolations;
+    std::vector<std::uint32_t> burstCounts;
+    std::vector<std::uint32_t> burstSpikeCounts;
+    std::vector<std::uint32_t> histograms;  // numBins per unit
+    std::vector<std::size_t> activeUnits;
+    
+};
+
+
+END_NAMESPACE_MW
+
+
+#endif /* OpenEphysUnitQuality_hpp */
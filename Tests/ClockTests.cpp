@@ -0,0 +1,199 @@
+//
+//  ClockTests.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "OpenEphysClockModel.hpp"
+#include "OpenEphysClockService.hpp"
+#include "OpenEphysClockServiceAPI.h"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+// Open Ephys clock 2.5 s ahead of the MWorks clock and 20 ppm fast
+constexpr MWTime oeClockOffset = 2500000;
+constexpr double oeClockDrift = 20e-6;
+
+
+MWTime getOpenEphysTime(MWTime mwTime) {
+    return MWTime(std::llround(double(mwTime) * (1.0 + oeClockDrift))) + oeClockOffset;
+}
+
+
+// One sync per 100 ms, starting at 1 s
+MWTime getSyncTime(std::size_t index) {
+    return 1000000 + MWTime(index) * 100000;
+}
+
+
+END_NAMESPACE()
+
+
+TEST(ClockModelTest, FitsKnownOffsetAndDrift) {
+    OpenEphysClockModel model;
+    EXPECT_FALSE(model.isValid());
+    EXPECT_EQ(OpenEphysClockModel::LockState::Unlocked, model.getLockState(0));
+    
+    std::mt19937_64 engine(1);
+    std::normal_distribution<double> jitter(0.0, 5.0);
+    for (std::size_t i = 0; i < 64; i++) {
+        const MWTime mwTime = getSyncTime(i);
+        EXPECT_TRUE(model.addSyncMatch(getOpenEphysTime(mwTime), mwTime + MWTime(std::llround(jitter(engine)))));
+    }
+    ASSERT_TRUE(model.isValid());
+    EXPECT_EQ(OpenEphysClockModel::LockState::Locked, model.getLockState(getSyncTime(63)));
+    
+    // The model maps Open Ephys time to MWorks time, so its drift is that of the MWorks clock relative
+    // to the Open Ephys clock
+    EXPECT_NEAR(1.0 / (1.0 + oeClockDrift) - 1.0, model.getDrift(), 4e-6);
+    
+    // Converted times are accurate to within the jitter, both within and just beyond the fitted range
+    for (MWTime mwTime : { getSyncTime(40), getSyncTime(63), getSyncTime(63) + 1000000 }) {
+        EXPECT_NEAR(double(mwTime), double(model.convert(getOpenEphysTime(mwTime))), 50.0) << mwTime;
+    }
+    EXPECT_LT(model.getUncertainty(getOpenEphysTime(getSyncTime(63))), 50.0);
+    EXPECT_EQ(0u, model.getNumRejectedMatches());
+}
+
+
+TEST(ClockModelTest, RejectsInconsistentMatches) {
+    OpenEphysClockModel model;
+    for (std::size_t i = 0; i < 16; i++) {
+        ASSERT_TRUE(model.addSyncMatch(getOpenEphysTime(getSyncTime(i)), getSyncTime(i)));
+    }
+    
+    // A match to the wrong sync word is off by a whole sync interval
+    const MWTime mwTime = getSyncTime(16);
+    EXPECT_FALSE(model.addSyncMatch(getOpenEphysTime(mwTime), mwTime - 100000));
+    EXPECT_EQ(1u, model.getNumRejectedMatches());
+    EXPECT_NEAR(double(mwTime), double(model.convert(getOpenEphysTime(mwTime))), 2.0);
+    
+    EXPECT_TRUE(model.addSyncMatch(getOpenEphysTime(mwTime), mwTime));
+}
+
+
+// If the clocks jump (e.g. because Open Ephys restarted acquisition), the model follows them after
+// several consecutive rejections
+TEST(ClockModelTest, RefitsAfterClockJump) {
+    OpenEphysClockModel model;
+    for (std::size_t i = 0; i < 16; i++) {
+        ASSERT_TRUE(model.addSyncMatch(getOpenEphysTime(getSyncTime(i)), getSyncTime(i)));
+    }
+    
+    constexpr MWTime jump = 10000000;
+    std::size_t numRejected = 0;
+    std::size_t i = 16;
+    while (!model.addSyncMatch(getOpenEphysTime(getSyncTime(i)) - jump, getSyncTime(i))) {
+        numRejected++;
+        i++;
+        ASSERT_LT(numRejected, 32u);
+    }
+    EXPECT_GT(numRejected, 0u);
+    
+    const MWTime mwTime = getSyncTime(i);
+    EXPECT_NEAR(double(mwTime), double(model.convert(getOpenEphysTime(mwTime) - jump)), 2.0);
+}
+
+
+TEST(ClockModelTest, SavedModelIsProvisional) {
+    const std::string path = testing::TempDir() + "clock_model_test.txt";
+    std::remove(path.c_str());
+    
+    OpenEphysClockModel model;
+    for (std::size_t i = 0; i < 16; i++) {
+        model.addSyncMatch(getOpenEphysTime(getSyncTime(i)), getSyncTime(i));
+    }
+    ASSERT_TRUE(model.save(path, "tcp://localhost:5557"));
+    
+    OpenEphysClockModel restored;
+    EXPECT_FALSE(restored.load(path, "tcp://localhost:5558", getSyncTime(16)));
+    ASSERT_TRUE(restored.load(path, "tcp://localhost:5557", getSyncTime(16)));
+    EXPECT_TRUE(restored.isProvisional());
+    EXPECT_EQ(OpenEphysClockModel::LockState::Acquiring, restored.getLockState(getSyncTime(16)));
+    
+    const MWTime mwTime = getSyncTime(20);
+    EXPECT_NEAR(double(mwTime), double(restored.convert(getOpenEphysTime(mwTime))), 2.0);
+    EXPECT_GT(restored.getUncertainty(getOpenEphysTime(mwTime)), model.getUncertainty(getOpenEphysTime(mwTime)));
+    
+    std::remove(path.c_str());
+}
+
+
+TEST(ClockServiceTest, ConvertsSampleNumbers) {
+    OpenEphysClockModel model;
+    for (std::size_t i = 0; i < 16; i++) {
+        model.addSyncMatch(getOpenEphysTime(getSyncTime(i)), getSyncTime(i));
+    }
+    
+    OpenEphysClockService service(30000.0);
+    MWTime mwTime = 0;
+    EXPECT_FALSE(service.convert(0, mwTime));
+    service.update(model);
+    
+    const MWTime expected = getSyncTime(10);
+    const std::int64_t sampleNumber = std::llround(double(getOpenEphysTime(expected)) * 30000.0 / 1e6);
+    ASSERT_TRUE(service.convert(sampleNumber, mwTime));
+    EXPECT_NEAR(double(expected), double(mwTime), 40.0);
+    
+    std::int64_t roundTrip = 0;
+    ASSERT_TRUE(service.inverseConvert(mwTime, roundTrip));
+    EXPECT_NEAR(double(sampleNumber), double(roundTrip), 1.0);
+}
+
+
+TEST(ClockServiceTest, ReachableThroughCInterface) {
+    // What another plugin does, with the same entry point that the Open Ephys plugin exports
+    const OpenEphysClockServiceAPI *api = OpenEphysFindClockServiceAPI();
+    ASSERT_NE(nullptr, api);
+    EXPECT_EQ(OpenEphysGetClockServiceAPI(), api);
+    EXPECT_EQ(nullptr, api->lookupService("tcp://localhost:5557"));
+    
+    auto service = boost::make_shared<OpenEphysClockService>(30000.0);
+    OpenEphysClockService::registerService("tcp://localhost:5557", service);
+    OpenEphysClockServiceRef serviceRef = api->lookupService("tcp://localhost:5557");
+    ASSERT_NE(nullptr, serviceRef);
+    EXPECT_EQ(30000.0, api->getSampleRate(serviceRef));
+    
+    std::int64_t mwTime = 0;
+    EXPECT_FALSE(api->convertSeconds(serviceRef, 1.0, &mwTime));
+    
+    OpenEphysClockModel model;
+    for (std::size_t i = 0; i < 16; i++) {
+        model.addSyncMatch(getOpenEphysTime(getSyncTime(i)), getSyncTime(i));
+    }
+    service->update(model);
+    
+    const MWTime expected = getSyncTime(10);
+    ASSERT_TRUE(api->convertSeconds(serviceRef, double(getOpenEphysTime(expected)) / 1e6, &mwTime));
+    EXPECT_NEAR(double(expected), double(mwTime), 40.0);
+    double oeTime = 0.0;
+    ASSERT_TRUE(api->inverseConvertSeconds(serviceRef, mwTime, &oeTime));
+    EXPECT_NEAR(double(getOpenEphysTime(expected)) / 1e6, oeTime, 1e-4);
+    
+    const std::int64_t sampleNumber = std::llround(double(getOpenEphysTime(expected)) * 30000.0 / 1e6);
+    ASSERT_TRUE(api->convert(serviceRef, sampleNumber, &mwTime));
+    EXPECT_NEAR(double(expected), double(mwTime), 40.0);
+    std::int64_t roundTrip = 0;
+    ASSERT_TRUE(api->inverseConvert(serviceRef, mwTime, &roundTrip));
+    EXPECT_NEAR(double(sampleNumber), double(roundTrip), 1.0);
+    
+    // The reference keeps the service alive after it's unregistered
+    OpenEphysClockService::unregisterService("tcp://localhost:5557", service);
+    service.reset();
+    EXPECT_EQ(nullptr, api->lookupService("tcp://localhost:5557"));
+    EXPECT_TRUE(api->convert(serviceRef, sampleNumber, &mwTime));
+    api->releaseService(serviceRef);
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,382 @@
+//
+//  ContinuousTests.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "OpenEphysBandEstimator.hpp"
+#include "OpenEphysChannelReducer.hpp"
+#include "OpenEphysContinuousRing.hpp"
+#include "OpenEphysDecimator.hpp"
+#include "OpenEphysEnvelopeDetector.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+// Straightforward version of OpenEphysChannelReducer::process, one frame and one group at a time
+std::vector<float> reduceChannels(const std::vector<float> &input,
+                                  std::size_t numChannels,
+                                  OpenEphysChannelReducer::Reference reference,
+                                  std::size_t referenceGroupSize,
+                                  std::size_t averageGroupSize)
+{
+    std::vector<float> output;
+    for (std::size_t first = 0; first < input.size(); first += numChannels) {
+        std::vector<double> frame(input.begin() + first, input.begin() + first + numChannels);
+        
+        if (reference != OpenEphysChannelReducer::Reference::None) {
+            for (std::size_t start = 0; start < numChannels; start += referenceGroupSize) {
+                const std::size_t end = std::min(start + referenceGroupSize, numChannels);
+                std::vector<double> group(frame.begin() + start, frame.begin() + end);
+                double value = 0.0;
+                if (reference == OpenEphysChannelReducer::Reference::Average) {
+                    value = std::accumulate(group.begin(), group.end(), 0.0) / double(group.size());
+                } else {
+                    std::sort(group.begin(), group.end());
+                    const std::size_t middle = group.size() / 2;
+                    value = (group.size() % 2 ? group[middle] : (group[middle - 1] + group[middle]) / 2.0);
+                }
+                for (std::size_t channel = start; channel < end; channel++) {
+                    frame[channel] -= value;
+                }
+            }
+        }
+        
+        for (std::size_t start = 0; start < numChannels; start += averageGroupSize) {
+            const std::size_t end = std::min(start + averageGroupSize, numChannels);
+            output.push_back(float(std::accumulate(frame.begin() + start, frame.begin() + end, 0.0) /
+                                   double(end - start)));
+        }
+    }
+    return output;
+}
+
+
+END_NAMESPACE()
+
+
+TEST(BandEstimatorTest, TracksPhaseAndPowerOfSinusoids) {
+    // Theta-band sinusoids at and off the band's center, with different amplitudes and initial phases
+    constexpr double sampleRate = 1000.0;
+    constexpr std::size_t numChannels = 2;
+    const double frequencies[numChannels] = { 8.0, 7.0 };
+    const double amplitudes[numChannels] = { 1.0, 2.5 };
+    const double initialPhases[numChannels] = { 0.3, -2.0 };
+    
+    auto getPhase = [&](std::size_t channel, std::size_t sample) {
+        return 2.0 * M_PI * frequencies[channel] * double(sample) / sampleRate + initialPhases[channel];
+    };
+    
+    OpenEphysBandEstimator estimator(numChannels, sampleRate, 6.0, 10.0);
+    std::vector<float> frame(numChannels);
+    
+    for (std::size_t sample = 0; sample < 10000; sample++) {
+        for (std::size_t channel = 0; channel < numChannels; channel++) {
+            frame[channel] = float(amplitudes[channel] * std::cos(getPhase(channel, sample)));
+        }
+        estimator.process(frame.data(), 1);
+        
+        // Allow three seconds for the filters and frequency tracking to settle
+        if (sample < 3000 || sample % 7 != 0) {
+            continue;
+        }
+        
+        for (std::size_t channel = 0; channel < numChannels; channel++) {
+            // The analytic signal of A cos(wt + p) is A exp(i(wt + p)).  Its angle is the phase (zero at
+            // the peak), and half its squared magnitude is the mean square.
+            const auto analytic = std::polar(amplitudes[channel], getPhase(channel, sample));
+            const double phaseError = std::remainder(estimator.getPhase(channel) - std::arg(analytic), 2.0 * M_PI);
+            EXPECT_NEAR(0.0, phaseError, 0.15) << "channel " << channel << ", sample " << sample;
+            EXPECT_NEAR(std::norm(analytic) / 2.0, estimator.getPower(channel), 0.1 * std::norm(analytic) / 2.0)
+                << "channel " << channel << ", sample " << sample;
+            EXPECT_NEAR(frequencies[channel], estimator.getFrequency(channel), 0.1) << "channel " << channel;
+        }
+    }
+}
+
+
+TEST(DecimatorTest, PassesBandAndRejectsAliases) {
+    // 30 kHz to 1 kHz.  Channel 0 is well within the passband, and channel 1 would alias.
+    constexpr double sampleRate = 30000.0;
+    constexpr std::size_t factor = 30;
+    constexpr double passFrequency = 100.0;
+    constexpr double stopFrequency = 2000.0;
+    constexpr std::int64_t firstSampleNumber = 1000;
+    constexpr std::size_t numFrames = 30000;
+    
+    OpenEphysDecimator decimator(2, factor);
+    ASSERT_EQ(120.0, decimator.getDelay());
+    
+    auto getTime = [&](double sampleNumber) {
+        return sampleNumber / sampleRate;
+    };
+    
+    std::vector<float> input;
+    for (std::size_t frame = 0; frame < numFrames; frame++) {
+        const double time = getTime(double(firstSampleNumber + std::int64_t(frame)));
+        input.push_back(float(std::sin(2.0 * M_PI * passFrequency * time)));
+        input.push_back(float(std::sin(2.0 * M_PI * stopFrequency * time)));
+    }
+    
+    // Blocks that don't divide the factor exercise the phase carried between calls
+    std::vector<float> output;
+    std::vector<std::int64_t> outputSampleNumbers;
+    constexpr std::size_t blockSize = 7;
+    for (std::size_t first = 0; first < numFrames; first += blockSize) {
+        decimator.process(input.data() + first * 2,
+                          std::min(blockSize, numFrames - first),
+                          firstSampleNumber + std::int64_t(first),
+                          output,
+                          outputSampleNumbers);
+    }
+    
+    // Every factor-th input frame produces an output frame, stamped with its sample number
+    ASSERT_EQ(numFrames / factor, outputSampleNumbers.size());
+    ASSERT_EQ(outputSampleNumbers.size() * 2, output.size());
+    for (std::size_t i = 0; i < outputSampleNumbers.size(); i++) {
+        ASSERT_EQ(firstSampleNumber + std::int64_t((i + 1) * factor - 1), outputSampleNumbers[i]) << i;
+    }
+    
+    // Once the filter history is full, the passband signal matches the input as of the filter's delay,
+    // with unit gain, and the stopband signal is at least 80 dB down
+    const std::size_t firstFullOutput = decimator.getNumTaps() / factor + 1;
+    for (std::size_t i = firstFullOutput; i < outputSampleNumbers.size(); i++) {
+        const double time = getTime(double(outputSampleNumbers[i]) - decimator.getDelay());
+        EXPECT_NEAR(std::sin(2.0 * M_PI * passFrequency * time), output[i * 2], 0.005) << i;
+        EXPECT_NEAR(0.0, output[i * 2 + 1], 1e-4) << i;
+    }
+}
+
+
+TEST(ContinuousRingTest, WrapsAround) {
+    OpenEphysContinuousRing ring(2, 8);
+    MWTime latestTime = 0;
+    EXPECT_FALSE(ring.getLatestTime(latestTime));
+    
+    // Frame i has time 10 * i and samples (i, -i).  The second write wraps around the end of the ring.
+    auto write = [&ring](std::size_t first, std::size_t count) {
+        std::vector<float> frames;
+        std::vector<MWTime> times;
+        for (std::size_t i = first; i < first + count; i++) {
+            frames.push_back(float(i));
+            frames.push_back(-float(i));
+            times.push_back(MWTime(10 * i));
+        }
+        ring.write(frames.data(), times.data(), count);
+    };
+    write(0, 5);
+    write(5, 6);
+    
+    ASSERT_TRUE(ring.getLatestTime(latestTime));
+    EXPECT_EQ(100, latestTime);
+    
+    // Only the most recent eight frames remain, in order
+    std::vector<MWTime> times;
+    std::vector<float> frames;
+    ASSERT_EQ(8u, ring.read(0, 1000, times, frames));
+    ASSERT_EQ(16u, frames.size());
+    for (std::size_t i = 0; i < 8; i++) {
+        EXPECT_EQ(MWTime(10 * (i + 3)), times[i]);
+        EXPECT_EQ(float(i + 3), frames[i * 2]);
+        EXPECT_EQ(-float(i + 3), frames[i * 2 + 1]);
+    }
+    
+    // A write longer than the ring keeps only its end
+    write(11, 20);
+    ASSERT_EQ(8u, ring.read(0, 1000, times, frames));
+    EXPECT_EQ(230, times.front());
+    EXPECT_EQ(300, times.back());
+    EXPECT_EQ(23.0f, frames.front());
+    
+    ring.clear();
+    EXPECT_FALSE(ring.getLatestTime(latestTime));
+    EXPECT_EQ(0u, ring.read(0, 1000, times, frames));
+    EXPECT_TRUE(frames.empty());
+}
+
+
+TEST(ContinuousRingTest, ReadsTimeWindows) {
+    OpenEphysContinuousRing ring(1, 16);
+    std::vector<float> frames;
+    std::vector<MWTime> times;
+    for (int i = 0; i < 24; i++) {
+        frames.push_back(float(i));
+        times.push_back(MWTime(1000 + 100 * i));
+    }
+    ring.write(frames.data(), times.data(), times.size());
+    
+    std::vector<MWTime> readTimes;
+    std::vector<float> readFrames;
+    
+    // Windows are [start, end), whether or not their edges fall on frame times
+    EXPECT_EQ(3u, ring.read(2000, 2300, readTimes, readFrames));
+    EXPECT_EQ((std::vector<MWTime> { 2000, 2100, 2200 }), readTimes);
+    EXPECT_EQ((std::vector<float> { 10.0f, 11.0f, 12.0f }), readFrames);
+    EXPECT_EQ(3u, ring.read(1950, 2250, readTimes, readFrames));
+    EXPECT_EQ((std::vector<MWTime> { 2000, 2100, 2200 }), readTimes);
+    
+    // Windows that extend past the history are clipped to it.  The oldest frame remaining is frame 8.
+    EXPECT_EQ(2u, ring.read(0, 2000, readTimes, readFrames));
+    EXPECT_EQ((std::vector<MWTime> { 1800, 1900 }), readTimes);
+    EXPECT_EQ(4u, ring.read(3000, 5000, readTimes, readFrames));
+    EXPECT_EQ((std::vector<float> { 20.0f, 21.0f, 22.0f, 23.0f }), readFrames);
+    
+    // Empty windows, and those outside the history, replace the previous contents with nothing
+    EXPECT_EQ(0u, ring.read(2000, 2000, readTimes, readFrames));
+    EXPECT_TRUE(readTimes.empty());
+    EXPECT_EQ(0u, ring.read(5000, 6000, readTimes, readFrames));
+    EXPECT_TRUE(readFrames.empty());
+}
+
+
+TEST(EnvelopeDetectorTest, DetectsBurstInNoise) {
+    // Eight seconds of white noise on four channels, with a 60 ms, 200 Hz burst (under a Hann-squared
+    // window) on channel 2 starting at five seconds
+    constexpr double sampleRate = 1000.0;
+    constexpr std::size_t numChannels = 4;
+    constexpr std::size_t numFrames = 8000;
+    constexpr std::size_t burstChannel = 2;
+    constexpr std::size_t burstStart = 5000;
+    constexpr std::size_t burstLength = 60;
+    constexpr double burstAmplitude = 8.0;
+    constexpr double rmsTimeConstant = 0.01;
+    constexpr double threshold = 5.0;
+    constexpr std::size_t minDurationFrames = 15;
+    
+    std::mt19937 engine(1);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::vector<float> frames(numFrames * numChannels);
+    for (std::size_t frame = 0; frame < numFrames; frame++) {
+        for (std::size_t channel = 0; channel < numChannels; channel++) {
+            float value = noise(engine);
+            if (channel == burstChannel && frame >= burstStart && frame < burstStart + burstLength) {
+                const double window = std::sin(M_PI * (double(frame - burstStart) + 0.5) / double(burstLength));
+                value += float(burstAmplitude * window * window * std::sin(2.0 * M_PI * 200.0 * frame / sampleRate));
+            }
+            frames[frame * numChannels + channel] = value;
+        }
+    }
+    
+    OpenEphysEnvelopeDetector detector(numChannels,
+                                       sampleRate,
+                                       150.0,
+                                       250.0,
+                                       rmsTimeConstant,
+                                       2.0,
+                                       threshold,
+                                       double(minDurationFrames) / sampleRate);
+    
+    // Event frames are relative to each call, so convert them to indexes into the whole signal
+    std::vector<OpenEphysEnvelopeDetector::Event> events;
+    constexpr std::size_t blockSize = 37;
+    for (std::size_t first = 0; first < numFrames; first += blockSize) {
+        const std::size_t count = std::min(blockSize, numFrames - first);
+        for (auto event : detector.process(frames.data() + first * numChannels, count)) {
+            event.frame += first;
+            events.push_back(event);
+        }
+    }
+    
+    // The noise alone never stays above the threshold for the minimum duration
+    ASSERT_EQ(2u, events.size());
+    const auto &onset = events[0];
+    const auto &offset = events[1];
+    ASSERT_EQ(OpenEphysEnvelopeDetector::Event::Type::Onset, onset.type);
+    ASSERT_EQ(OpenEphysEnvelopeDetector::Event::Type::Offset, offset.type);
+    
+    // The onset is reported during the burst, once the envelope has been above the threshold for the
+    // minimum duration, and that period starts no earlier than the burst
+    EXPECT_EQ(minDurationFrames, onset.duration);
+    EXPECT_GE(onset.frame + 1, burstStart + onset.duration);
+    EXPECT_LT(onset.frame, burstStart + burstLength);
+    EXPECT_EQ(burstChannel, onset.channel);
+    EXPECT_GE(onset.zScore, threshold);
+    
+    // The offset follows the end of the burst within a few envelope time constants
+    const std::size_t burstEnd = burstStart + burstLength;
+    EXPECT_GE(offset.frame, burstEnd);
+    EXPECT_LT(offset.frame, burstEnd + std::size_t(8.0 * rmsTimeConstant * sampleRate));
+    EXPECT_EQ(offset.frame - onset.frame + onset.duration, offset.duration);
+    EXPECT_EQ(burstChannel, offset.channel);
+    
+    // The offset reports the peak of the event, far above the threshold
+    EXPECT_GE(offset.zScore, onset.zScore);
+    EXPECT_GT(offset.zScore, 4.0 * threshold);
+}
+
+
+TEST(ChannelReducerTest, MatchesScalarReference) {
+    // Enough frames to span several blocks, and a channel count that leaves partial groups
+    constexpr std::size_t numChannels = 13;
+    constexpr std::size_t numFrames = 1000;
+    
+    std::mt19937 engine(1);
+    std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+    std::vector<float> input(numFrames * numChannels);
+    for (auto &value : input) {
+        value = distribution(engine);
+    }
+    
+    struct Configuration {
+        OpenEphysChannelReducer::Reference reference;
+        std::size_t referenceGroupSize;  // As given to the reducer, so zero means all channels
+        std::size_t averageGroupSize;
+        std::size_t numOutputChannels;
+    };
+    using Reference = OpenEphysChannelReducer::Reference;
+    const Configuration configurations[] = {
+        { Reference::Average, 0, 1, 13 },  // Common average reference
+        { Reference::Median, 0, 1, 13 },   // Common median reference (odd group)
+        { Reference::Median, 4, 1, 13 },   // Group medians of even groups, and of a single channel
+        { Reference::Median, 5, 1, 13 },   // Group medians of odd and even groups
+        { Reference::None, 1, 4, 4 },      // Group averages, with a single channel in the last group
+        { Reference::None, 1, 0, 1 },      // Average of all channels
+        { Reference::Average, 4, 3, 5 },
+        { Reference::Median, 6, 5, 3 },
+    };
+    
+    for (auto &configuration : configurations) {
+        OpenEphysChannelReducer reducer(numChannels,
+                                        configuration.reference,
+                                        configuration.referenceGroupSize,
+                                        configuration.averageGroupSize);
+        ASSERT_EQ(configuration.numOutputChannels, reducer.getNumOutputChannels());
+        EXPECT_FALSE(reducer.isIdentity());
+        
+        std::vector<float> output;
+        reducer.process(input.data(), numFrames, output);
+        
+        const std::size_t referenceGroupSize = (configuration.referenceGroupSize == 0 ?
+                                                numChannels :
+                                                configuration.referenceGroupSize);
+        const auto expected = reduceChannels(input,
+                                             numChannels,
+                                             configuration.reference,
+                                             referenceGroupSize,
+                                             reducer.getAverageGroupSize());
+        ASSERT_EQ(expected.size(), output.size());
+        for (std::size_t i = 0; i < expected.size(); i++) {
+            ASSERT_NEAR(expected[i], output[i], 1e-3)
+                << "reference " << int(configuration.reference)
+                << ", reference group size " << configuration.referenceGroupSize
+                << ", average group size " << configuration.averageGroupSize
+                << ", frame " << i / configuration.numOutputChannels
+                << ", channel " << i % configuration.numOutputChannels;
+        }
+    }
+    
+    OpenEphysChannelReducer identity(numChannels, OpenEphysChannelReducer::Reference::None, 0, 1);
+    EXPECT_TRUE(identity.isIdentity());
+}
+
+
+END_NAMESPACE_MW
@@ -0,0 +1,141 @@
+//
+//  EventDecodingTests.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "OpenEphysSyncMatcher.hpp"
+#include "OpenEphysSyncSequence.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+// Every nonzero word of each width appears exactly once per period, and the sequence then repeats
+TEST(SyncSequenceTest, PeriodAndUniqueness) {
+    for (std::size_t numBits = 2; numBits <= OpenEphysSyncSequence::maxBits; numBits++) {
+        OpenEphysSyncSequence sequence(numBits);
+        const std::size_t period = (std::size_t(1) << numBits) - 1;
+        ASSERT_EQ(period, sequence.getPeriod()) << numBits << " bits";
+        
+        std::vector<int> words;
+        std::vector<bool> seen(period + 1, false);
+        for (std::size_t i = 0; i < period; i++) {
+            const int word = sequence.next();
+            ASSERT_GE(word, 1) << numBits << " bits";
+            ASSERT_LE(word, int(period)) << numBits << " bits";
+            EXPECT_FALSE(seen[word]) << numBits << " bits, word " << word;
+            seen[word] = true;
+            words.push_back(word);
+        }
+        for (std::size_t i = 0; i < period; i++) {
+            EXPECT_EQ(words[i], sequence.next()) << numBits << " bits";
+        }
+    }
+}
+
+
+// With a single sync line, the only sequence is alternation
+TEST(SyncSequenceTest, SingleBitAlternates) {
+    OpenEphysSyncSequence sequence(1);
+    EXPECT_EQ(2u, sequence.getPeriod());
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(1, sequence.next());
+        EXPECT_EQ(0, sequence.next());
+    }
+}
+
+
+TEST(SyncSequenceTest, RejectsInvalidWidths) {
+    EXPECT_THROW(OpenEphysSyncSequence(0), SimpleException);
+    EXPECT_THROW(OpenEphysSyncSequence(OpenEphysSyncSequence::maxBits + 1), SimpleException);
+}
+
+
+TEST(SyncWordDecoderTest, RoundTrip) {
+    const OpenEphysSyncWordDecoder decoder({ 2, 0, 5 });
+    for (std::uint64_t word = 0; word < 8; word++) {
+        const std::uint64_t ttlWord = decoder.encode(word);
+        EXPECT_EQ(0u, ttlWord & ~std::uint64_t(0x25));
+        EXPECT_EQ(word, decoder.decode(ttlWord));
+        // Other TTL lines are ignored
+        EXPECT_EQ(word, decoder.decode(ttlWord | 0xDA));
+    }
+    EXPECT_EQ(0x04u, decoder.encode(1));
+}
+
+
+TEST(SyncWordDecoderTest, RejectsInvalidChannels) {
+    EXPECT_THROW(OpenEphysSyncWordDecoder({ 64 }), SimpleException);
+    EXPECT_NO_THROW(OpenEphysSyncWordDecoder({ 63 }));
+    
+    std::vector<std::uint8_t> channels;
+    for (std::size_t i = 0; i < OpenEphysSyncWordDecoder::maxChannels; i++) {
+        channels.push_back(std::uint8_t(i * 2));
+    }
+    const OpenEphysSyncWordDecoder decoder(channels);
+    EXPECT_EQ(0x7FFFFFFFu, decoder.decode(~std::uint64_t(0)));
+    
+    channels.push_back(63);
+    EXPECT_THROW(OpenEphysSyncWordDecoder{channels}, SimpleException);
+}
+
+
+TEST(SyncMatcherTest, MatchesInOrder) {
+    OpenEphysSyncMatcher matcher(8);
+    matcher.addSentValue(0x10, 1000);
+    matcher.addSentValue(0x21, 2000);
+    matcher.addSentValue(0x42, 3000);
+    matcher.addSentValue(0x84, 4000);
+    
+    MWTime sendTime = 0;
+    EXPECT_EQ(OpenEphysSyncMatcher::Result::Matched, matcher.matchReceivedValue(0x10, sendTime));
+    EXPECT_EQ(1000, sendTime);
+    // Skipping a lost word
+    EXPECT_EQ(OpenEphysSyncMatcher::Result::Matched, matcher.matchReceivedValue(0x42, sendTime));
+    EXPECT_EQ(3000, sendTime);
+    // Words that were already matched (or skipped) aren't matched again
+    EXPECT_EQ(OpenEphysSyncMatcher::Result::Unmatched, matcher.matchReceivedValue(0x21, sendTime));
+}
+
+
+// A partial word seen while the TTL lines change from the previous word to the next is a transition,
+// even if it equals a pending transmission
+TEST(SyncMatcherTest, RecognizesTransitions) {
+    OpenEphysSyncMatcher matcher(8);
+    MWTime sendTime = 0;
+    matcher.addSentValue(0x1, 1000);
+    ASSERT_EQ(OpenEphysSyncMatcher::Result::Matched, matcher.matchReceivedValue(0x1, sendTime));
+    
+    matcher.addSentValue(0x6, 2000);
+    matcher.addSentValue(0x2, 3000);
+    // On the way from 0x1 to 0x6, the lines can read 0x3 and then 0x2
+    EXPECT_EQ(OpenEphysSyncMatcher::Result::Transition, matcher.matchReceivedValue(0x3, sendTime));
+    EXPECT_EQ(OpenEphysSyncMatcher::Result::Transition, matcher.matchReceivedValue(0x2, sendTime));
+    EXPECT_EQ(OpenEphysSyncMatcher::Result::Matched, matcher.matchReceivedValue(0x6, sendTime));
+    EXPECT_EQ(2000, sendTime);
+}
+
+
+TEST(SyncMatcherTest, WindowLimitsHistory) {
+    OpenEphysSyncMatcher matcher(2);
+    matcher.addSentValue(1, 1000);
+    matcher.addSentValue(2, 2000);
+    matcher.addSentValue(3, 3000);
+    
+    MWTime sendTime = 0;
+    EXPECT_FALSE(matcher.getSendTime(1, sendTime));
+    EXPECT_TRUE(matcher.getSendTime(2, sendTime));
+    EXPECT_EQ(2000, sendTime);
+    EXPECT_EQ(OpenEphysSyncMatcher::Result::Unmatched, matcher.matchReceivedValue(1, sendTime));
+    EXPECT_EQ(OpenEphysSyncMatcher::Result::Matched, matcher.matchReceivedValue(2, sendTime));
+    EXPECT_EQ(3, matcher.getLastSentValue());
+    
+    EXPECT_THROW(OpenEphysSyncMatcher(0), SimpleException);
+}
+
+
+END_NAMESPACE_MW
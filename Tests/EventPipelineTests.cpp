@@ -0,0 +1,191 @@
+//
+//  EventPipelineTests.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "OpenEphysEventPipeline.hpp"
+#include "OpenEphysSimulationModel.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+const std::vector<std::uint8_t> syncChannels { 0, 1, 2, 3 };
+constexpr MWTime syncInterval = 100000;
+constexpr MWTime syncEchoLatency = 2000;
+constexpr MWTime oeClockOffset = 5000000;
+constexpr double oeClockDrift = 30.0;  // ppm
+constexpr double sampleRate = 30000.0;
+constexpr MWTime startTime = 1000000;
+constexpr MWTime updateInterval = 10000;
+
+
+// Records everything the pipeline publishes, on a clock advanced by the test
+class TestDelegate : public OpenEphysEventPipeline::Delegate {
+public:
+    struct PublishedSpike {
+        OpenEphysSpikeRecord spike;
+        MWTime publishTime;
+    };
+    
+    MWTime getCurrentTime() override { return currentTime; }
+    
+    void publishClockOffset(MWTime offset, MWTime time) override {
+        clockOffsets.emplace_back(offset, time);
+    }
+    
+    void publishClockQuality(const OpenEphysClockModel &clockModel, MWTime currentTime) override {
+        lockState = clockModel.getLockState(currentTime);
+    }
+    
+    void publishSpike(const OpenEphysSpikeRecord &spike) override {
+        spikes.push_back({ spike, currentTime });
+    }
+    
+    void publishSpikeBatch(const std::string &batch, MWTime firstSpikeTime) override {
+        std::vector<OpenEphysSpikeRecord> records;
+        ASSERT_TRUE(decodeSpikeBatch(batch, records));
+        ASSERT_FALSE(records.empty());
+        EXPECT_EQ(firstSpikeTime, records.front().time);
+        for (auto &spike : records) {
+            spikes.push_back({ spike, currentTime });
+        }
+        numBatches++;
+    }
+    
+    void publishOverloadMode(OpenEphysOverloadController::Mode, MWTime) override { }
+    void publishSpikeSummary(MWTime, MWTime, const std::vector<OpenEphysOverloadController::UnitCount> &) override { }
+    void publishUnitQuality(MWTime,
+                            MWTime,
+                            const std::vector<OpenEphysUnitQuality::UnitStats> &,
+                            const std::vector<MWTime> &) override
+    { }
+    
+    MWTime currentTime = startTime;
+    std::vector<std::pair<MWTime, MWTime>> clockOffsets;
+    OpenEphysClockModel::LockState lockState = OpenEphysClockModel::LockState::Unlocked;
+    std::vector<PublishedSpike> spikes;
+    std::size_t numBatches = 0;
+};
+
+
+class EventPipelineTest : public testing::Test {
+protected:
+    EventPipelineTest() :
+        clockService(boost::make_shared<OpenEphysClockService>(sampleRate)),
+        pipeline(delegate, syncChannels, clockService),
+        model(syncChannels, syncEchoLatency, 0, oeClockOffset, oeClockDrift, sampleRate, 50.0, 7)
+    {
+        model.addUnit(1, 1, 0.0);
+        model.addUnit(2, 1, 0.0);
+        
+        pipeline.setSyncInterval(syncInterval);
+        pipeline.setSyncLatency(syncEchoLatency);
+    }
+    
+    // Inverse of the simulated Open Ephys clock
+    static double getMWorksTime(double oeTimestamp) {
+        return double(startTime) + (oeTimestamp * 1e6 - double(oeClockOffset)) / (1.0 + oeClockDrift / 1e6);
+    }
+    
+    // Runs the simulation, sending a sync word every sync interval and passing every simulated event to
+    // the pipeline as soon as it's due
+    void run(MWTime duration) {
+        ASSERT_TRUE(pipeline.reset());
+        model.startClock(startTime);
+        model.start(startTime);
+        pipeline.begin();
+        
+        const auto handler = [this](std::uint8_t type, double timestamp, const void *body, std::size_t size) {
+            if (type == OpenEphysEvent::spikeType) {
+                spikeTimestamps.push_back(timestamp);
+            }
+            pipeline.handleEvent(type, timestamp, static_cast<const std::uint8_t *>(body), size);
+        };
+        
+        for (MWTime time = startTime; time < startTime + duration; time += updateInterval) {
+            delegate.currentTime = time;
+            if ((time - startTime) % syncInterval == 0) {
+                const int value = pipeline.nextSyncWord();
+                pipeline.addSentSyncWord(value, time);
+                model.handleSync(value, time);
+            }
+            model.update(time, 0.0, handler);
+            pipeline.update();
+        }
+        
+        pipeline.end();
+        model.stop();
+        pipeline.stop();
+    }
+    
+    TestDelegate delegate;
+    const boost::shared_ptr<OpenEphysClockService> clockService;
+    OpenEphysEventPipeline pipeline;
+    OpenEphysSimulationModel model;
+    std::vector<double> spikeTimestamps;
+};
+
+
+END_NAMESPACE()
+
+
+TEST_F(EventPipelineTest, LocksClockAndConvertsSpikeTimes) {
+    pipeline.enableSpikes(0);
+    pipeline.setSpikeStore(std::unique_ptr<OpenEphysSpikeStore>(new OpenEphysSpikeStore(1024)));
+    run(5000000);
+    
+    // Every sync word after the first few is matched
+    EXPECT_EQ(OpenEphysClockModel::LockState::Locked, delegate.lockState);
+    EXPECT_GE(delegate.clockOffsets.size(), 45u);
+    EXPECT_EQ(0u, pipeline.getClockModel().getNumRejectedMatches());
+    EXPECT_NEAR(1.0 / (1.0 + oeClockDrift / 1e6) - 1.0, pipeline.getClockModel().getDrift(), 1e-6);
+    
+    ASSERT_EQ(spikeTimestamps.size(), delegate.spikes.size());
+    ASSERT_GT(spikeTimestamps.size(), 300u);
+    
+    std::size_t numChecked = 0;
+    for (std::size_t i = 0; i < delegate.spikes.size(); i++) {
+        const auto &item = delegate.spikes[i];
+        const auto &spike = item.spike;
+        EXPECT_EQ(1, spike.sortedID);
+        EXPECT_TRUE(spike.electrodeID == 1 || spike.electrodeID == 2);
+        
+        // Spike times are exact once the clock model has a few matches
+        if (item.publishTime >= startTime + 500000) {
+            EXPECT_NEAR(getMWorksTime(spikeTimestamps[i]), double(spike.time), 3.0);
+            EXPECT_NEAR(spikeTimestamps[i] * sampleRate, double(spike.sampleNumber), 0.5);
+            EXPECT_LE(spike.time, item.publishTime);
+            numChecked++;
+        }
+    }
+    EXPECT_GT(numChecked, 0u);
+    
+    // Every published spike was also stored
+    auto *spikeStore = pipeline.getSpikeStore();
+    EXPECT_EQ(spikeTimestamps.size(),
+              spikeStore->count(1, 1, 0, startTime + 10000000) + spikeStore->count(2, 1, 0, startTime + 10000000));
+}
+
+
+TEST_F(EventPipelineTest, PublishesSpikeBatches) {
+    constexpr MWTime batchInterval = 100000;
+    pipeline.enableSpikes(batchInterval);
+    EXPECT_EQ(batchInterval, pipeline.getUpdateInterval());
+    run(2000000);
+    
+    ASSERT_GT(spikeTimestamps.size(), 100u);
+    EXPECT_EQ(spikeTimestamps.size(), delegate.spikes.size());
+    EXPECT_GE(delegate.numBatches, 15u);
+    EXPECT_LE(delegate.numBatches, 21u);
+}
+
+
+END_NAMESPACE_MW
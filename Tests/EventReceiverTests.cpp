@@ -0,0 +1,159 @@
+//
+//  EventReceiverTests.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "OpenEphysEventPipeline.hpp"
+#include "OpenEphysEventReceiver.hpp"
+#include "OpenEphysSimulationModel.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+const std::vector<std::uint8_t> syncChannels { 0, 1, 2, 3 };
+constexpr MWTime syncInterval = 100000;
+constexpr MWTime syncEchoLatency = 2000;
+constexpr MWTime oeClockOffset = 5000000;
+constexpr double oeClockDrift = 30.0;  // ppm
+constexpr double sampleRate = 30000.0;
+constexpr MWTime updateInterval = 10000;
+
+
+MWTime getSteadyTime() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+// Records what the pipeline publishes.  Read only after the receiver stops.
+class TestDelegate : public OpenEphysEventPipeline::Delegate {
+public:
+    MWTime getCurrentTime() override { return getSteadyTime(); }
+    
+    void publishClockOffset(MWTime offset, MWTime) override { clockOffsets.push_back(offset); }
+    void publishClockQuality(const OpenEphysClockModel &, MWTime) override { }
+    void publishSpike(const OpenEphysSpikeRecord &spike) override { spikes.push_back(spike); }
+    void publishSpikeBatch(const std::string &, MWTime) override { }
+    void publishOverloadMode(OpenEphysOverloadController::Mode, MWTime) override { }
+    void publishSpikeSummary(MWTime, MWTime, const std::vector<OpenEphysOverloadController::UnitCount> &) override { }
+    void publishUnitQuality(MWTime,
+                            MWTime,
+                            const std::vector<OpenEphysUnitQuality::UnitStats> &,
+                            const std::vector<MWTime> &) override
+    { }
+    
+    std::vector<MWTime> clockOffsets;
+    std::vector<OpenEphysSpikeRecord> spikes;
+};
+
+
+bool sendEvent(void *socket, std::uint8_t type, double timestamp, const void *body, std::size_t size) {
+    return (-1 != zmq_send(socket, &type, sizeof(type), ZMQ_SNDMORE) &&
+            -1 != zmq_send(socket, &timestamp, sizeof(timestamp), ZMQ_SNDMORE) &&
+            -1 != zmq_send(socket, body, size, 0));
+}
+
+
+END_NAMESPACE()
+
+
+// Sends simulated Event Broadcaster messages through a local PUB socket to a receiver driving a pipeline
+TEST(EventReceiverTest, EndToEnd) {
+    void *context = zmq_ctx_new();
+    ASSERT_NE(nullptr, context);
+    void *publisher = zmq_socket(context, ZMQ_PUB);
+    void *subscriber = zmq_socket(context, ZMQ_SUB);
+    ASSERT_NE(nullptr, publisher);
+    ASSERT_NE(nullptr, subscriber);
+    
+    const int linger = 0;
+    zmq_setsockopt(publisher, ZMQ_LINGER, &linger, sizeof(linger));
+    zmq_setsockopt(subscriber, ZMQ_LINGER, &linger, sizeof(linger));
+    
+    ASSERT_EQ(0, zmq_bind(publisher, "tcp://127.0.0.1:*"));
+    char endpoint[256];
+    std::size_t endpointSize = sizeof(endpoint);
+    ASSERT_EQ(0, zmq_getsockopt(publisher, ZMQ_LAST_ENDPOINT, endpoint, &endpointSize));
+    
+    TestDelegate delegate;
+    OpenEphysEventPipeline pipeline(delegate, syncChannels, boost::make_shared<OpenEphysClockService>(sampleRate));
+    pipeline.setSyncInterval(syncInterval);
+    pipeline.setSyncLatency(syncEchoLatency);
+    pipeline.enableSpikes(0);
+    
+    OpenEphysEventReceiver receiver(pipeline);
+    ASSERT_TRUE(receiver.configure(subscriber));
+    ASSERT_EQ(0, zmq_connect(subscriber, endpoint));
+    // Give the subscriptions time to reach the publisher
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    
+    OpenEphysSimulationModel model(syncChannels, syncEchoLatency, 0, oeClockOffset, oeClockDrift, sampleRate, 50.0, 11);
+    model.addUnit(1, 1, 0.0);
+    model.addUnit(1, 2, 0.0);
+    
+    std::vector<double> spikeTimestamps;
+    bool sendFailed = false;
+    const auto handler = [&](std::uint8_t type, double timestamp, const void *body, std::size_t size) {
+        if (type == OpenEphysEvent::spikeType) {
+            spikeTimestamps.push_back(timestamp);
+        }
+        if (!sendEvent(publisher, type, timestamp, body, size)) {
+            sendFailed = true;
+        }
+    };
+    
+    ASSERT_TRUE(pipeline.reset());
+    const MWTime startTime = getSteadyTime();
+    model.startClock(startTime);
+    model.start(startTime);
+    receiver.start();
+    
+    MWTime nextSyncTime = startTime, lastSyncTime = startTime;
+    for (MWTime time = startTime; time < startTime + 2000000; time = getSteadyTime()) {
+        if (time >= nextSyncTime) {
+            const int value = pipeline.nextSyncWord();
+            pipeline.addSentSyncWord(value, time);
+            model.handleSync(value, time);
+            lastSyncTime = time;
+            nextSyncTime += syncInterval;
+        }
+        model.update(time, 0.0, handler);
+        std::this_thread::sleep_for(std::chrono::microseconds(updateInterval));
+    }
+    
+    // Let the receiver drain the socket
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    receiver.stop();
+    model.stop();
+    pipeline.stop();
+    
+    zmq_close(subscriber);
+    zmq_close(publisher);
+    zmq_ctx_term(context);
+    
+    EXPECT_FALSE(sendFailed);
+    EXPECT_GE(delegate.clockOffsets.size(), 10u);
+    // The wait for the receiver outlasts the holdover timeout, so check the state as of the last sync word
+    EXPECT_EQ(OpenEphysClockModel::LockState::Locked, pipeline.getClockModel().getLockState(lastSyncTime));
+    
+    // Sync words are matched by their send times, so converted times don't depend on delivery delays
+    ASSERT_EQ(spikeTimestamps.size(), delegate.spikes.size());
+    ASSERT_GT(spikeTimestamps.size(), 50u);
+    for (std::size_t i = 0; i < spikeTimestamps.size(); i++) {
+        const double oeTime = spikeTimestamps[i] * 1e6;
+        const double mwTime = double(startTime) + (oeTime - double(oeClockOffset)) / (1.0 + oeClockDrift / 1e6);
+        if (mwTime >= double(startTime + 500000)) {
+            EXPECT_NEAR(mwTime, double(delegate.spikes[i].time), 3.0) << i;
+        }
+    }
+}
+
+
+END_NAMESPACE_MW
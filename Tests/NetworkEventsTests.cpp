@@ -0,0 +1,58 @@
+//
+//  NetworkEventsTests.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "OpenEphysNetworkEventsRequester.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+TEST(NetworkEventsRequesterTest, RoundTrip) {
+    std::unique_ptr<void, decltype(&zmq_ctx_term)> context(zmq_ctx_new(), zmq_ctx_term);
+    std::unique_ptr<void, decltype(&zmq_close)> server(zmq_socket(context.get(), ZMQ_REP), zmq_close);
+    std::unique_ptr<void, decltype(&zmq_close)> client(zmq_socket(context.get(), ZMQ_REQ), zmq_close);
+    
+    const int linger = 0;
+    ASSERT_EQ(0, zmq_setsockopt(server.get(), ZMQ_LINGER, &linger, sizeof(linger)));
+    
+    OpenEphysNetworkEventsRequester requester;
+    ASSERT_TRUE(requester.configure(client.get()));
+    ASSERT_EQ(0, zmq_bind(server.get(), "inproc://network_events_test"));
+    ASSERT_EQ(0, zmq_connect(client.get(), "inproc://network_events_test"));
+    
+    // Stands in for the Network Events module, echoing each request, padded past the longest
+    // response the requester keeps
+    std::thread serverThread([&]() {
+        for (int i = 0; i < 2; i++) {
+            std::vector<char> req(256);
+            const int size = zmq_recv(server.get(), req.data(), req.size(), 0);
+            if (size == -1) {
+                return;
+            }
+            std::string rep(req.data(), size);
+            if (i == 1) {
+                rep.resize(OpenEphysNetworkEventsRequester::maxResponseSize + 100, '.');
+            }
+            zmq_send(server.get(), rep.data(), rep.size(), 0);
+        }
+    });
+    
+    std::string response;
+    EXPECT_TRUE(requester.sendRequest("StartRecord", response));
+    EXPECT_EQ("StartRecord", response);
+    
+    EXPECT_TRUE(requester.sendRequest("StopRecord", response));
+    EXPECT_EQ(OpenEphysNetworkEventsRequester::maxResponseSize, response.size());
+    EXPECT_EQ(0u, response.find("StopRecord."));
+    
+    serverThread.join();
+}
+
+
+END_NAMESPACE_MW
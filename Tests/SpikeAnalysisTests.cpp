@@ -0,0 +1,144 @@
+//
+//  SpikeAnalysisTests.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "OpenEphysCrossCorrelogram.hpp"
+#include "OpenEphysPopulationDecoder.hpp"
+#include "OpenEphysSpikeTriggeredAverage.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+TEST(CrossCorrelogramTest, CountsLagsOfEachPair) {
+    OpenEphysCrossCorrelogram correlogram(2, 10000, 1000);
+    ASSERT_EQ(20u, correlogram.getNumBins());
+    
+    correlogram.addSpike(0, 100000);
+    correlogram.addSpike(1, 102500);
+    // Outside the window of both earlier spikes
+    correlogram.addSpike(1, 200000);
+    EXPECT_EQ(1u, correlogram.getSpikeCount(0));
+    EXPECT_EQ(2u, correlogram.getSpikeCount(1));
+    
+    std::vector<std::uint64_t> counts;
+    std::vector<std::uint64_t> expected(20, 0);
+    
+    // Unit 1 follows unit 0 by 2.5 ms, i.e. in bin [2 ms, 3 ms)
+    correlogram.getCorrelogram(0, 1, counts);
+    expected[12] = 1;
+    EXPECT_EQ(expected, counts);
+    
+    // Unit 0 precedes unit 1 by 2.5 ms, i.e. in bin [-3 ms, -2 ms)
+    correlogram.getCorrelogram(1, 0, counts);
+    expected.assign(20, 0);
+    expected[7] = 1;
+    EXPECT_EQ(expected, counts);
+    
+    // Autocorrelograms exclude each spike's pairing with itself
+    correlogram.getCorrelogram(0, 0, counts);
+    EXPECT_EQ(std::vector<std::uint64_t>(20, 0), counts);
+}
+
+
+TEST(CrossCorrelogramTest, CountsOutOfOrderSpikesOnce) {
+    OpenEphysCrossCorrelogram correlogram(1, 5000, 1000);
+    correlogram.addSpike(0, 10000);
+    correlogram.addSpike(0, 14000);
+    correlogram.addSpike(0, 12000);
+    
+    std::vector<std::uint64_t> counts;
+    correlogram.getCorrelogram(0, 0, counts);
+    
+    // Lags of +-2 ms (twice each) and +-4 ms
+    std::vector<std::uint64_t> expected(10, 0);
+    expected[1] = 1;  // -4 ms
+    expected[3] = 2;  // -2 ms
+    expected[7] = 2;  // +2 ms
+    expected[9] = 1;  // +4 ms
+    EXPECT_EQ(expected, counts);
+    
+    correlogram.clearCorrelograms();
+    correlogram.getCorrelogram(0, 0, counts);
+    EXPECT_EQ(std::vector<std::uint64_t>(10, 0), counts);
+}
+
+
+TEST(SpikeTriggeredAverageTest, AveragesPrecedingValues) {
+    OpenEphysSpikeTriggeredAverage sta(1, 2, 4000, 1000, 64);
+    ASSERT_EQ(4u, sta.getNumBins());
+    
+    for (int i = 0; i < 6; i++) {
+        sta.addValue(0, i * 1000, i + 1);
+    }
+    
+    std::vector<double> average;
+    EXPECT_TRUE(sta.addSpike(0, 5000));
+    ASSERT_EQ(1u, sta.getAverage(0, 0, average));
+    EXPECT_EQ((std::vector<double> { 2.0, 3.0, 4.0, 5.0 }), average);
+    
+    // Bins take the most recent value assigned at or before their start
+    EXPECT_TRUE(sta.addSpike(0, 5500));
+    ASSERT_EQ(2u, sta.getAverage(0, 0, average));
+    EXPECT_EQ((std::vector<double> { 2.0, 3.0, 4.0, 5.0 }), average);
+    
+    EXPECT_TRUE(sta.addSpike(0, 6000));
+    ASSERT_EQ(3u, sta.getAverage(0, 0, average));
+    EXPECT_EQ((std::vector<double> { 7.0 / 3.0, 10.0 / 3.0, 13.0 / 3.0, 16.0 / 3.0 }), average);
+    
+    EXPECT_EQ(0u, sta.getSpikeCount(1));
+    
+    sta.clearAverages();
+    EXPECT_EQ(0u, sta.getSpikeCount(0));
+}
+
+
+TEST(SpikeTriggeredAverageTest, RejectsSpikesBeforeHistory) {
+    OpenEphysSpikeTriggeredAverage sta(1, 1, 4000, 1000, 64);
+    sta.addValue(0, 10000, 1.0);
+    EXPECT_FALSE(sta.addSpike(0, 12000));
+    EXPECT_EQ(0u, sta.getSpikeCount(0));
+}
+
+
+TEST(LinearDecoderTest, Decode) {
+    OpenEphysLinearDecoder decoder(3, 2, { 1.0, 2.0, 3.0, -1.0, 0.5, 0.0 }, { 10.0, -10.0 });
+    
+    const double counts[] = { 1.0, 2.0, 4.0 };
+    double output[2];
+    decoder.decode(counts, output);
+    EXPECT_DOUBLE_EQ(1.0 + 4.0 + 12.0 + 10.0, output[0]);
+    EXPECT_DOUBLE_EQ(-1.0 + 1.0 + 0.0 - 10.0, output[1]);
+}
+
+
+TEST(KalmanDecoderTest, Decode) {
+    // One state, observed by two units with gains 1 and 2 above a baseline of 1
+    OpenEphysKalmanDecoder decoder(2, 1, { 1.0 }, { 1.0 }, { 1.0, 2.0 }, { 1.0, 1.0 }, { 1.0, 0.0, 0.0, 1.0 });
+    
+    // Counts of a state of 3
+    const double counts[] = { 4.0, 7.0 };
+    double output;
+    
+    // Starting from zero with covariance 1, the prediction has covariance 2, and the update has
+    // covariance 1 / (1 / 2 + (1 + 4)) and state covariance * (1 * 3 + 2 * 6)
+    decoder.decode(counts, &output);
+    EXPECT_NEAR(15.0 / 5.5, output, 1e-9);
+    
+    for (int i = 0; i < 50; i++) {
+        decoder.decode(counts, &output);
+    }
+    EXPECT_NEAR(3.0, output, 1e-6);
+    
+    decoder.reset();
+    decoder.decode(counts, &output);
+    EXPECT_NEAR(15.0 / 5.5, output, 1e-9);
+}
+
+
+END_NAMESPACE_MW
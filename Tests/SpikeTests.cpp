@@ -0,0 +1,465 @@
+//
+//  SpikeTests.cpp
+//  OpenEphys
+//
+//  Copyright © 2026 The MWorks Project. All rights reserved.
+//
+
+#include <sys/stat.h>
+
+#include <gtest/gtest.h>
+
+#include "OpenEphysOverloadController.hpp"
+#include "OpenEphysSimulationModel.hpp"
+#include "OpenEphysSpikeArchive.hpp"
+#include "OpenEphysSpikeClassifier.hpp"
+#include "OpenEphysSpikeCodec.hpp"
+#include "OpenEphysSpikeStore.hpp"
+#include "OpenEphysUnitQuality.hpp"
+
+
+BEGIN_NAMESPACE_MW
+
+
+BEGIN_NAMESPACE()
+
+
+OpenEphysSpikeRecord makeSpike(MWTime time,
+                               std::uint16_t electrodeID,
+                               std::uint16_t sortedID,
+                               std::uint16_t classifiedID = 0)
+{
+    return { time, time * 3, electrodeID, sortedID, std::uint16_t(electrodeID * 4 + 1), classifiedID };
+}
+
+
+template<typename T>
+std::vector<T> readColumn(const std::string &path) {
+    std::ifstream input(path, std::ios::binary);
+    std::vector<T> values;
+    T value;
+    while (input.read(reinterpret_cast<char *>(&value), sizeof(value))) {
+        values.push_back(value);
+    }
+    return values;
+}
+
+
+std::size_t readArchiveRows(const std::string &directory) {
+    std::ifstream input(directory + "/archive.txt");
+    std::string name;
+    std::size_t rows = 0;
+    while (input >> name) {
+        if (name == "rows" && (input >> rows)) {
+            return rows;
+        }
+    }
+    return 0;
+}
+
+
+END_NAMESPACE()
+
+
+TEST(SpikeCodecTest, RoundTrip) {
+    // Out-of-order times and sample numbers exercise negative deltas, and large IDs multi-byte varints
+    const std::vector<OpenEphysSpikeRecord> spikes {
+        makeSpike(1000000, 0, 1),
+        makeSpike(999000, 3, 2, 7),
+        makeSpike(5000000000LL, 65535, 65535, 65535),
+        makeSpike(-20, 128, 0),
+        makeSpike(-20, 1, 300)
+    };
+    
+    OpenEphysSpikeBatchEncoder encoder;
+    for (auto &spike : spikes) {
+        encoder.add(spike);
+    }
+    EXPECT_EQ(spikes.size(), encoder.size());
+    EXPECT_EQ(spikes.front().time, encoder.getFirstSpikeTime());
+    const std::string batch = encoder.finish();
+    EXPECT_TRUE(encoder.empty());
+    
+    std::vector<OpenEphysSpikeRecord> decoded;
+    ASSERT_TRUE(decodeSpikeBatch(batch, decoded));
+    ASSERT_EQ(spikes.size(), decoded.size());
+    for (std::size_t i = 0; i < spikes.size(); i++) {
+        EXPECT_EQ(spikes[i].time, decoded[i].time) << i;
+        EXPECT_EQ(spikes[i].sampleNumber, decoded[i].sampleNumber) << i;
+        EXPECT_EQ(spikes[i].electrodeID, decoded[i].electrodeID) << i;
+        EXPECT_EQ(spikes[i].sortedID, decoded[i].sortedID) << i;
+        EXPECT_EQ(spikes[i].channel, decoded[i].channel) << i;
+        EXPECT_EQ(spikes[i].classifiedID, decoded[i].classifiedID) << i;
+    }
+    
+    // The encoder starts afresh after finish
+    encoder.add(spikes[1]);
+    decoded.clear();
+    ASSERT_TRUE(decodeSpikeBatch(encoder.finish(), decoded));
+    ASSERT_EQ(1u, decoded.size());
+    EXPECT_EQ(spikes[1].time, decoded[0].time);
+}
+
+
+TEST(SpikeCodecTest, RejectsInvalidBatches) {
+    OpenEphysSpikeBatchEncoder encoder;
+    encoder.add(makeSpike(1000, 1, 1));
+    encoder.add(makeSpike(2000, 1, 1));
+    const std::string batch = encoder.finish();
+    
+    std::vector<OpenEphysSpikeRecord> decoded;
+    EXPECT_FALSE(decodeSpikeBatch("", decoded));
+    EXPECT_FALSE(decodeSpikeBatch("XXXX" + batch.substr(4), decoded));
+    EXPECT_FALSE(decodeSpikeBatch(batch.substr(0, batch.size() - 1), decoded));
+}
+
+
+TEST(SpikeStoreTest, RangeQueries) {
+    OpenEphysSpikeStore store(100);
+    for (MWTime time = 1000; time <= 10000; time += 1000) {
+        store.addSpike(1, 2, time);
+    }
+    store.addSpike(1, 3, 5000);
+    
+    // Queries cover [start, end)
+    EXPECT_EQ(10u, store.count(1, 2, 0, 20000));
+    EXPECT_EQ(3u, store.count(1, 2, 3000, 6000));
+    EXPECT_EQ(4u, store.count(1, 2, 2500, 6001));
+    EXPECT_EQ(0u, store.count(1, 2, 6000, 6000));
+    EXPECT_EQ(1u, store.count(1, 3, 0, 20000));
+    EXPECT_EQ(0u, store.count(2, 2, 0, 20000));
+    
+    EXPECT_EQ((std::vector<MWTime> { 3000, 4000, 5000 }), store.fetch(1, 2, 3000, 6000));
+    EXPECT_TRUE(store.fetch(1, 2, 20000, 30000).empty());
+}
+
+
+TEST(SpikeStoreTest, KeepsMostRecentSpikes) {
+    OpenEphysSpikeStore store(4);
+    for (MWTime time = 1; time <= 10; time++) {
+        store.addSpike(0, 1, time * 1000);
+    }
+    EXPECT_EQ((std::vector<MWTime> { 7000, 8000, 9000, 10000 }), store.fetch(0, 1, 0, 20000));
+    
+    store.clear();
+    EXPECT_EQ(0u, store.count(0, 1, 0, 20000));
+}
+
+
+// Reopening an archive appends to it, rather than overwriting it
+TEST(SpikeArchiveTest, Reopen) {
+    const std::string directory = testing::TempDir() + "spike_archive_test";
+    for (const char *name : { "time.i64", "sample.i64", "electrode.u16", "unit.u16", "channel.u16", "index.i64", "archive.txt" }) {
+        std::remove((directory + "/" + name).c_str());
+    }
+    
+    constexpr std::size_t numFirstRun = 1500, numSecondRun = 700;
+    std::vector<OpenEphysSpikeRecord> spikes;
+    for (std::size_t i = 0; i < numFirstRun + numSecondRun; i++) {
+        spikes.push_back(makeSpike(MWTime(i) * 100, std::uint16_t(i % 7), std::uint16_t(i % 3)));
+    }
+    
+    {
+        OpenEphysSpikeArchive archive(directory);
+        ASSERT_TRUE(archive.open());
+        for (std::size_t i = 0; i < numFirstRun; i++) {
+            ASSERT_TRUE(archive.append(spikes[i]));
+        }
+        archive.close();
+    }
+    EXPECT_EQ(numFirstRun, readArchiveRows(directory));
+    
+    {
+        OpenEphysSpikeArchive archive(directory);
+        ASSERT_TRUE(archive.open());
+        for (std::size_t i = numFirstRun; i < spikes.size(); i++) {
+            ASSERT_TRUE(archive.append(spikes[i]));
+        }
+        archive.close();
+    }
+    EXPECT_EQ(spikes.size(), readArchiveRows(directory));
+    
+    const auto times = readColumn<std::int64_t>(directory + "/time.i64");
+    const auto samples = readColumn<std::int64_t>(directory + "/sample.i64");
+    const auto electrodes = readColumn<std::uint16_t>(directory + "/electrode.u16");
+    const auto units = readColumn<std::uint16_t>(directory + "/unit.u16");
+    const auto channels = readColumn<std::uint16_t>(directory + "/channel.u16");
+    ASSERT_EQ(spikes.size(), times.size());
+    ASSERT_EQ(spikes.size(), samples.size());
+    ASSERT_EQ(spikes.size(), electrodes.size());
+    ASSERT_EQ(spikes.size(), units.size());
+    ASSERT_EQ(spikes.size(), channels.size());
+    for (std::size_t i = 0; i < spikes.size(); i++) {
+        ASSERT_EQ(spikes[i].time, times[i]) << i;
+        ASSERT_EQ(spikes[i].sampleNumber, samples[i]) << i;
+        ASSERT_EQ(spikes[i].electrodeID, electrodes[i]) << i;
+        ASSERT_EQ(spikes[i].sortedID, units[i]) << i;
+        ASSERT_EQ(spikes[i].channel, channels[i]) << i;
+    }
+    
+    // The index holds (time, row) for every indexInterval-th row
+    const auto index = readColumn<std::int64_t>(directory + "/index.i64");
+    const std::size_t numIndexRows = (spikes.size() + OpenEphysSpikeArchive::indexInterval - 1) / OpenEphysSpikeArchive::indexInterval;
+    ASSERT_EQ(2 * numIndexRows, index.size());
+    for (std::size_t i = 0; i < numIndexRows; i++) {
+        const std::size_t row = i * OpenEphysSpikeArchive::indexInterval;
+        EXPECT_EQ(spikes[row].time, index[2 * i]) << i;
+        EXPECT_EQ(std::int64_t(row), index[2 * i + 1]) << i;
+    }
+}
+
+
+// Classifies the waveforms of simulated SpikeEvent frames, with their thresholds and metadata
+TEST(SpikeClassifierTest, ClassifiesSimulatedSpikes) {
+    constexpr std::uint8_t tetrode = 2;
+    constexpr std::size_t samplesPerChannel = 40;
+    constexpr std::size_t numUnits = 3;
+    
+    OpenEphysSimulationModel model({ 0 }, 0, 0, 0, 0.0, 30000.0, 200.0, 3);
+    for (std::size_t i = 0; i < numUnits; i++) {
+        model.addUnit(5, std::uint16_t(i + 1), 0.0);
+    }
+    model.enableWaveforms(tetrode, samplesPerChannel, 10.0);
+    
+    // Classified IDs differ from the sorted IDs, to tell them apart
+    OpenEphysSpikeClassifier classifier(20.0);
+    for (std::size_t i = 0; i < numUnits; i++) {
+        ASSERT_EQ(4 * samplesPerChannel, model.getWaveform(i).size());
+        classifier.addTemplate(5, std::uint16_t(i + 11), model.getWaveform(i));
+    }
+    
+    std::size_t numSpikes = 0;
+    model.start(0);
+    model.update(1000000, 0.0, [&](std::uint8_t type, double, const void *body, std::size_t size) {
+        ASSERT_EQ(int(OpenEphysEvent::spikeType), int(type));
+        
+        OpenEphysEvent::Spike header;
+        ASSERT_GE(size, sizeof(header));
+        std::memcpy(&header, body, sizeof(header));
+        EXPECT_EQ(4u, OpenEphysEvent::getNumSpikeChannels(header.elecType));
+        
+        // The frame holds more than the header, thresholds, and waveform
+        const auto payload = static_cast<const std::uint8_t *>(body) + sizeof(header);
+        const std::size_t payloadSize = size - sizeof(header);
+        EXPECT_GT(payloadSize, (4 + 4 * samplesPerChannel) * sizeof(float));
+        EXPECT_GE(classifier.getMaxWaveformBytes(), (4 + 4 * samplesPerChannel) * sizeof(float));
+        
+        EXPECT_EQ(header.sortedID + 10, classifier.classify(header.electrodeID, 4, payload, payloadSize));
+        // A truncated payload, or the wrong number of channels, isn't classified
+        EXPECT_EQ(OpenEphysSpikeClassifier::unclassifiedID,
+                  classifier.classify(header.electrodeID, 4, payload, (3 + 4 * samplesPerChannel) * sizeof(float)));
+        EXPECT_EQ(OpenEphysSpikeClassifier::unclassifiedID,
+                  classifier.classify(header.electrodeID, 3, payload, payloadSize));
+        numSpikes++;
+    });
+    EXPECT_GT(numSpikes, 300u);
+}
+
+
+TEST(SpikeClassifierTest, RejectsDistantWaveforms) {
+    OpenEphysSpikeClassifier classifier(10.0);
+    classifier.addTemplate(1, 1, { 0.0f, -100.0f, 0.0f });
+    
+    // One threshold, followed by the samples and no metadata
+    const auto classify = [&classifier](std::uint16_t electrodeID, const std::vector<float> &payload) {
+        return classifier.classify(electrodeID,
+                                   1,
+                                   reinterpret_cast<const std::uint8_t *>(payload.data()),
+                                   payload.size() * sizeof(float));
+    };
+    EXPECT_EQ(1, classify(1, { -50.0f, 5.0f, -95.0f, -5.0f }));
+    EXPECT_EQ(OpenEphysSpikeClassifier::unclassifiedID, classify(1, { -50.0f, 20.0f, -80.0f, 20.0f }));
+    EXPECT_EQ(OpenEphysSpikeClassifier::unclassifiedID, classify(2, { -50.0f, 0.0f, -100.0f, 0.0f }));
+}
+
+
+TEST(UnitQualityTest, BinsISIsAndCountsRefractoryViolations) {
+    OpenEphysUnitQuality tracker(1500, 10000, 3);
+    const auto &edges = tracker.getBinEdges();
+    ASSERT_EQ(51u, edges.size());
+    EXPECT_EQ(100, edges.front());
+    EXPECT_EQ(1000, edges[10]);
+    EXPECT_EQ(10000000, edges.back());
+    
+    EXPECT_TRUE(tracker.addSpike(1, 2, 0));
+    EXPECT_TRUE(tracker.addSpike(1, 2, 1000));      // In the bin starting at 1 ms, and refractory
+    EXPECT_TRUE(tracker.addSpike(1, 2, 1050));      // Below the first edge, and refractory
+    EXPECT_TRUE(tracker.addSpike(1, 2, 20001050));  // Beyond the last edge
+    EXPECT_TRUE(tracker.addSpike(0, 5, 500));
+    
+    const auto stats = tracker.takeStats();
+    ASSERT_EQ(2u, stats.size());
+    
+    // Units are reported in ID order
+    EXPECT_EQ(0, stats[0].electrodeID);
+    EXPECT_EQ(5, stats[0].sortedID);
+    EXPECT_EQ(1u, stats[0].spikeCount);
+    EXPECT_EQ(0u, stats[0].isiCount);
+    
+    const auto &unit = stats[1];
+    EXPECT_EQ(1, unit.electrodeID);
+    EXPECT_EQ(2, unit.sortedID);
+    EXPECT_EQ(4u, unit.spikeCount);
+    EXPECT_EQ(3u, unit.isiCount);
+    EXPECT_EQ(2u, unit.refractoryViolations);
+    EXPECT_EQ(1u, unit.burstCount);
+    EXPECT_EQ(3u, unit.burstSpikeCount);
+    ASSERT_EQ(tracker.getNumBins(), unit.histogram.size());
+    for (std::size_t bin = 0; bin < unit.histogram.size(); bin++) {
+        const std::uint32_t expected = ((bin == 0 || bin == 10 || bin == unit.histogram.size() - 1) ? 1 : 0);
+        EXPECT_EQ(expected, unit.histogram[bin]) << "bin " << bin;
+    }
+    
+    EXPECT_FALSE(tracker.hasStats());
+    EXPECT_TRUE(tracker.takeStats().empty());
+}
+
+
+TEST(UnitQualityTest, CreditsBurstSpikesToTheirOwnInterval) {
+    OpenEphysUnitQuality tracker(1500, 10000, 3);
+    
+    // A burst that starts in one interval and completes in the next
+    tracker.addSpike(0, 0, 0);
+    tracker.addSpike(0, 0, 5000);
+    auto stats = tracker.takeStats();
+    ASSERT_EQ(1u, stats.size());
+    EXPECT_EQ(2u, stats[0].spikeCount);
+    EXPECT_EQ(0u, stats[0].burstCount);
+    EXPECT_EQ(0u, stats[0].burstSpikeCount);
+    
+    tracker.addSpike(0, 0, 10000);
+    stats = tracker.takeStats();
+    ASSERT_EQ(1u, stats.size());
+    EXPECT_EQ(1u, stats[0].spikeCount);
+    EXPECT_EQ(1u, stats[0].isiCount);
+    EXPECT_EQ(1u, stats[0].burstCount);
+    EXPECT_EQ(1u, stats[0].burstSpikeCount);
+    
+    // The burst continues into a third interval, and a second burst follows within it
+    tracker.addSpike(0, 0, 15000);
+    tracker.addSpike(0, 0, 100000);
+    tracker.addSpike(0, 0, 105000);
+    tracker.addSpike(0, 0, 110000);
+    stats = tracker.takeStats();
+    ASSERT_EQ(1u, stats.size());
+    EXPECT_EQ(4u, stats[0].spikeCount);
+    EXPECT_EQ(1u, stats[0].burstCount);
+    EXPECT_EQ(4u, stats[0].burstSpikeCount);
+    
+    // After a reset, previous spikes no longer count toward ISIs or bursts
+    tracker.addSpike(0, 0, 115000);
+    tracker.reset();
+    tracker.addSpike(0, 0, 120000);
+    tracker.addSpike(0, 0, 125000);
+    stats = tracker.takeStats();
+    ASSERT_EQ(1u, stats.size());
+    EXPECT_EQ(2u, stats[0].spikeCount);
+    EXPECT_EQ(1u, stats[0].isiCount);
+    EXPECT_EQ(0u, stats[0].burstCount);
+}
+
+
+TEST(OverloadControllerTest, SwitchesModesWithHysteresisAndDwellTime) {
+    // 100 ms lag threshold, half-full queue threshold, and 2 s minimum dwell time
+    OpenEphysOverloadController controller(100000, 0.5, 2000000);
+    EXPECT_EQ(OpenEphysOverloadController::Mode::Normal, controller.getMode());
+    
+    // Each lag sample has a weight of 0.05, so a steady 200 ms lag crosses the threshold on the 14th
+    for (int i = 0; i < 13; i++) {
+        controller.addLagSample(200000);
+    }
+    EXPECT_LT(controller.getSmoothedLag(), 100000.0);
+    EXPECT_FALSE(controller.update(1000000, 0.0));
+    controller.addLagSample(200000);
+    EXPECT_GT(controller.getSmoothedLag(), 100000.0);
+    EXPECT_TRUE(controller.update(1000000, 0.0));
+    EXPECT_EQ(OpenEphysOverloadController::Mode::Summary, controller.getMode());
+    
+    // Spikes are counted per unit while in summary mode
+    controller.countSpike(3, 1);
+    controller.countSpike(1, 2);
+    controller.countSpike(3, 1);
+    controller.countSpike(1, 0);
+    ASSERT_TRUE(controller.hasCounts());
+    const auto counts = controller.takeCounts();
+    ASSERT_EQ(3u, counts.size());
+    EXPECT_EQ(1, counts[0].electrodeID);
+    EXPECT_EQ(0, counts[0].sortedID);
+    EXPECT_EQ(1u, counts[0].count);
+    EXPECT_EQ(1, counts[1].electrodeID);
+    EXPECT_EQ(2, counts[1].sortedID);
+    EXPECT_EQ(1u, counts[1].count);
+    EXPECT_EQ(3, counts[2].electrodeID);
+    EXPECT_EQ(1, counts[2].sortedID);
+    EXPECT_EQ(2u, counts[2].count);
+    EXPECT_FALSE(controller.hasCounts());
+    
+    // Below the threshold, but not below half of it, the controller stays in summary mode long after
+    // the dwell time
+    for (int i = 0; i < 6; i++) {
+        controller.addLagSample(0);
+    }
+    EXPECT_LT(controller.getSmoothedLag(), 100000.0);
+    EXPECT_GT(controller.getSmoothedLag(), 50000.0);
+    EXPECT_FALSE(controller.update(10000000, 0.0));
+    
+    // Below half the threshold, it returns to normal mode once the dwell time has passed since the
+    // last change
+    for (int i = 0; i < 8; i++) {
+        controller.addLagSample(0);
+    }
+    EXPECT_LT(controller.getSmoothedLag(), 50000.0);
+    EXPECT_FALSE(controller.update(2999999, 0.0));
+    EXPECT_FALSE(controller.update(10000000, 0.3));  // Queue above half its threshold
+    EXPECT_TRUE(controller.update(10000000, 0.2));
+    EXPECT_EQ(OpenEphysOverloadController::Mode::Normal, controller.getMode());
+    
+    // Queue fill alone also triggers summary mode, but only above its threshold
+    EXPECT_FALSE(controller.update(11000000, 0.5));
+    EXPECT_TRUE(controller.update(11000000, 0.6));
+    EXPECT_EQ(OpenEphysOverloadController::Mode::Summary, controller.getMode());
+    EXPECT_FALSE(controller.update(12999999, 0.0));
+    EXPECT_TRUE(controller.update(13000000, 0.0));
+    EXPECT_EQ(OpenEphysOverloadController::Mode::Normal, controller.getMode());
+}
+
+
+TEST(OverloadControllerTest, MeasuresReceiveDelayAgainstRecentMinimum) {
+    OpenEphysOverloadController controller(100000, 0.5, 2000000);
+    
+    // Spikes are received every 100 ms, starting 20 s into the run.  The Open Ephys clock is 5 s behind,
+    // which the controller can't know.  From 25 s, the receive path falls 300 ms behind and never
+    // recovers, as if the network latency had changed.
+    struct Transition {
+        MWTime time;
+        OpenEphysOverloadController::Mode mode;
+    };
+    std::vector<Transition> transitions;
+    double lagBeforeBaselineCatchesUp = 0.0;
+    for (MWTime receiptTime = 20000000; receiptTime < 50000000; receiptTime += 100000) {
+        const MWTime delay = (receiptTime < 25000000 ? 5000000 : 5300000);
+        controller.addReceiveDelaySample(receiptTime - delay, receiptTime);
+        if (receiptTime == 39900000) {
+            lagBeforeBaselineCatchesUp = controller.getSmoothedLag();
+        }
+        if (controller.update(receiptTime, 0.0)) {
+            transitions.push_back({ receiptTime, controller.getMode() });
+        }
+    }
+    
+    // The steady 5 s delay is the baseline, so the 300 ms backlog shows up as lag within about a
+    // second.  The baseline is the minimum over the current and previous 10 s windows, so it remains at
+    // 5 s until the window that started at 30 s ends.  After that, the 300 ms becomes the new baseline,
+    // and the lag decays.
+    ASSERT_EQ(2u, transitions.size());
+    EXPECT_EQ(OpenEphysOverloadController::Mode::Summary, transitions[0].mode);
+    EXPECT_GE(transitions[0].time, 25000000);
+    EXPECT_LT(transitions[0].time, 26000000);
+    EXPECT_GT(lagBeforeBaselineCatchesUp, 290000.0);
+    EXPECT_EQ(OpenEphysOverloadController::Mode::Normal, transitions[1].mode);
+    EXPECT_GE(transitions[1].time, 40000000);
+    EXPECT_LT(transitions[1].time, 45000000);
+}
+
+
+END_NAMESPACE_MW